@@ -8,12 +8,16 @@
 #include <ExampleBase.h>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <chrono>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
 
 
-// Enables/disables the use of two secondary command buffers
-//#define ENABLE_SECONDARY_COMMAND_BUFFERS
+// Number of draw calls that are encoded every frame and distributed over all worker threads
+static const std::uint32_t g_numDrawCallsPerFrame = 20000;
 
 class Measure
 {
@@ -32,6 +36,11 @@ class Measure
         {
         }
 
+        void SetTitle(const std::string& title)
+        {
+            title_ = title;
+        }
+
         void Start()
         {
             // Start timer
@@ -87,26 +96,124 @@ class Measure
 
 };
 
+// Persistent worker threads that run a task for each worker index once per frame
+class WorkerPool
+{
+
+    public:
+
+        using Task = std::function<void(std::uint32_t index)>;
+
+        // Launches (numWorkers - 1) threads; the worker with index 0 is always the calling thread of Run.
+        WorkerPool(std::uint32_t numWorkers, const Task& task) :
+            task_ { task }
+        {
+            for (std::uint32_t i = 1; i < numWorkers; ++i)
+                threads_.emplace_back(&WorkerPool::WorkerLoop, this, i);
+        }
+
+        ~WorkerPool()
+        {
+            // Stop all worker threads and wait for them to finish
+            {
+                std::lock_guard<std::mutex> guard { mutex_ };
+                stop_ = true;
+            }
+            startSignal_.notify_all();
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        // Runs the task for the worker indices [0, numActive) and waits until all of them have finished.
+        void Run(std::uint32_t numActive)
+        {
+            // Signal the active worker threads to start with the next frame
+            {
+                std::lock_guard<std::mutex> guard { mutex_ };
+                numActive_  = numActive;
+                numPending_ = numActive - 1;
+                ++frame_;
+            }
+            startSignal_.notify_all();
+
+            // Run first task on the calling thread
+            task_(0);
+
+            // Wait for worker threads to finish
+            std::unique_lock<std::mutex> lock { mutex_ };
+            doneSignal_.wait(lock, [this]() { return (numPending_ == 0); });
+        }
+
+    private:
+
+        void WorkerLoop(std::uint32_t index)
+        {
+            std::uint64_t frame = 0;
+            while (true)
+            {
+                // Wait for the next frame
+                {
+                    std::unique_lock<std::mutex> lock { mutex_ };
+                    startSignal_.wait(lock, [this, frame]() { return (stop_ || frame_ != frame); });
+                    if (stop_)
+                        return;
+                    frame = frame_;
+                    if (index >= numActive_)
+                        continue;
+                }
+
+                task_(index);
+
+                // Notify the calling thread of Run once the last worker has finished
+                {
+                    std::lock_guard<std::mutex> guard { mutex_ };
+                    --numPending_;
+                }
+                doneSignal_.notify_one();
+            }
+        }
+
+    private:
+
+        Task                        task_;
+        std::vector<std::thread>    threads_;
+        std::mutex                  mutex_;
+        std::condition_variable     startSignal_;
+        std::condition_variable     doneSignal_;
+        std::uint64_t               frame_          = 0;
+        std::uint32_t               numActive_      = 0;
+        std::uint32_t               numPending_     = 0;
+        bool                        stop_           = false;
+
+};
+
 class Example_MultiThreading : public ExampleBase
 {
 
-    LLGL::ShaderProgram*        shaderProgram       = nullptr;
-    LLGL::Buffer*               vertexBuffer        = nullptr;
-    LLGL::Buffer*               indexBuffer         = nullptr;
-    LLGL::PipelineLayout*       pipelineLayout      = nullptr;
-    LLGL::CommandBuffer*        primaryCmdBuffer    = nullptr;
+    LLGL::ShaderProgram*                shaderProgram       = nullptr;
+    LLGL::Buffer*                       vertexBuffer        = nullptr;
+    LLGL::Buffer*                       indexBuffer         = nullptr;
+    LLGL::PipelineLayout*               pipelineLayout      = nullptr;
+    LLGL::RenderPass*                   loadRenderPass      = nullptr;
+
+    // One command buffer per worker thread; they are encoded in parallel and submitted in order
+    std::vector<LLGL::CommandBuffer*>   cmdBuffers;
 
-    std::uint32_t               numIndices          = 0;
-    std::mutex                  logMutex;
+    std::uint32_t                       numIndices          = 0;
+    std::uint32_t                       numThreads          = 1;
+    std::uint32_t                       numWorkers          = 1;
+    bool                                multiThreaded       = true;
 
-    Measure                     measure;
+    // Worker threads are launched once and kept alive for all frames
+    std::unique_ptr<WorkerPool>         workerPool;
+
+    Measure                             measure;
 
     struct Bundle
     {
         LLGL::PipelineState*    pipeline            = nullptr;
         LLGL::Buffer*           constantBuffer      = nullptr;
         LLGL::ResourceHeap*     resourceHeap        = nullptr;
-        LLGL::CommandBuffer*    secondaryCmdBuffer  = nullptr;
         Gs::Matrix4f            wvpMatrix;
     }
     bundle[2];
@@ -120,6 +227,11 @@ public:
         LoadShaders(vertexFormat);
         CreatePipelines();
         CreateCommandBuffers();
+        numWorkers = numThreads;
+
+        // Print some information on the standard output
+        std::cout << "press TAB KEY to switch between single- and multi-threaded encoding (" << numThreads << " threads)" << std::endl;
+        UpdateMeasureTitle();
     }
 
 private:
@@ -168,6 +280,21 @@ private:
             bdl.resourceHeap = renderer->CreateResourceHeap(resourceHeapDesc);
         }
 
+        // Create render pass that continues with the content of the previous command buffer
+        LLGL::RenderPassDescriptor renderPassDesc;
+        {
+            renderPassDesc.colorAttachments =
+            {
+                LLGL::AttachmentFormatDescriptor{ context->GetColorFormat(), LLGL::AttachmentLoadOp::Load },
+            };
+            renderPassDesc.depthAttachment =
+            (
+                LLGL::AttachmentFormatDescriptor{ context->GetDepthStencilFormat(), LLGL::AttachmentLoadOp::Load }
+            );
+            renderPassDesc.samples = GetSampleCount();
+        }
+        loadRenderPass = renderer->CreateRenderPass(renderPassDesc);
+
         // Setup graphics pipeline descriptors
         LLGL::GraphicsPipelineDescriptor pipelineDesc;
         {
@@ -176,7 +303,7 @@ private:
             pipelineDesc.pipelineLayout                 = pipelineLayout;
             pipelineDesc.rasterizer.multiSampleEnabled  = (GetSampleCount() > 1);
 
-            // Enable depth test and writing
+            // Enable depth test and writing; repeated draw calls of the same cube are rejected by the depth test
             pipelineDesc.depth.testEnabled              = true;
             pipelineDesc.depth.writeEnabled             = true;
 
@@ -198,131 +325,74 @@ private:
         bundle[1].pipeline = renderer->CreatePipelineState(pipelineDesc);
     }
 
-    static void PrintThreadsafe(std::mutex& mtx, const std::string& text)
-    {
-        std::lock_guard<std::mutex> guard { mtx };
-        std::cout << text << std::endl;
-    }
-
-    static void EncodeSecondaryCommandBuffer(
-        Bundle&         bundle,
-        std::uint32_t   numIndices,
-        std::mutex&     mtx,
-        std::string     threadName)
+    void CreateCommandBuffers()
     {
-        // Print thread start
-        PrintThreadsafe(mtx, "Enter thread: " + threadName);
+        // Create one command buffer for each hardware thread
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
 
-        // Encode command buffer
-        auto& cmdBuffer = *bundle.secondaryCmdBuffer;
-
-        cmdBuffer.Begin();
+        // Command buffers are encoded every frame, so they are one-shot, but must be encoded off the render thread (only relevant for OpenGL)
+        LLGL::CommandBufferDescriptor cmdBufferDesc;
         {
-            cmdBuffer.SetPipelineState(*bundle.pipeline);
-            cmdBuffer.SetResourceHeap(*bundle.resourceHeap);
-            cmdBuffer.DrawIndexed(numIndices, 0);
+            cmdBufferDesc.flags = LLGL::CommandBufferFlags::ParallelEncoding;
         }
-        cmdBuffer.End();
+        for (std::uint32_t i = 0; i < numThreads; ++i)
+            cmdBuffers.push_back(renderer->CreateCommandBuffer(cmdBufferDesc));
 
-        // Print thread end
-        PrintThreadsafe(mtx, "Leave thread: " + threadName);
+        // Launch worker threads that encode one command buffer each
+        workerPool = std::unique_ptr<WorkerPool>(
+            new WorkerPool{ numThreads, [this](std::uint32_t index) { EncodeCommandBufferOfWorker(index); } }
+        );
     }
 
-    void EncodePrimaryCommandBuffer(const std::string& threadName)
+    // Encodes the specified range of draw calls into the command buffer with the specified index
+    void EncodeCommandBuffer(std::uint32_t index, std::uint32_t firstDrawCall, std::uint32_t numDrawCalls)
     {
-        // Print thread start
-        PrintThreadsafe(logMutex, "Enter thread: " + threadName);
+        auto& cmdBuffer = *cmdBuffers[index];
 
-        // Encode command buffer
-        auto& cmdBuffer = *primaryCmdBuffer;
         cmdBuffer.Begin();
         {
-            // Initialize clear color
-            cmdBuffer.SetClearColor(backgroundColor);
-
             // Set hardware buffers to draw the model
             cmdBuffer.SetVertexBuffer(*vertexBuffer);
             cmdBuffer.SetIndexBuffer(*indexBuffer);
 
-            // Set the render context as the initial render target
-            cmdBuffer.BeginRenderPass(*context);
+            // Only the first command buffer clears the render context, all others continue with its content
+            if (index == 0)
             {
-                // Clear color- and depth buffers, and set viewport
+                cmdBuffer.SetClearColor(backgroundColor);
+                cmdBuffer.BeginRenderPass(*context);
                 cmdBuffer.Clear(LLGL::ClearFlags::ColorDepth);
+            }
+            else
+                cmdBuffer.BeginRenderPass(*context, loadRenderPass);
+            {
                 cmdBuffer.SetViewport(context->GetVideoMode().resolution);
 
-                // Draw scene with secondary command buffers
-                #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
-
-                for (auto& bdl : bundle)
-                    cmdBuffer.Execute(*bdl.secondaryCmdBuffer);
-
-                #else // ENABLE_SECONDARY_COMMAND_BUFFERS
-
-                for (auto& bdl : bundle)
+                // Draw both cubes alternately
+                for (std::uint32_t i = firstDrawCall; i < firstDrawCall + numDrawCalls; ++i)
                 {
+                    const auto& bdl = bundle[i % 2];
                     cmdBuffer.SetPipelineState(*bdl.pipeline);
                     cmdBuffer.SetResourceHeap(*bdl.resourceHeap);
                     cmdBuffer.DrawIndexed(numIndices, 0);
                 }
-
-                #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
             }
             cmdBuffer.EndRenderPass();
         }
         cmdBuffer.End();
-
-        // Print thread end
-        PrintThreadsafe(logMutex, "Leave thread: " + threadName);
     }
 
-    void CreateCommandBuffers()
+    // Encodes the share of draw calls of the specified worker; the last worker also takes the remaining draw calls
+    void EncodeCommandBufferOfWorker(std::uint32_t index)
     {
-        // Create primary command buffer
-        LLGL::CommandBufferDescriptor cmdBufferDesc;
-        {
-            cmdBufferDesc.flags = LLGL::CommandBufferFlags::MultiSubmit;
-        }
-        primaryCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
-
-        #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
-
-        // Create secondary command buffers
-        cmdBufferDesc.flags = (LLGL::CommandBufferFlags::DeferredSubmit | LLGL::CommandBufferFlags::MultiSubmit);
-
-        // Start encoding secondary command buffers in parallel
-        std::thread workerThread[2];
-
-        for (int i = 0; i < 2; ++i)
-        {
-            // Create secondary command buffer
-            bundle[i].secondaryCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
-
-            // Start worker thread to encode secondary command buffer
-            workerThread[i] = std::thread(
-                Example_MultiThreading::EncodeSecondaryCommandBuffer,
-                std::ref(bundle[i]),
-                numIndices,
-                std::ref(logMutex),
-                "workerThread[" + std::to_string(i) + "]"
-            );
-        }
-
-        #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
-
-        // Encode primary command buffer
-        EncodePrimaryCommandBuffer("mainThread");
-
-        #ifdef ENABLE_SECONDARY_COMMAND_BUFFERS
-
-        // Wait for worker threads to finish
-        for (auto& worker : workerThread)
-        {
-            if (worker.joinable())
-                worker.join();
-        }
+        const auto numDrawCallsPerThread    = g_numDrawCallsPerFrame / numWorkers;
+        const auto firstDrawCall            = numDrawCallsPerThread * index;
+        const auto numDrawCalls             = (index + 1 < numWorkers ? numDrawCallsPerThread : g_numDrawCallsPerFrame - firstDrawCall);
+        EncodeCommandBuffer(index, firstDrawCall, numDrawCalls);
+    }
 
-        #endif // /ENABLE_SECONDARY_COMMAND_BUFFERS
+    void UpdateMeasureTitle()
+    {
+        measure.SetTitle("Encoding " + std::to_string(g_numDrawCallsPerFrame) + " draw calls with " + std::to_string(numWorkers) + " thread(s)");
     }
 
     void Transform(Gs::Matrix4f& matrix, const Gs::Vector3f& pos, float angle)
@@ -335,6 +405,15 @@ private:
 
     void UpdateScene()
     {
+        // Switch between single- and multi-threaded encoding
+        if (input->KeyDown(LLGL::Key::Tab))
+        {
+            multiThreaded = !multiThreaded;
+            numWorkers = (multiThreaded ? numThreads : 1u);
+            std::cout << std::endl;
+            UpdateMeasureTitle();
+        }
+
         // Animate rotation
         static float rotation;
         rotation += 0.01f;
@@ -357,10 +436,13 @@ private:
 
     void DrawScene()
     {
-        // Submit primary command buffer and present result
+        // Encode command buffers in parallel
         measure.Start();
-        commandQueue->Submit(*primaryCmdBuffer);
+        workerPool->Run(numWorkers);
         measure.Stop();
+
+        // Submit all command buffers in order and present result
+        commandQueue->Submit(numWorkers, cmdBuffers.data());
         context->Present();
     }
 
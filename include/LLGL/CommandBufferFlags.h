@@ -95,6 +95,45 @@ struct CommandBufferFlags
         \todo Rename to \c Restore
         */
         MultiSubmit     = (1 << 1),
+
+        /**
+        \brief Specifies that redundant state changes are removed from the command buffer when it is finalized.
+        \remarks A binding command is removed if its state is either overwritten or left unchanged before the next draw or dispatch command.
+        This requires additional processing time in CommandBuffer::End and is therefore only recommended for command buffers that are submitted multiple times.
+        \note Only supported with: OpenGL (in combination with \c MultiSubmit).
+        \see CommandBuffer::End
+        */
+        OptimizeStateChanges = (1 << 2),
+
+        /**
+        \brief Specifies that consecutive indexed draw commands are merged into a single multi-draw command.
+        \remarks Runs of DrawIndexed and DrawIndexedInstanced commands without any state changes in between, i.e. with the same pipeline state, vertex buffer, and resource heap,
+        are merged into a single indirect multi-draw command when the command buffer is finalized. The indirect arguments are written into an internal buffer once per submission.
+        This reduces the driver overhead for scenes with many small meshes. If this flag is combined with \c OptimizeStateChanges, redundant state changes are removed first, which allows for longer runs.
+        \note Only supported with: OpenGL 4.3+ (or the \c GL_ARB_multi_draw_indirect extension).
+        \see CommandBuffer::DrawIndexed
+        \see CommandBuffer::DrawIndexedInstanced
+        */
+        BatchDrawCommands    = (1 << 3),
+
+        /**
+        \brief Specifies that the command buffer is compiled into native code on a worker thread.
+        \remarks With this flag, CommandBuffer::End returns immediately and the command buffer is interpreted when it is submitted
+        until the native code is ready. Subsequent submissions use the native code automatically.
+        This is only recommended for command buffers that are submitted many times.
+        \note Only supported with: OpenGL (in combination with \c MultiSubmit and if LLGL was built with \c LLGL_ENABLE_JIT_COMPILER).
+        \see CommandBuffer::End
+        */
+        BackgroundCompile    = (1 << 4),
+
+        /**
+        \brief Specifies that the command buffer is encoded on a thread other than the thread of the render context.
+        \remarks Command buffers with this flag can be encoded simultaneously on multiple worker threads and submitted in order on the render thread.
+        Unlike \c MultiSubmit, this does not imply any additional processing in CommandBuffer::End, so it is suited for command buffers that are encoded every frame.
+        \note Only relevant for OpenGL, whose command buffers otherwise call the OpenGL API directly. All other renderers support parallel encoding by default.
+        \see CommandQueue::Submit(std::uint32_t, CommandBuffer* const *)
+        */
+        ParallelEncoding     = (1 << 5),
     };
 };
 
@@ -50,13 +50,17 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void Submit(CommandBuffer& commandBuffer) = 0;
 
-        #if 0
         /**
         \brief Submits all command buffers in the specified array to the command queue at once.
+        \param[in] numCommandBuffers Specifies the number of command buffers to submit.
+        \param[in] commandBuffers Pointer to an array of \c numCommandBuffers command buffers. The command buffers are submitted in the order of this array.
+        \remarks This is the recommended way to submit command buffers that have been encoded in parallel on multiple worker threads.
+        Each command buffer must only be encoded by a single thread at a time, but different command buffers can be encoded simultaneously.
+        For OpenGL, this requires deferred command buffers, i.e. command buffers created with at least one of the flags
+        \c ParallelEncoding, \c DeferredSubmit, \c MultiSubmit, or \c BatchDrawCommands, since immediate command buffers call the OpenGL API directly.
         \see Submit(CommandBuffer&)
         */
         virtual void Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers);
-        #endif
 
         /* ----- Queries ----- */
 
@@ -77,9 +77,14 @@ class LLGL_EXPORT Image
 
         /**
         \brief Converts the image format and data type.
-        \see ConvertImageBuffer
+        \param[in] format Specifies the new image format. This can also be a compressed format (i.e. ImageFormat::BC1 to ImageFormat::BC5).
+        \param[in] dataType Specifies the new data type.
+        \param[in] threadCount Specifies the number of threads to use for conversion. By default 0.
+        \param[in] flags Specifies the conversion flags. This can be a bitwise OR combination of the ImageConversionFlags entries. By default 0.
+        \remarks Compressed images can be converted into any other format and vice versa, but only the storage functions support compressed images.
+        \see ConvertImageBuffer(const SrcImageDescriptor&, ImageFormat, DataType, const Extent3D&, std::size_t, long)
         */
-        void Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount = 0);
+        void Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount = 0, long flags = 0);
 
         /**
         \brief Resizes the image and resets the image buffer.
@@ -108,12 +113,25 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Nearest maps to ResizeFilter::Nearest and SamplerFilter::Linear maps to ResizeFilter::Linear.
+        \see Resize(const Extent3D&, const ResizeFilter, std::size_t)
         */
         void Resize(const Extent3D& extent, const SamplerFilter filter);
 
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer.
+        \param[in] extent Specifies the new image size.
+        \param[in] filter Specifies the resampling filter.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+        \remarks Except for ResizeFilter::Nearest, the image is resampled in floating-point precision with a separable filter,
+        i.e. each dimension is resampled in a separate pass that is split across threads by rows.
+        Integer data types are rounded and clamped to their normalized range.
+        \throw std::invalid_argument If the image has a compressed format.
+        \throw std::invalid_argument If the image has a depth-stencil format and the filter is not ResizeFilter::Nearest.
+        \see ResizeFilter
+        */
+        void Resize(const Extent3D& extent, const ResizeFilter filter, std::size_t threadCount = 0);
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
@@ -255,7 +273,7 @@ class LLGL_EXPORT Image
         */
         std::uint32_t GetBytesPerPixel() const;
 
-        //! Returns the stride (in bytes) for each row.
+        //! Returns the stride (in bytes) for each row. For compressed images, this is the stride for each row of 4x4 blocks.
         std::uint32_t GetRowStride() const;
 
         //! Returns the stride (in bytes) for each depth slice.
@@ -15,6 +15,7 @@
 #include "TextureFlags.h"
 #include "ColorRGBA.h"
 #include <memory>
+#include <vector>
 #include <cstdint>
 
 
@@ -34,6 +35,59 @@ Therefore, the byte buffer type is an std::unique_ptr<char[]>.
 using ByteBuffer = std::unique_ptr<char[]>;
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Image resampling filter enumeration.
+\remarks All filters except ResizeFilter::Nearest are separable and are widened by the scaling factor when the image is minified.
+\see Image::Resize(const Extent3D&, const ResizeFilter, std::size_t)
+*/
+enum class ResizeFilter
+{
+    Nearest,    //!< Nearest neighbor sampling. Pixels are copied without any conversion.
+    Linear,     //!< Linear interpolation (tent filter). This is bilinear or trilinear interpolation for 2D and 3D images respectively.
+    Box,        //!< Box filter, i.e. the average of all covered pixels. This is the common filter for MIP-map generation.
+    Lanczos,    //!< Lanczos filter with a radius of 3 pixels. Sharpest results, but overshooting values are clamped for integer data types.
+    Kaiser,     //!< Kaiser-windowed sinc filter with a radius of 3 pixels. Less ringing than ResizeFilter::Lanczos.
+};
+
+
+/* ----- Flags ----- */
+
+/**
+\brief Image conversion flags enumeration.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t, long)
+*/
+struct ImageConversionFlags
+{
+    enum
+    {
+        /**
+        \brief Encodes block compressed images in high-quality mode.
+        \remarks By default, the endpoints of each 4x4 block are derived from the bounding box of its colors (fast mode).
+        In high-quality mode, the endpoints are fitted to the principal axis of the colors and refined with a least-squares pass,
+        which is several times slower.
+        */
+        HighQualityCompression  = (1 << 0),
+
+        /**
+        \brief Decodes the color components of the source image from sRGB into linear color space.
+        \remarks Alpha components are not affected. Components of 8-bit source images are decoded with a lookup table,
+        all other data types are decoded with the exact transfer function in single precision.
+        */
+        DecodeSRGB              = (1 << 1),
+
+        /**
+        \brief Encodes the color components of the destination image from linear into sRGB color space.
+        \remarks Alpha components are not affected. Components of 8-bit destination images are encoded with a vectorized approximation
+        that rounds to nearest and differs by at most one from the exact transfer function. Alpha components are rounded to nearest in this case, too.
+        All other data types are encoded with the exact transfer function in single precision.
+        */
+        EncodeSRGB              = (1 << 2),
+    };
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -106,6 +160,27 @@ struct DstImageDescriptor
     std::size_t dataSize    = 0;
 };
 
+/**
+\brief Subresource entry of a MIP-map chain that is stored in a single contiguous image buffer.
+\remarks Each MIP-map level stores all of its array layers consecutively.
+\see GenerateMipChain
+\see GetMipChainSubresources
+*/
+struct MipChainSubresource
+{
+    //! Extent of this MIP-map level (excluding the number of array layers).
+    Extent3D        extent;
+
+    //! Number of array layers. This is 1 for all textures types that are neither array nor cube textures.
+    std::uint32_t   numArrayLayers  = 1;
+
+    //! Byte offset of this MIP-map level within the image buffer.
+    std::size_t     offset          = 0;
+
+    //! Size (in bytes) of this MIP-map level including all array layers.
+    std::size_t     dataSize        = 0;
+};
+
 
 /* ----- Functions ----- */
 
@@ -122,8 +197,17 @@ struct DstImageDescriptor
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The worker threads are taken from the persistent thread pool of the library (see RenderSystemConfiguration::threadCount).
+\param[in] flags Specifies the conversion flags. This can be a bitwise OR combination of the ImageConversionFlags entries,
+but only ImageConversionFlags::DecodeSRGB and ImageConversionFlags::EncodeSRGB have an effect with this function. By default 0.
 \return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
-\note Compressed images and depth-stencil images cannot be converted.
+\remarks Data type conversions use specialized kernels for each pair of data types.
+Conversions between UInt8/UInt16 and Float32 are vectorized (SSE2/AVX2 or NEON, selected at runtime) and produce the same results as the scalar conversion.
+If both format and data type differ, the image is converted in a single pass over small cache-sized tiles,
+i.e. no intermediate buffer of the size of the entire image is allocated.
+\remarks If any sRGB flag is specified, the image is always converted, even if format and data type are equal.
+\note Compressed images and depth-stencil images cannot be converted with this function.
+To encode or decode block compressed images, use the overload with an image extent.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
@@ -137,7 +221,8 @@ the maximal count of threads the system supports will be used (e.g. 4 on a quad-
 LLGL_EXPORT bool ConvertImageBuffer(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
-    std::size_t                 threadCount = 0
+    std::size_t                 threadCount = 0,
+    long                        flags       = 0
 );
 
 /**
@@ -148,9 +233,11 @@ LLGL_EXPORT bool ConvertImageBuffer(
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+\param[in] flags Specifies the conversion flags. See ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t, long) for details.
 \return Byte buffer with the converted image data or null if no conversion is necessary.
 This can be casted to the respective target data type (e.g. <code>unsigned char</code>, <code>int</code>, <code>float</code> etc.).
-\note Compressed images and depth-stencil images cannot be converted.
+\note Compressed images and depth-stencil images cannot be converted with this function.
+To encode or decode block compressed images, use the overload with an image extent.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
@@ -164,7 +251,48 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     const SrcImageDescriptor&   srcImageDesc,
     ImageFormat                 dstFormat,
     DataType                    dstDataType,
-    std::size_t                 threadCount = 0
+    std::size_t                 threadCount = 0,
+    long                        flags       = 0
+);
+
+/**
+\brief Converts the image format and data type of the source image, including block compressed formats (i.e. ImageFormat::BC1 to ImageFormat::BC5).
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[out] dstImageDesc Specifies the destination image descriptor.
+\param[in] extent Specifies the extent of the image. This is required to determine the 4x4 blocks of compressed images.
+\param[in] threadCount Specifies the number of threads to use for conversion. See ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t, long) for details.
+\param[in] flags Specifies the conversion flags. This can be a bitwise OR combination of the ImageConversionFlags entries. By default 0.
+\return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
+\remarks Compressed images are encoded from and decoded to 8-bit components, i.e. RGBA for BC1 to BC3, R for BC4, and RG for BC5.
+Other formats and data types are converted before encoding or after decoding.
+For compressed images, the data type must be DataType::UInt8, or DataType::Int8 for signed normalized BC4 and BC5 images (i.e. Format::BC4SNorm and Format::BC5SNorm).
+\remarks Pixels with an alpha value below 0.5 are encoded as transparent in BC1 images.
+\remarks If neither source nor destination is compressed, this is equivalent to ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t, long).
+\throw std::invalid_argument If a compressed image has a data type other than DataType::UInt8 or DataType::Int8 (BC4 and BC5 only).
+\throw std::invalid_argument If the source or destination buffer size is too small for the specified extent.
+\see ImageConversionFlags
+\see Image::Convert
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount = 0,
+    long                        flags       = 0
+);
+
+/**
+\brief Converts the image format and data type of the source image, including block compressed formats, and returns the new generated image buffer.
+\return Byte buffer with the converted image data or null if no conversion is necessary.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t, long)
+*/
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    const Extent3D&             extent,
+    std::size_t                 threadCount = 0,
+    long                        flags       = 0
 );
 
 /**
@@ -240,6 +368,53 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
 */
 LLGL_EXPORT ByteBuffer GenerateEmptyByteBuffer(std::size_t bufferSize, bool initialize = true);
 
+/**
+\brief Returns the subresource table of a contiguous MIP-map chain for the specified texture descriptor.
+\param[in] textureDesc Specifies the texture descriptor. Its members \c type, \c extent, \c arrayLayers, and \c mipLevels determine the layout of the MIP-map chain.
+\param[in] format Specifies the image format of each pixel.
+\param[in] dataType Specifies the data type of each component.
+\return List of subresources with one entry for each MIP-map level. The total size of the chain is <code>back().offset + back().dataSize</code>.
+\see GenerateMipChain
+*/
+LLGL_EXPORT std::vector<MipChainSubresource> GetMipChainSubresources(
+    const TextureDescriptor&    textureDesc,
+    ImageFormat                 format,
+    DataType                    dataType
+);
+
+/**
+\brief Generates the entire MIP-map chain of the specified image on the CPU.
+\param[in] textureDesc Specifies the descriptor of the texture the MIP-map chain is generated for.
+If the texture format is in sRGB color space (e.g. Format::RGBA8UNorm_sRGB), the color components are filtered in linear color space.
+\param[in] srcImageDesc Specifies the source image descriptor for the first MIP-map level including all array layers.
+\param[out] subresources Receives the subresource table with one entry for each MIP-map level.
+\param[in] threadCount Specifies the number of threads to use. See ConvertImageBuffer for details. By default 0.
+\return Byte buffer with all MIP-map levels stored contiguously. The first MIP-map level is a copy of the source image.
+\remarks Each MIP-map level is downsampled from the previous level with a box filter (see ResizeFilter::Box).
+The intermediate levels are kept in floating-point precision, so rounding errors do not accumulate over the MIP-map chain.
+\remarks The result can be passed to RenderSystem::CreateTexture together with MiscFlags::PrebuiltMips, which avoids the GPU pass for MIP-map generation.
+Usage example:
+\code
+std::vector<LLGL::MipChainSubresource> mips;
+auto mipChain = LLGL::GenerateMipChain(myTextureDesc, myImage.GetSrcDesc(), mips);
+
+myTextureDesc.miscFlags |= LLGL::MiscFlags::PrebuiltMips;
+
+LLGL::SrcImageDescriptor mipChainDesc{ myImage.GetFormat(), myImage.GetDataType(), mipChain.get(), mips.back().offset + mips.back().dataSize };
+auto myTexture = myRenderer->CreateTexture(myTextureDesc, &mipChainDesc);
+\endcode
+\throw std::invalid_argument If a compressed image format or a depth-stencil format is specified.
+\throw std::invalid_argument If the source buffer is a null pointer or its size is too small for the first MIP-map level.
+\see GetMipChainSubresources
+\see MiscFlags::PrebuiltMips
+*/
+LLGL_EXPORT ByteBuffer GenerateMipChain(
+    const TextureDescriptor&            textureDesc,
+    const SrcImageDescriptor&           srcImageDesc,
+    std::vector<MipChainSubresource>&   subresources,
+    std::size_t                         threadCount = 0
+);
+
 /** @} */
 
 
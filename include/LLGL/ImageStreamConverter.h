@@ -0,0 +1,186 @@
+/*
+ * ImageStreamConverter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_STREAM_CONVERTER_H
+#define LLGL_IMAGE_STREAM_CONVERTER_H
+
+
+#include "Export.h"
+#include "Types.h"
+#include "ImageFlags.h"
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Chunk of converted image data that is passed to the ImageStreamCallback.
+\remarks The region of each chunk (i.e. offset and extent) can be passed directly to RenderSystem::WriteTexture
+to upload the image while it is still being converted.
+\see ImageStreamConverter
+*/
+struct ImageStreamChunk
+{
+    //! Pointer to the converted image data in the destination format and data type. This is only valid during the callback.
+    const void*     data        = nullptr;
+
+    //! Size (in bytes) of the converted image data.
+    std::size_t     dataSize    = 0;
+
+    //! Offset (in pixels) of this chunk within the entire image.
+    Offset3D        offset;
+
+    //! Extent (in pixels) of this chunk. Chunks never cross a depth slice, i.e. the depth is always 1.
+    Extent3D        extent;
+};
+
+/**
+\brief Callback interface for the image stream converter. It is called for each chunk of converted image data.
+\see ImageStreamConverter
+*/
+using ImageStreamCallback = std::function<void(const ImageStreamChunk& chunk)>;
+
+/**
+\brief Descriptor structure for the image stream converter.
+\see ImageStreamConverter
+*/
+struct ImageStreamConverterDescriptor
+{
+    //! Extent of the entire image.
+    Extent3D        extent;
+
+    //! Source image format. By default ImageFormat::RGBA.
+    ImageFormat     srcFormat       = ImageFormat::RGBA;
+
+    //! Source image data type. By default DataType::UInt8.
+    DataType        srcDataType     = DataType::UInt8;
+
+    //! Destination image format. By default ImageFormat::RGBA.
+    ImageFormat     dstFormat       = ImageFormat::RGBA;
+
+    //! Destination image data type. By default DataType::UInt8.
+    DataType        dstDataType     = DataType::UInt8;
+
+    /**
+    \brief Specifies the maximal size (in bytes) of each converted chunk. By default 4 MB.
+    \remarks This is the memory ceiling of the converter. Each chunk contains at least one row of pixels (or one row of 4x4 blocks for compressed formats),
+    even if that exceeds this size.
+    */
+    std::size_t     maxChunkSize    = (1 << 22);
+
+    /**
+    \brief Optional pointer to a caller-provided ring buffer the converted chunks are written into. By default null.
+    \remarks If this is null, the converter allocates an internal buffer of up to 'maxChunkSize' bytes for the converted chunks.
+    Otherwise, the chunks are written consecutively into this buffer and wrap around to its beginning if the next chunk does not fit at its end.
+    This can be used to convert the image directly into a mapped staging buffer.
+    */
+    void*           ringBuffer      = nullptr;
+
+    //! Size (in bytes) of the caller-provided ring buffer. This must be large enough for at least one row of the destination image.
+    std::size_t     ringBufferSize  = 0;
+
+    //! Number of threads to use for the conversion of each chunk. See ConvertImageBuffer for details. By default 0.
+    std::size_t     threadCount     = 0;
+
+    //! Conversion flags. This can be a bitwise OR combination of the ImageConversionFlags entries. By default 0.
+    long            flags           = 0;
+};
+
+
+/* ----- Class ----- */
+
+/**
+\brief Utility class to convert images incrementally with bounded memory.
+
+The source image can be written in arbitrary portions, e.g. rows or slices as they are decoded from a file.
+As soon as enough rows are available, they are converted and passed to the callback in chunks,
+so neither the source nor the destination image must be held in memory entirely.
+\remarks Compressed formats (i.e. ImageFormat::BC1 to ImageFormat::BC5) are converted in rows of 4x4 blocks.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t, long)
+*/
+class LLGL_EXPORT ImageStreamConverter
+{
+
+    public:
+
+        /**
+        \brief Initializes the stream converter with the specified descriptor and callback.
+        \throw std::invalid_argument If the callback is empty or the ring buffer is too small for a single row of the destination image.
+        */
+        ImageStreamConverter(const ImageStreamConverterDescriptor& desc, const ImageStreamCallback& callback);
+
+        ImageStreamConverter(const ImageStreamConverter&) = delete;
+        ImageStreamConverter& operator = (const ImageStreamConverter&) = delete;
+
+        /**
+        \brief Writes the next portion of the source image. The data is tightly packed in the source format and data type.
+        \remarks Complete rows are converted directly from the specified data. Only incomplete rows at the end of the data are copied into an internal buffer.
+        \throw std::out_of_range If the data exceeds the size of the entire image.
+        */
+        void Write(const void* data, std::size_t dataSize);
+
+        //! Resets the converter to receive the same image again from the beginning.
+        void Reset();
+
+        //! Returns true if the entire image has been converted.
+        bool IsComplete() const;
+
+        //! Returns the number of rows that have been converted so far, including all rows of previous slices.
+        std::uint64_t GetNumConvertedRows() const;
+
+        //! Returns the size (in bytes) of the memory allocated by this converter, i.e. the internal chunk buffer and the buffer for incomplete rows.
+        std::size_t GetMemoryFootprint() const;
+
+        //! Returns the descriptor this converter was created with.
+        inline const ImageStreamConverterDescriptor& GetDescriptor() const
+        {
+            return desc_;
+        }
+
+    private:
+
+        std::size_t GetSrcDataSize(std::uint32_t numRows) const;
+        std::size_t GetDstDataSize(std::uint32_t numRows) const;
+
+        void ConvertRows(const void* src, std::uint32_t numRows);
+
+    private:
+
+        ImageStreamConverterDescriptor  desc_;
+        ImageStreamCallback             callback_;
+
+        std::uint32_t                   rowsPerUnit_        = 1;
+        std::uint32_t                   maxRowsPerChunk_    = 1;
+        std::size_t                     srcUnitSize_        = 0;
+
+        ByteBuffer                      chunkBuffer_;
+        std::size_t                     chunkBufferSize_    = 0;
+        std::size_t                     ringBufferOffset_   = 0;
+
+        ByteBuffer                      pendingBuffer_;
+        std::size_t                     pendingSize_        = 0;
+
+        std::uint32_t                   slice_              = 0;
+        std::uint32_t                   row_                = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
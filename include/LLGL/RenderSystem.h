@@ -269,6 +269,22 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual void* MapBuffer(Buffer& buffer, const CPUAccess access) = 0;
 
+        /**
+        \brief Maps the specified range of a buffer from GPU to CPU memory space.
+        \param[in] buffer Specifies the buffer which is to be mapped.
+        \param[in] access Specifies the CPU buffer access requirement, i.e. if the CPU can read and/or write the mapped memory.
+        \param[in] offset Specifies the offset (in bytes) of the range which is to be mapped.
+        \param[in] length Specifies the size (in bytes) of the range which is to be mapped.
+        This offset plus the length (i.e. <code>offset + length</code>) must be less than or equal to the size of the buffer.
+        \return Raw pointer to the first byte of the mapped range, i.e. the byte at \c offset within the buffer.
+        \remarks If the buffer was created with MiscFlags::PersistentMap, this function returns immediately unless the specified range is still in use by the GPU,
+        and the next call to UnmapBuffer only flushes the written range.
+        \remarks The default implementation maps the entire buffer and returns the pointer at the specified offset.
+        \see UnmapBuffer
+        \see MiscFlags::PersistentMap
+        */
+        virtual void* MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length);
+
         /**
         \brief Unmaps the specified buffer.
         \see MapBuffer
@@ -284,7 +300,9 @@ class LLGL_EXPORT RenderSystem : public Interface
         If this is null, the texture will be initialized with the currently configured default image color (if this feature is enabled).
         If this is non-null, it is used to initialize the texture data.
         This parameter will be ignored if the texture type is a multi-sampled texture (i.e. TextureType::Texture2DMS or TextureType::Texture2DMSArray).
+        If \c textureDesc.miscFlags contains MiscFlags::PrebuiltMips, this must contain the entire MIP-map chain (see GenerateMipChain).
         \see WriteTexture
+        \see GenerateMipChain
         */
         virtual Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) = 0;
 
@@ -439,6 +457,8 @@ class LLGL_EXPORT RenderSystem : public Interface
         \brief Creates a new graphics or compute pipeline state object (PSO) from the specified cache.
         \param[in] serializedCache Specifies the serialized cache that was created from the same pipeline state.
         This is usually created during a previous application run, stored to file, and restored on a later run.
+        \return Pointer to the new PipelineState object or null if the cache is no longer valid, e.g. because it was created with a different driver.
+        In the latter case, the pipeline state must be created from its descriptor again.
         \remarks Here is an example how to use pipeline state caches:
         \code
         // Try to read PSO cache file
@@ -447,7 +467,7 @@ class LLGL_EXPORT RenderSystem : public Interface
             // Create PSO from cache
             myPipelineState = myRenderer->CreatePipelineState(*myCache);
         }
-        else
+        if (myPipelineState == nullptr)
         {
             // Setup initial pipeline state
             LLGL::ComputePipelineDescritpor myPipelineDesc;
@@ -456,7 +476,7 @@ class LLGL_EXPORT RenderSystem : public Interface
 
             // Create new PSO
             std::unique_ptr<LLGL::Blob> myCache;
-            myRenderer->CreatePipelineState(myPipelineDesc, &myCache);
+            myPipelineState = myRenderer->CreatePipelineState(myPipelineDesc, &myCache);
 
             // Store PSO to file
             std::ofstream myCacheFile{ "MyPSOCacheFile.bin", std::ios::out | std::ios::binary };
@@ -468,6 +488,7 @@ class LLGL_EXPORT RenderSystem : public Interface
         \endcode
         \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
         \see CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
+        \note Only supported with: Direct3D 12, OpenGL (requires GL_ARB_get_program_binary).
         */
         virtual PipelineState* CreatePipelineState(const Blob& serializedCache) = 0;
 
@@ -550,6 +571,14 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Validates the specified image data size against the required size (in bytes).
         void AssertImageDataSize(std::size_t dataSize, std::size_t requiredDataSize, const char* info = nullptr);
 
+        /**
+        \brief Writes all MIP-maps except the first one from the specified initial image data into the texture.
+        \remarks This is used for textures that are created with MiscFlags::PrebuiltMips,
+        after the backend has initialized the first MIP-map level with the beginning of the same image data.
+        \see GetMipChainSubresources
+        */
+        void WritePrebuiltMips(Texture& texture, const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc);
+
         /**
         \brief Copies the specified source data (i.e. \c data) to the destination image.
         \remarks This function also performs image conversion if there is a mismatch between source and destination format.
@@ -199,6 +199,8 @@ struct RenderSystemConfiguration
     \brief Specifies the number of threads that will be used internally by the render system. By default Constants::maxThreadCount.
     \remarks This is mainly used by the Direct3D render systems, e.g. inside the "CreateTexture" and "WriteTexture" functions
     to convert the image data into the respective hardware texture format. OpenGL does this automatically.
+    The threads are taken from a persistent thread pool that is owned by the library and shared by all CPU side bulk work (such as ConvertImageBuffer),
+    i.e. no threads are created per function call. Setting this configuration with RenderSystem::SetConfiguration resizes that thread pool.
     \see Constants::maxThreadCount
     */
     std::size_t threadCount = Constants::maxThreadCount;
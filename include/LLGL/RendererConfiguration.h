@@ -92,9 +92,9 @@ struct RendererConfigurationVulkan
 
     /**
     \brief Specifies whether fragmentation of the device memory blocks shall be kept low. By default false.
-    \remarks If this is true, each buffer and image allocation first tries to find a reusable device memory block
-    within a single VkDeviceMemory chunk (which might be potentially slower).
-    Whenever a VkDeviceMemory chunk is full, the memory manager tries to reduce fragmentation anyways.
+    \remarks If this is true, each buffer and image allocation first tries to reuse a free device memory block
+    of the same size class within a single VkDeviceMemory chunk before it resorts to the next larger size class.
+    This keeps fragmentation lower, but might leave large free blocks split up into smaller ones.
     \todo Remove this as soon as Vulkan memory manage has been improved.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
@@ -245,6 +245,28 @@ struct MiscFlags
         \see https://docs.microsoft.com/en-us/windows/win32/api/d3d11/ne-d3d11-d3d11_buffer_uav_flag
         */
         Counter         = (1 << 5),
+
+        /**
+        \brief Specifies that the initial image data of a texture contains the entire MIP-map chain, e.g. as generated by the GenerateMipChain function.
+        \remarks The MIP-map levels must be stored contiguously in the layout described by GetMipChainSubresources.
+        If this is specified, MiscFlags::GenerateMips is ignored and no MIP-maps are generated on the GPU at texture creation time.
+        \remarks This can only be used with uncompressed image data.
+        \see GenerateMipChain
+        \see RenderSystem::CreateTexture
+        */
+        PrebuiltMips    = (1 << 6),
+
+        /**
+        \brief Keeps a buffer mapped into CPU memory space for its entire lifetime.
+        \remarks This can only be used with buffers that have at least one of the CPU access flags, i.e. CPUAccessFlags::Read or CPUAccessFlags::Write.
+        With this flag, RenderSystem::MapBuffer only returns a pointer into the persistently mapped memory and waits for the GPU only if the mapped range is still in use,
+        and RenderSystem::UnmapBuffer only flushes the written range.
+        Written ranges are considered to be in use by the GPU until all command buffers that have been submitted after the range was unmapped are completed.
+        \note Only supported with: OpenGL 4.4 or GL_ARB_buffer_storage. This flag is ignored by all other renderers.
+        \see RenderSystem::MapBuffer(Buffer&, const CPUAccess, std::uint64_t, std::uint64_t)
+        \see BufferDescriptor::cpuAccessFlags
+        */
+        PersistentMap   = (1 << 7),
     };
 };
 
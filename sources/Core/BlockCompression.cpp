@@ -0,0 +1,927 @@
+/*
+ * BlockCompression.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BlockCompression.h"
+#include "CPUFeatures.h"
+#include "ThreadPool.h"
+#include "Helper.h"
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <cmath>
+
+#if defined LLGL_SIMD_SSE2
+#   include <emmintrin.h>
+#elif defined LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// 4x4 block of pixels in structure-of-arrays layout. Color components are stored as floats for the SIMD distance computation.
+struct ColorBlock
+{
+    float           r[16];
+    float           g[16];
+    float           b[16];
+    std::uint8_t    a[16];
+};
+
+// Palette of a BC1 color block in structure-of-arrays layout. Alpha is only zero for the transparent entry of the 3-color mode.
+struct ColorPalette
+{
+    float           r[4];
+    float           g[4];
+    float           b[4];
+    std::uint8_t    a[4];
+};
+
+// Encoded BC1 color block with its squared error.
+struct EncodedColorBlock
+{
+    std::uint16_t   c0          = 0;
+    std::uint16_t   c1          = 0;
+    std::uint32_t   indices     = 0;
+    float           error       = std::numeric_limits<float>::max();
+};
+
+// Encoded BC4 channel block with its squared error.
+struct EncodedAlphaBlock
+{
+    int             a0          = 0;
+    int             a1          = 0;
+    std::uint64_t   indices     = 0;
+    int             error       = std::numeric_limits<int>::max();
+};
+
+// Minimal number of blocks each worker thread shall process
+static const std::size_t g_threadMinBlocks = 64;
+
+
+/* ----- Bit packing ----- */
+
+static std::uint16_t ReadUInt16LE(const std::uint8_t* src)
+{
+    return static_cast<std::uint16_t>(src[0] | (src[1] << 8));
+}
+
+static std::uint32_t ReadUInt32LE(const std::uint8_t* src)
+{
+    return (static_cast<std::uint32_t>(ReadUInt16LE(src)) | (static_cast<std::uint32_t>(ReadUInt16LE(src + 2)) << 16));
+}
+
+static std::uint64_t ReadUInt48LE(const std::uint8_t* src)
+{
+    return (static_cast<std::uint64_t>(ReadUInt32LE(src)) | (static_cast<std::uint64_t>(ReadUInt16LE(src + 4)) << 32));
+}
+
+static void WriteUInt16LE(std::uint8_t* dst, std::uint16_t value)
+{
+    dst[0] = static_cast<std::uint8_t>(value & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+static void WriteUInt32LE(std::uint8_t* dst, std::uint32_t value)
+{
+    WriteUInt16LE(dst, static_cast<std::uint16_t>(value & 0xFFFF));
+    WriteUInt16LE(dst + 2, static_cast<std::uint16_t>(value >> 16));
+}
+
+static void WriteUInt48LE(std::uint8_t* dst, std::uint64_t value)
+{
+    WriteUInt32LE(dst, static_cast<std::uint32_t>(value & 0xFFFFFFFF));
+    WriteUInt16LE(dst + 4, static_cast<std::uint16_t>(value >> 32));
+}
+
+
+/* ----- Color blocks (BC1, and color part of BC2 and BC3) ----- */
+
+static void UnpackRGB565(std::uint16_t color, int& r, int& g, int& b)
+{
+    const int r5 = (color >> 11) & 0x1F;
+    const int g6 = (color >>  5) & 0x3F;
+    const int b5 = (color      ) & 0x1F;
+    r = (r5 << 3) | (r5 >> 2);
+    g = (g6 << 2) | (g6 >> 4);
+    b = (b5 << 3) | (b5 >> 2);
+}
+
+static std::uint16_t QuantizeRGB565(float r, float g, float b)
+{
+    auto quantize = [](float x, int maxValue)
+    {
+        return Clamp(static_cast<int>(x * static_cast<float>(maxValue) / 255.0f + 0.5f), 0, maxValue);
+    };
+    return static_cast<std::uint16_t>((quantize(r, 31) << 11) | (quantize(g, 63) << 5) | quantize(b, 31));
+}
+
+// Builds the palette of a color block. BC2 and BC3 color blocks are always in 4-color mode, i.e. 'allowThreeColorMode' is only true for BC1.
+static void BuildColorPalette(std::uint16_t c0, std::uint16_t c1, bool allowThreeColorMode, ColorPalette& palette)
+{
+    int r0, g0, b0, r1, g1, b1;
+    UnpackRGB565(c0, r0, g0, b0);
+    UnpackRGB565(c1, r1, g1, b1);
+
+    auto setEntry = [&palette](int i, int r, int g, int b, std::uint8_t a)
+    {
+        palette.r[i] = static_cast<float>(r);
+        palette.g[i] = static_cast<float>(g);
+        palette.b[i] = static_cast<float>(b);
+        palette.a[i] = a;
+    };
+
+    setEntry(0, r0, g0, b0, 0xFF);
+    setEntry(1, r1, g1, b1, 0xFF);
+
+    if (c0 > c1 || !allowThreeColorMode)
+    {
+        setEntry(2, (2*r0 + r1 + 1)/3, (2*g0 + g1 + 1)/3, (2*b0 + b1 + 1)/3, 0xFF);
+        setEntry(3, (r0 + 2*r1 + 1)/3, (g0 + 2*g1 + 1)/3, (b0 + 2*b1 + 1)/3, 0xFF);
+    }
+    else
+    {
+        setEntry(2, (r0 + r1 + 1)/2, (g0 + g1 + 1)/2, (b0 + b1 + 1)/2, 0xFF);
+        setEntry(3, 0, 0, 0, 0x00);
+    }
+}
+
+/*
+Selects the nearest of the first 'numEntries' palette entries for 4 pixels at a time.
+All values are integers below 2^24, so the floating-point distances are exact and each path selects the same indices.
+*/
+static void SelectNearestColors(const ColorBlock& block, const ColorPalette& palette, int numEntries, int (&bestIndices)[16], float (&bestErrors)[16])
+{
+    #if defined LLGL_SIMD_SSE2
+
+    for (int i = 0; i < 16; i += 4)
+    {
+        const __m128 r = _mm_loadu_ps(block.r + i);
+        const __m128 g = _mm_loadu_ps(block.g + i);
+        const __m128 b = _mm_loadu_ps(block.b + i);
+
+        __m128  bestDist = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128i bestIdx  = _mm_setzero_si128();
+
+        for (int j = 0; j < numEntries; ++j)
+        {
+            const __m128 dr     = _mm_sub_ps(r, _mm_set1_ps(palette.r[j]));
+            const __m128 dg     = _mm_sub_ps(g, _mm_set1_ps(palette.g[j]));
+            const __m128 db     = _mm_sub_ps(b, _mm_set1_ps(palette.b[j]));
+            const __m128 dist   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+            const __m128i less  = _mm_castps_si128(_mm_cmplt_ps(dist, bestDist));
+
+            bestDist = _mm_min_ps(dist, bestDist);
+            bestIdx  = _mm_or_si128(_mm_and_si128(less, _mm_set1_epi32(j)), _mm_andnot_si128(less, bestIdx));
+        }
+
+        _mm_storeu_ps(bestErrors + i, bestDist);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bestIndices + i), bestIdx);
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    for (int i = 0; i < 16; i += 4)
+    {
+        const float32x4_t r = vld1q_f32(block.r + i);
+        const float32x4_t g = vld1q_f32(block.g + i);
+        const float32x4_t b = vld1q_f32(block.b + i);
+
+        float32x4_t bestDist = vdupq_n_f32(std::numeric_limits<float>::max());
+        uint32x4_t  bestIdx  = vdupq_n_u32(0);
+
+        for (int j = 0; j < numEntries; ++j)
+        {
+            const float32x4_t dr    = vsubq_f32(r, vdupq_n_f32(palette.r[j]));
+            const float32x4_t dg    = vsubq_f32(g, vdupq_n_f32(palette.g[j]));
+            const float32x4_t db    = vsubq_f32(b, vdupq_n_f32(palette.b[j]));
+            const float32x4_t dist  = vaddq_f32(vaddq_f32(vmulq_f32(dr, dr), vmulq_f32(dg, dg)), vmulq_f32(db, db));
+            const uint32x4_t  less  = vcltq_f32(dist, bestDist);
+
+            bestDist = vminq_f32(dist, bestDist);
+            bestIdx  = vbslq_u32(less, vdupq_n_u32(static_cast<std::uint32_t>(j)), bestIdx);
+        }
+
+        vst1q_f32(bestErrors + i, bestDist);
+        vst1q_s32(bestIndices + i, vreinterpretq_s32_u32(bestIdx));
+    }
+
+    #else
+
+    for (int i = 0; i < 16; ++i)
+    {
+        float   bestDist    = std::numeric_limits<float>::max();
+        int     bestIdx     = 0;
+
+        for (int j = 0; j < numEntries; ++j)
+        {
+            const float dr      = block.r[i] - palette.r[j];
+            const float dg      = block.g[i] - palette.g[j];
+            const float db      = block.b[i] - palette.b[j];
+            const float dist    = (dr*dr + dg*dg) + db*db;
+
+            if (dist < bestDist)
+            {
+                bestDist    = dist;
+                bestIdx     = j;
+            }
+        }
+
+        bestErrors[i]   = bestDist;
+        bestIndices[i]  = bestIdx;
+    }
+
+    #endif
+}
+
+// Selects the color indices for the specified endpoints and stores the result if its error is lower than the current best result.
+static void TryColorEndpoints(
+    const ColorBlock&   block,
+    std::uint16_t       opaqueMask,
+    std::uint16_t       c0,
+    std::uint16_t       c1,
+    bool                threeColorMode,
+    bool                allowThreeColorMode,
+    EncodedColorBlock&  best)
+{
+    /* Order endpoints for the respective mode; equal endpoints can only be decoded in 3-color mode with BC1 */
+    if (threeColorMode)
+    {
+        if (c0 > c1)
+            std::swap(c0, c1);
+    }
+    else
+    {
+        if (c0 < c1)
+            std::swap(c0, c1);
+        if (c0 == c1 && allowThreeColorMode)
+            threeColorMode = true;
+    }
+
+    ColorPalette palette;
+    BuildColorPalette(c0, c1, allowThreeColorMode, palette);
+
+    int     indices[16];
+    float   errors[16];
+    SelectNearestColors(block, palette, (threeColorMode ? 3 : 4), indices, errors);
+
+    /* Accumulate error and pack indices; transparent pixels always select the transparent palette entry */
+    EncodedColorBlock result;
+    {
+        result.c0       = c0;
+        result.c1       = c1;
+        result.error    = 0.0f;
+    }
+    for (int i = 0; i < 16; ++i)
+    {
+        if (((opaqueMask >> i) & 1) != 0)
+        {
+            result.indices |= (static_cast<std::uint32_t>(indices[i]) << (i*2));
+            result.error   += errors[i];
+        }
+        else
+            result.indices |= (3u << (i*2));
+    }
+
+    if (result.error < best.error)
+        best = result;
+}
+
+// Fits the endpoints to the selected indices with a least-squares solution per channel, and tries the refined endpoints.
+static void RefineColorEndpoints(
+    const ColorBlock&   block,
+    std::uint16_t       opaqueMask,
+    bool                allowThreeColorMode,
+    EncodedColorBlock&  best)
+{
+    const bool threeColorMode = (best.c0 <= best.c1 && allowThreeColorMode);
+
+    /* Weights of the first endpoint for each index */
+    static const float g_weights4[4] = { 1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f };
+    static const float g_weights3[4] = { 1.0f, 0.0f, 0.5f,      0.0f      };
+    const float* weights = (threeColorMode ? g_weights3 : g_weights4);
+
+    float alpha2 = 0.0f, alphaBeta = 0.0f, beta2 = 0.0f;
+    float alphaX[3] = { 0.0f, 0.0f, 0.0f };
+    float betaX[3]  = { 0.0f, 0.0f, 0.0f };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto index = (best.indices >> (i*2)) & 0x3;
+        if (((opaqueMask >> i) & 1) == 0 || (threeColorMode && index == 3))
+            continue;
+
+        const float alpha   = weights[index];
+        const float beta    = 1.0f - alpha;
+        const float x[3]    = { block.r[i], block.g[i], block.b[i] };
+
+        alpha2      += alpha * alpha;
+        alphaBeta   += alpha * beta;
+        beta2       += beta  * beta;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            alphaX[c]   += alpha * x[c];
+            betaX[c]    += beta  * x[c];
+        }
+    }
+
+    /* Solve 2x2 normal equations for both endpoints */
+    const float det = alpha2 * beta2 - alphaBeta * alphaBeta;
+    if (std::abs(det) < 1.0e-6f)
+        return;
+
+    const float invDet = 1.0f / det;
+
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        e0[c] = (alphaX[c] * beta2  - betaX[c]  * alphaBeta) * invDet;
+        e1[c] = (betaX[c]  * alpha2 - alphaX[c] * alphaBeta) * invDet;
+    }
+
+    const auto c0 = QuantizeRGB565(e0[0], e0[1], e0[2]);
+    const auto c1 = QuantizeRGB565(e1[0], e1[1], e1[2]);
+
+    TryColorEndpoints(block, opaqueMask, c0, c1, threeColorMode, allowThreeColorMode, best);
+}
+
+// Returns the principal axis of the opaque pixels by power iteration over their covariance matrix.
+static void ComputePrincipalAxis(const ColorBlock& block, std::uint16_t opaqueMask, float (&mean)[3], float (&axis)[3])
+{
+    float n = 0.0f;
+    mean[0] = mean[1] = mean[2] = 0.0f;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if (((opaqueMask >> i) & 1) != 0)
+        {
+            mean[0] += block.r[i];
+            mean[1] += block.g[i];
+            mean[2] += block.b[i];
+            n       += 1.0f;
+        }
+    }
+
+    for (auto& m : mean)
+        m /= n;
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i)
+    {
+        if (((opaqueMask >> i) & 1) != 0)
+        {
+            const float r = block.r[i] - mean[0];
+            const float g = block.g[i] - mean[1];
+            const float b = block.b[i] - mean[2];
+            cov[0] += r*r;
+            cov[1] += r*g;
+            cov[2] += r*b;
+            cov[3] += g*g;
+            cov[4] += g*b;
+            cov[5] += b*b;
+        }
+    }
+
+    axis[0] = 1.0f;
+    axis[1] = 1.0f;
+    axis[2] = 1.0f;
+
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        const float x = axis[0]*cov[0] + axis[1]*cov[1] + axis[2]*cov[2];
+        const float y = axis[0]*cov[1] + axis[1]*cov[3] + axis[2]*cov[4];
+        const float z = axis[0]*cov[2] + axis[1]*cov[4] + axis[2]*cov[5];
+
+        const float len = std::max(std::abs(x), std::max(std::abs(y), std::abs(z)));
+        if (len < 1.0e-6f)
+            break;
+
+        axis[0] = x / len;
+        axis[1] = y / len;
+        axis[2] = z / len;
+    }
+}
+
+// Encodes the 8-byte color block; transparent pixels (alpha below 128) are only considered if 'allowThreeColorMode' is true (BC1).
+static void EncodeColorBlock(const ColorBlock& block, bool allowThreeColorMode, bool highQuality, std::uint8_t* dst)
+{
+    /* Determine which pixels are opaque */
+    std::uint16_t opaqueMask = 0xFFFF;
+    if (allowThreeColorMode)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            if (block.a[i] < 128)
+                opaqueMask &= ~(1u << i);
+        }
+    }
+
+    EncodedColorBlock best;
+
+    if (opaqueMask == 0)
+    {
+        /* Entire block is transparent */
+        best.c0         = 0;
+        best.c1         = 0;
+        best.indices    = 0xFFFFFFFF;
+    }
+    else
+    {
+        const bool hasTransparency = (opaqueMask != 0xFFFF);
+
+        /* Bounding box of the opaque pixels */
+        float minColor[3] = { 255.0f, 255.0f, 255.0f };
+        float maxColor[3] = { 0.0f, 0.0f, 0.0f };
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (((opaqueMask >> i) & 1) != 0)
+            {
+                minColor[0] = std::min(minColor[0], block.r[i]);
+                minColor[1] = std::min(minColor[1], block.g[i]);
+                minColor[2] = std::min(minColor[2], block.b[i]);
+                maxColor[0] = std::max(maxColor[0], block.r[i]);
+                maxColor[1] = std::max(maxColor[1], block.g[i]);
+                maxColor[2] = std::max(maxColor[2], block.b[i]);
+            }
+        }
+
+        /* Inset bounding box by 1/16 of its size to reduce the error of the interpolated entries */
+        for (int c = 0; c < 3; ++c)
+        {
+            const float inset = (maxColor[c] - minColor[c]) / 16.0f;
+            minColor[c] += inset;
+            maxColor[c] -= inset;
+        }
+
+        const auto bboxMax = QuantizeRGB565(maxColor[0], maxColor[1], maxColor[2]);
+        const auto bboxMin = QuantizeRGB565(minColor[0], minColor[1], minColor[2]);
+
+        TryColorEndpoints(block, opaqueMask, bboxMax, bboxMin, hasTransparency, allowThreeColorMode, best);
+
+        if (highQuality)
+        {
+            /* Project opaque pixels onto the principal axis and use the extremes as endpoints */
+            float mean[3], axis[3];
+            ComputePrincipalAxis(block, opaqueMask, mean, axis);
+
+            float minProj = std::numeric_limits<float>::max();
+            float maxProj = -std::numeric_limits<float>::max();
+
+            for (int i = 0; i < 16; ++i)
+            {
+                if (((opaqueMask >> i) & 1) != 0)
+                {
+                    const float proj = (block.r[i] - mean[0])*axis[0] + (block.g[i] - mean[1])*axis[1] + (block.b[i] - mean[2])*axis[2];
+                    minProj = std::min(minProj, proj);
+                    maxProj = std::max(maxProj, proj);
+                }
+            }
+
+            const auto pcaMax = QuantizeRGB565(mean[0] + axis[0]*maxProj, mean[1] + axis[1]*maxProj, mean[2] + axis[2]*maxProj);
+            const auto pcaMin = QuantizeRGB565(mean[0] + axis[0]*minProj, mean[1] + axis[1]*minProj, mean[2] + axis[2]*minProj);
+
+            TryColorEndpoints(block, opaqueMask, pcaMax, pcaMin, hasTransparency, allowThreeColorMode, best);
+
+            /* Opaque BC1 blocks may have a lower error in 3-color mode, where the interpolated entry lies in the middle */
+            if (allowThreeColorMode && !hasTransparency)
+            {
+                TryColorEndpoints(block, opaqueMask, bboxMax, bboxMin, true, allowThreeColorMode, best);
+                TryColorEndpoints(block, opaqueMask, pcaMax, pcaMin, true, allowThreeColorMode, best);
+            }
+
+            /* Refine best endpoints with least-squares fits */
+            for (int iteration = 0; iteration < 2; ++iteration)
+                RefineColorEndpoints(block, opaqueMask, allowThreeColorMode, best);
+        }
+    }
+
+    WriteUInt16LE(dst,     best.c0);
+    WriteUInt16LE(dst + 2, best.c1);
+    WriteUInt32LE(dst + 4, best.indices);
+}
+
+// Decodes the 8-byte color block into 16 RGBA pixels.
+static void DecodeColorBlock(const std::uint8_t* src, bool allowThreeColorMode, std::uint8_t (&pixels)[16][4])
+{
+    ColorPalette palette;
+    BuildColorPalette(ReadUInt16LE(src), ReadUInt16LE(src + 2), allowThreeColorMode, palette);
+
+    const auto indices = ReadUInt32LE(src + 4);
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto index = (indices >> (i*2)) & 0x3;
+        pixels[i][0] = static_cast<std::uint8_t>(palette.r[index]);
+        pixels[i][1] = static_cast<std::uint8_t>(palette.g[index]);
+        pixels[i][2] = static_cast<std::uint8_t>(palette.b[index]);
+        pixels[i][3] = palette.a[index];
+    }
+}
+
+
+/* ----- Explicit alpha blocks (alpha part of BC2) ----- */
+
+static void EncodeExplicitAlphaBlock(const std::uint8_t (&alpha)[16], std::uint8_t* dst)
+{
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i)
+        bits |= (static_cast<std::uint64_t>((alpha[i] * 15 + 127) / 255) << (i*4));
+
+    WriteUInt32LE(dst,     static_cast<std::uint32_t>(bits & 0xFFFFFFFF));
+    WriteUInt32LE(dst + 4, static_cast<std::uint32_t>(bits >> 32));
+}
+
+static void DecodeExplicitAlphaBlock(const std::uint8_t* src, std::uint8_t (&pixels)[16][4])
+{
+    const auto bits = (static_cast<std::uint64_t>(ReadUInt32LE(src)) | (static_cast<std::uint64_t>(ReadUInt32LE(src + 4)) << 32));
+    for (int i = 0; i < 16; ++i)
+        pixels[i][3] = static_cast<std::uint8_t>(((bits >> (i*4)) & 0xF) * 17);
+}
+
+
+/* ----- Interpolated channel blocks (BC4, BC5, and alpha part of BC3) ----- */
+
+// Divides with rounding to the nearest integer, where halves are rounded away from zero.
+static int RoundDiv(int numerator, int denominator)
+{
+    if (numerator >= 0)
+        return (numerator + denominator/2) / denominator;
+    else
+        return -((-numerator + denominator/2) / denominator);
+}
+
+static void BuildAlphaPalette(int a0, int a1, bool isSigned, int (&palette)[8])
+{
+    palette[0] = a0;
+    palette[1] = a1;
+
+    if (a0 > a1)
+    {
+        for (int i = 1; i <= 6; ++i)
+            palette[i + 1] = RoundDiv((7 - i)*a0 + i*a1, 7);
+    }
+    else
+    {
+        for (int i = 1; i <= 4; ++i)
+            palette[i + 1] = RoundDiv((5 - i)*a0 + i*a1, 5);
+        palette[6] = (isSigned ? -127 :   0);
+        palette[7] = (isSigned ?  127 : 255);
+    }
+}
+
+static void TryAlphaEndpoints(const int (&values)[16], int a0, int a1, bool isSigned, EncodedAlphaBlock& best)
+{
+    int palette[8];
+    BuildAlphaPalette(a0, a1, isSigned, palette);
+
+    EncodedAlphaBlock result;
+    {
+        result.a0       = a0;
+        result.a1       = a1;
+        result.error    = 0;
+    }
+    for (int i = 0; i < 16; ++i)
+    {
+        int bestDist    = std::numeric_limits<int>::max();
+        int bestIdx     = 0;
+
+        for (int j = 0; j < 8; ++j)
+        {
+            const int d     = values[i] - palette[j];
+            const int dist  = d*d;
+            if (dist < bestDist)
+            {
+                bestDist    = dist;
+                bestIdx     = j;
+            }
+        }
+
+        result.indices |= (static_cast<std::uint64_t>(bestIdx) << (i*3));
+        result.error   += bestDist;
+    }
+
+    if (result.error < best.error)
+        best = result;
+}
+
+// Encodes a single channel into an 8-byte block. Signed values must be in the range [-127, 127], unsigned values in the range [0, 255].
+static void EncodeAlphaBlock(const int (&values)[16], bool isSigned, bool highQuality, std::uint8_t* dst)
+{
+    const int minLimit = (isSigned ? -127 :   0);
+    const int maxLimit = (isSigned ?  127 : 255);
+
+    int minValue = values[0], maxValue = values[0];
+    for (int i = 1; i < 16; ++i)
+    {
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+
+    /* Use 8-value mode (a0 > a1) with the range of the block */
+    EncodedAlphaBlock best;
+    TryAlphaEndpoints(values, maxValue, minValue, isSigned, best);
+
+    if (highQuality && best.error > 0)
+    {
+        /* Try 6-value mode (a0 <= a1) with the range of the values in between the limits, which are stored explicitly */
+        int innerMin = maxLimit, innerMax = minLimit;
+        for (int i = 0; i < 16; ++i)
+        {
+            if (values[i] != minLimit && values[i] != maxLimit)
+            {
+                innerMin = std::min(innerMin, values[i]);
+                innerMax = std::max(innerMax, values[i]);
+            }
+        }
+
+        if (innerMin <= innerMax)
+            TryAlphaEndpoints(values, innerMin, innerMax, isSigned, best);
+
+        /* Try endpoints that are moved inwards, which trades the error at the extremes for the interpolated values */
+        for (int inset = 1; inset <= 2 && maxValue - minValue > 2*inset; ++inset)
+            TryAlphaEndpoints(values, maxValue - inset, minValue + inset, isSigned, best);
+    }
+
+    dst[0] = static_cast<std::uint8_t>(best.a0 & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(best.a1 & 0xFF);
+    WriteUInt48LE(dst + 2, best.indices);
+}
+
+// Decodes an 8-byte block of a single channel into the specified component of the 16 pixels.
+static void DecodeAlphaBlock(const std::uint8_t* src, bool isSigned, std::uint8_t (&pixels)[16][4], int component)
+{
+    int a0, a1;
+    if (isSigned)
+    {
+        /* Both -128 and -127 are decoded as -127 */
+        a0 = std::max(-127, static_cast<int>(static_cast<std::int8_t>(src[0])));
+        a1 = std::max(-127, static_cast<int>(static_cast<std::int8_t>(src[1])));
+    }
+    else
+    {
+        a0 = src[0];
+        a1 = src[1];
+    }
+
+    int palette[8];
+    BuildAlphaPalette(a0, a1, isSigned, palette);
+
+    const auto indices = ReadUInt48LE(src + 2);
+    for (int i = 0; i < 16; ++i)
+        pixels[i][component] = static_cast<std::uint8_t>(palette[(indices >> (i*3)) & 0x7] & 0xFF);
+}
+
+
+/* ----- Blocks ----- */
+
+static void EncodeBlock(const ImageFormat format, bool isSigned, bool highQuality, const std::uint8_t (&pixels)[16][4], std::uint8_t* dst)
+{
+    ColorBlock colorBlock;
+    int values[16];
+
+    auto loadColorBlock = [&]()
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            colorBlock.r[i] = static_cast<float>(pixels[i][0]);
+            colorBlock.g[i] = static_cast<float>(pixels[i][1]);
+            colorBlock.b[i] = static_cast<float>(pixels[i][2]);
+            colorBlock.a[i] = pixels[i][3];
+        }
+    };
+
+    auto loadChannel = [&](int component)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            if (isSigned)
+                values[i] = std::max(-127, static_cast<int>(static_cast<std::int8_t>(pixels[i][component])));
+            else
+                values[i] = pixels[i][component];
+        }
+    };
+
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            loadColorBlock();
+            EncodeColorBlock(colorBlock, true, highQuality, dst);
+            break;
+
+        case ImageFormat::BC2:
+            loadColorBlock();
+            EncodeExplicitAlphaBlock(colorBlock.a, dst);
+            EncodeColorBlock(colorBlock, false, highQuality, dst + 8);
+            break;
+
+        case ImageFormat::BC3:
+            loadColorBlock();
+            loadChannel(3);
+            EncodeAlphaBlock(values, false, highQuality, dst);
+            EncodeColorBlock(colorBlock, false, highQuality, dst + 8);
+            break;
+
+        case ImageFormat::BC4:
+            loadChannel(0);
+            EncodeAlphaBlock(values, isSigned, highQuality, dst);
+            break;
+
+        case ImageFormat::BC5:
+            loadChannel(0);
+            EncodeAlphaBlock(values, isSigned, highQuality, dst);
+            loadChannel(1);
+            EncodeAlphaBlock(values, isSigned, highQuality, dst + 8);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void DecodeBlock(const ImageFormat format, bool isSigned, const std::uint8_t* src, std::uint8_t (&pixels)[16][4])
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            DecodeColorBlock(src, true, pixels);
+            break;
+
+        case ImageFormat::BC2:
+            DecodeColorBlock(src + 8, false, pixels);
+            DecodeExplicitAlphaBlock(src, pixels);
+            break;
+
+        case ImageFormat::BC3:
+            DecodeColorBlock(src + 8, false, pixels);
+            DecodeAlphaBlock(src, false, pixels, 3);
+            break;
+
+        case ImageFormat::BC4:
+            DecodeAlphaBlock(src, isSigned, pixels, 0);
+            break;
+
+        case ImageFormat::BC5:
+            DecodeAlphaBlock(src, isSigned, pixels, 0);
+            DecodeAlphaBlock(src + 8, isSigned, pixels, 1);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Calls the specified function for each block in parallel, where the blocks are distributed across the global thread pool by rows.
+template <typename TFunc>
+void ForEachBlock(const Extent3D& extent, std::size_t threadCount, const TFunc& func)
+{
+    const std::size_t numBlocksX    = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY    = (extent.height + 3) / 4;
+    const std::size_t numBlockRows  = numBlocksY * extent.depth;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    GetGlobalThreadPool().ParallelFor(
+        numBlockRows,
+        std::max<std::size_t>(1, g_threadMinBlocks / std::max<std::size_t>(1, numBlocksX)),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                for (std::size_t x = 0; x < numBlocksX; ++x)
+                    func(row * numBlocksX + x, x * 4, (row % numBlocksY) * 4, row / numBlocksY);
+            }
+        }
+    );
+}
+
+
+/* ----- Functions ----- */
+
+std::uint32_t GetCompressedBlockSize(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return 8;
+        case ImageFormat::BC2:  return 16;
+        case ImageFormat::BC3:  return 16;
+        case ImageFormat::BC4:  return 8;
+        case ImageFormat::BC5:  return 16;
+        default:                return 0;
+    }
+}
+
+std::size_t GetCompressedImageDataSize(const ImageFormat format, const Extent3D& extent)
+{
+    const std::size_t numBlocksX = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY = (extent.height + 3) / 4;
+    return (numBlocksX * numBlocksY * extent.depth * GetCompressedBlockSize(format));
+}
+
+ImageFormat GetDecompressedImageFormat(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC4:  return ImageFormat::R;
+        case ImageFormat::BC5:  return ImageFormat::RG;
+        default:                return ImageFormat::RGBA;
+    }
+}
+
+void DecodeBlockCompressedImage(
+    const ImageFormat   format,
+    bool                isSigned,
+    const void*         src,
+    void*               dst,
+    const Extent3D&     extent,
+    std::size_t         threadCount)
+{
+    const std::size_t blockSize     = GetCompressedBlockSize(format);
+    const std::size_t numComponents = ImageFormatSize(GetDecompressedImageFormat(format));
+
+    auto srcBlocks = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstPixels = reinterpret_cast<std::uint8_t*>(dst);
+
+    ForEachBlock(
+        extent,
+        threadCount,
+        [&](std::size_t blockIdx, std::size_t x, std::size_t y, std::size_t z)
+        {
+            std::uint8_t pixels[16][4];
+            DecodeBlock(format, isSigned, srcBlocks + blockIdx * blockSize, pixels);
+
+            /* Write pixels that are inside the image */
+            const auto w = std::min<std::size_t>(4, extent.width  - x);
+            const auto h = std::min<std::size_t>(4, extent.height - y);
+
+            for (std::size_t j = 0; j < h; ++j)
+            {
+                auto dstRow = dstPixels + ((z * extent.height + y + j) * extent.width + x) * numComponents;
+                for (std::size_t i = 0; i < w; ++i)
+                {
+                    for (std::size_t c = 0; c < numComponents; ++c)
+                        dstRow[i * numComponents + c] = pixels[j*4 + i][c];
+                }
+            }
+        }
+    );
+}
+
+void EncodeBlockCompressedImage(
+    const ImageFormat   format,
+    bool                isSigned,
+    const void*         src,
+    void*               dst,
+    const Extent3D&     extent,
+    bool                highQuality,
+    std::size_t         threadCount)
+{
+    const std::size_t blockSize     = GetCompressedBlockSize(format);
+    const std::size_t numComponents = ImageFormatSize(GetDecompressedImageFormat(format));
+
+    auto srcPixels = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBlocks = reinterpret_cast<std::uint8_t*>(dst);
+
+    ForEachBlock(
+        extent,
+        threadCount,
+        [&](std::size_t blockIdx, std::size_t x, std::size_t y, std::size_t z)
+        {
+            /* Read pixels with coordinates clamped to the edge of the image */
+            std::uint8_t pixels[16][4] = {};
+
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                const auto py       = std::min<std::size_t>(y + j, extent.height - 1);
+                const auto srcRow   = srcPixels + (z * extent.height + py) * extent.width * numComponents;
+
+                for (std::size_t i = 0; i < 4; ++i)
+                {
+                    const auto px = std::min<std::size_t>(x + i, extent.width - 1);
+                    for (std::size_t c = 0; c < numComponents; ++c)
+                        pixels[j*4 + i][c] = srcRow[px * numComponents + c];
+                }
+            }
+
+            EncodeBlock(format, isSigned, highQuality, pixels, dstBlocks + blockIdx * blockSize);
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
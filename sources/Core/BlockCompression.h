@@ -0,0 +1,70 @@
+/*
+ * BlockCompression.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BLOCK_COMPRESSION_H
+#define LLGL_BLOCK_COMPRESSION_H
+
+
+#include <LLGL/Format.h>
+#include <LLGL/Types.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of a single 4x4 block of the specified compressed image format, or 0 if the format is not compressed.
+std::uint32_t GetCompressedBlockSize(const ImageFormat format);
+
+// Returns the size (in bytes) of an image with the specified compressed format and extent. Partial blocks at the border are counted as entire blocks.
+std::size_t GetCompressedImageDataSize(const ImageFormat format, const Extent3D& extent);
+
+// Returns the uncompressed image format each compressed format is encoded from and decoded to, i.e. RGBA for BC1-BC3, R for BC4, and RG for BC5.
+ImageFormat GetDecompressedImageFormat(const ImageFormat format);
+
+/*
+Decodes the block compressed source image into uncompressed 8-bit components (see GetDecompressedImageFormat).
+If 'isSigned' is true, BC4 and BC5 blocks are decoded as signed normalized values (i.e. BC4SNorm and BC5SNorm).
+The blocks are decoded in parallel across the global thread pool.
+*/
+void DecodeBlockCompressedImage(
+    const ImageFormat   format,
+    bool                isSigned,
+    const void*         src,
+    void*               dst,
+    const Extent3D&     extent,
+    std::size_t         threadCount
+);
+
+/*
+Encodes the uncompressed 8-bit source image (see GetDecompressedImageFormat) into blocks of the specified compressed format.
+The fast mode derives the endpoints from the bounding box of each block.
+The high-quality mode additionally fits the endpoints to the principal axis and refines them with a least-squares pass,
+and for BC1 it also tries the 3-color mode for opaque blocks.
+Pixels of partial blocks at the border are clamped to the edge of the image.
+*/
+void EncodeBlockCompressedImage(
+    const ImageFormat   format,
+    bool                isSigned,
+    const void*         src,
+    void*               dst,
+    const Extent3D&     extent,
+    bool                highQuality,
+    std::size_t         threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
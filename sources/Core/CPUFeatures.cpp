@@ -0,0 +1,119 @@
+/*
+ * CPUFeatures.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CPUFeatures.h"
+#include <cstdint>
+
+#if defined LLGL_SIMD_SSE2
+#   if defined _MSC_VER
+#       include <intrin.h>
+#       include <immintrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+
+namespace LLGL
+{
+
+
+#ifdef LLGL_SIMD_SSE2
+
+// Queries the CPUID registers EAX, EBX, ECX, EDX for the specified leaf and sub-leaf.
+static void QueryCPUID(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t (&regs)[4])
+{
+    #ifdef _MSC_VER
+    int info[4] = { 0, 0, 0, 0 };
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<std::uint32_t>(info[i]);
+    #else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// Returns the extended control register XCR0, which specifies the register states the OS saves on context switches.
+static std::uint64_t QueryXCR0()
+{
+    #ifdef _MSC_VER
+    return static_cast<std::uint64_t>(_xgetbv(0));
+    #else
+    std::uint32_t eax = 0, edx = 0;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((static_cast<std::uint64_t>(edx) << 32) | eax);
+    #endif
+}
+
+static CPUFeatures QueryCPUFeatures()
+{
+    CPUFeatures features;
+
+    std::uint32_t regs[4];
+    QueryCPUID(0, 0, regs);
+    const auto maxLeaf = regs[0];
+
+    if (maxLeaf >= 1)
+    {
+        QueryCPUID(1, 0, regs);
+        features.sse2 = ((regs[3] & (1u << 26)) != 0);
+
+        /* AVX requires OS support to save the YMM registers (XCR0 bits 1 and 2) */
+        const bool osxsave = ((regs[2] & (1u << 27)) != 0);
+        const bool hasAVX  = ((regs[2] & (1u << 28)) != 0);
+        const bool hasF16C = ((regs[2] & (1u << 29)) != 0);
+
+        if (osxsave && hasAVX)
+        {
+            const auto xcr0 = QueryXCR0();
+            if ((xcr0 & 0x06) == 0x06)
+            {
+                features.avx  = true;
+                features.f16c = hasF16C;
+
+                if (maxLeaf >= 7)
+                {
+                    QueryCPUID(7, 0, regs);
+                    features.avx2 = ((regs[1] & (1u << 5)) != 0);
+
+                    /* AVX-512 additionally requires the opmask and ZMM register states (XCR0 bits 5, 6, and 7) */
+                    if ((xcr0 & 0xE0) == 0xE0)
+                        features.avx512f = ((regs[1] & (1u << 16)) != 0);
+                }
+            }
+        }
+    }
+
+    return features;
+}
+
+#else // LLGL_SIMD_SSE2
+
+static CPUFeatures QueryCPUFeatures()
+{
+    CPUFeatures features;
+    #ifdef LLGL_SIMD_NEON
+    features.neon = true;
+    #endif
+    return features;
+}
+
+#endif // /LLGL_SIMD_SSE2
+
+LLGL_EXPORT const CPUFeatures& GetCPUFeatures()
+{
+    static const CPUFeatures features = QueryCPUFeatures();
+    return features;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
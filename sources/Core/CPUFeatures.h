@@ -0,0 +1,67 @@
+/*
+ * CPUFeatures.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CPU_FEATURES_H
+#define LLGL_CPU_FEATURES_H
+
+
+#include <LLGL/Export.h>
+
+
+/*
+Macros for SIMD instruction sets that are available at compile time.
+SSE2 is part of the AMD64 baseline and NEON is part of the ARM64 baseline,
+all other instruction sets must be selected at runtime via GetCPUFeatures().
+*/
+
+#if defined _M_X64 || defined __amd64__ || defined __x86_64__ || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__
+#   define LLGL_SIMD_SSE2
+#endif
+
+#if defined __aarch64__ || defined _M_ARM64
+#   define LLGL_SIMD_NEON
+#endif
+
+// Function attribute to enable AVX2 code generation for a single function (required by GCC and Clang).
+#if defined LLGL_SIMD_SSE2 && (defined __GNUC__ || defined __clang__)
+#   define LLGL_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#   define LLGL_SIMD_TARGET_F16C __attribute__((target("avx,f16c")))
+#   define LLGL_SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#   define LLGL_SIMD_TARGET_AVX2
+#   define LLGL_SIMD_TARGET_F16C
+#   define LLGL_SIMD_TARGET_AVX512
+#endif
+
+
+namespace LLGL
+{
+
+
+// CPU features that are queried at runtime.
+struct CPUFeatures
+{
+    bool sse2       = false;
+    bool avx        = false;
+    bool avx2       = false;
+    bool f16c       = false;
+    bool avx512f    = false;
+    bool neon       = false;
+};
+
+// Returns the CPU features of the host system. The features are only queried once.
+LLGL_EXPORT const CPUFeatures& GetCPUFeatures();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
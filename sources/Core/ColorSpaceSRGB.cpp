@@ -0,0 +1,398 @@
+/*
+ * ColorSpaceSRGB.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ColorSpaceSRGB.h"
+#include "CPUFeatures.h"
+#include <cstring>
+
+#if defined LLGL_SIMD_SSE2
+#   include <immintrin.h>
+#elif defined LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Lookup tables to decode 8-bit components: one for sRGB color components and one for linear alpha components.
+struct SRGB8DecodeTable
+{
+    float srgb[256];
+    float unorm[256];
+};
+
+/*
+Piecewise linear approximation of the sRGB encoding function for 8-bit outputs.
+The input range [2^-13, 1) is split into 13 octaves of 8 segments each, i.e. each segment is indexed by the exponent and the upper 3 mantissa bits.
+Within a segment, the next 8 mantissa bits interpolate linearly with 16.16 fixed point bias and scale (see the stb_image_resize implementation by Fabian Giesen).
+*/
+struct SRGB8EncodeTable
+{
+    std::uint32_t bias[104];
+    std::uint32_t scale[104];
+};
+
+static const std::uint32_t g_encodeMinBits      = (127 - 13) << 23; // 2^-13, smaller values are encoded to 0
+static const std::uint32_t g_encodeAlmostOne    = 0x3F7FFFFF;       // Largest float below 1, larger values are encoded to 255
+
+
+/* ----- Internal functions ----- */
+
+static inline float BitsToFloat(std::uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline std::uint32_t FloatToBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static SRGB8DecodeTable BuildSRGB8DecodeTable()
+{
+    SRGB8DecodeTable table;
+    for (int i = 0; i < 256; ++i)
+    {
+        table.srgb[i]   = static_cast<float>(DecodeSRGB(static_cast<double>(i) / 255.0));
+        table.unorm[i]  = static_cast<float>(i) / 255.0f;
+    }
+    return table;
+}
+
+static SRGB8EncodeTable BuildSRGB8EncodeTable()
+{
+    SRGB8EncodeTable table;
+
+    for (std::uint32_t i = 0; i < 104; ++i)
+    {
+        /* Fit line through the encoded values (with rounding bias) of the 256 sub-segments with least squares */
+        const double x0 = BitsToFloat(g_encodeMinBits + (i << 20));
+        const double x1 = BitsToFloat(g_encodeMinBits + ((i + 1) << 20));
+
+        double sumT = 0.0, sumY = 0.0, sumTT = 0.0, sumTY = 0.0;
+
+        for (int t = 0; t < 256; ++t)
+        {
+            const double x = x0 + (x1 - x0) * (t + 0.5) / 256.0;
+            const double y = EncodeSRGB(x) * 255.0 + 0.5;
+            sumT    += t;
+            sumY    += y;
+            sumTT   += t*t;
+            sumTY   += t*y;
+        }
+
+        const double scale  = (256.0 * sumTY - sumT * sumY) / (256.0 * sumTT - sumT * sumT);
+        const double bias   = (sumY - scale * sumT) / 256.0;
+
+        table.bias[i]   = static_cast<std::uint32_t>(bias * 65536.0 + 0.5);
+        table.scale[i]  = static_cast<std::uint32_t>(scale * 65536.0 + 0.5);
+    }
+
+    return table;
+}
+
+static const SRGB8DecodeTable& GetSRGB8DecodeTable()
+{
+    static const SRGB8DecodeTable table = BuildSRGB8DecodeTable();
+    return table;
+}
+
+static const SRGB8EncodeTable& GetSRGB8EncodeTable()
+{
+    static const SRGB8EncodeTable table = BuildSRGB8EncodeTable();
+    return table;
+}
+
+static inline std::uint8_t EncodeSRGB8Scalar(float value, const SRGB8EncodeTable& table)
+{
+    /* Clamp to [2^-13, 1-eps], written such that NaN is encoded to 0 */
+    if (!(value > BitsToFloat(g_encodeMinBits)))
+        value = BitsToFloat(g_encodeMinBits);
+    if (value > BitsToFloat(g_encodeAlmostOne))
+        value = BitsToFloat(g_encodeAlmostOne);
+
+    const auto bits = FloatToBits(value);
+    const auto idx  = (bits - g_encodeMinBits) >> 20;
+    const auto t    = (bits >> 12) & 0xFF;
+
+    return static_cast<std::uint8_t>((table.bias[idx] + table.scale[idx] * t) >> 16);
+}
+
+static inline std::uint8_t EncodeUNorm8Scalar(float value)
+{
+    /* Clamp to [0, 1], written such that NaN is encoded to 0 */
+    value = (value > 0.0f ? value : 0.0f);
+    value = (value < 1.0f ? value : 1.0f);
+    return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+}
+
+template <typename T>
+void ConvertColorSpaceSRGBPrimary(T* data, std::size_t numPixels, ImageFormat format, bool toLinear)
+{
+    const std::size_t   numComponents   = ImageFormatSize(format);
+    const int           alphaIndex      = GetAlphaComponentIndex(format);
+
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+        T* pixel = data + i * numComponents;
+        for (std::size_t c = 0; c < numComponents; ++c)
+        {
+            if (static_cast<int>(c) != alphaIndex)
+                pixel[c] = (toLinear ? DecodeSRGB(pixel[c]) : EncodeSRGB(pixel[c]));
+        }
+    }
+}
+
+/*
+Returns a bit mask of the alpha components within each group of 4 components, e.g. 0x8 for RGBA and 0x1 for ARGB.
+This is sufficient for all image formats, since only formats with 1 or 4 components have an alpha component.
+*/
+static int GetAlphaComponentMask(ImageFormat format)
+{
+    const int alphaIndex = GetAlphaComponentIndex(format);
+    if (alphaIndex < 0)
+        return 0x0;
+    if (ImageFormatSize(format) == 1)
+        return 0xF;
+    return (1 << alphaIndex);
+}
+
+
+/* ----- SIMD encoding ----- */
+
+#if defined LLGL_SIMD_SSE2
+
+// Encodes 4 floats into 4 integers in [0, 255]; lanes in 'alphaMask' are encoded linearly.
+static inline __m128i EncodeSRGB8x4SSE2(__m128 value, __m128i alphaMask, const SRGB8EncodeTable& table)
+{
+    /* Encode sRGB lanes; SSE2 has no gather instruction, so the table entries are loaded for each lane */
+    const __m128    clamped = _mm_min_ps(_mm_max_ps(value, _mm_castsi128_ps(_mm_set1_epi32(g_encodeMinBits))), _mm_castsi128_ps(_mm_set1_epi32(g_encodeAlmostOne)));
+    const __m128i   bits    = _mm_castps_si128(clamped);
+    const __m128i   t       = _mm_and_si128(_mm_srli_epi32(bits, 12), _mm_set1_epi32(0xFF));
+
+    alignas(16) std::uint32_t idx[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(idx), _mm_srli_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(g_encodeMinBits)), 20));
+
+    const __m128i bias  = _mm_setr_epi32(table.bias[idx[0]], table.bias[idx[1]], table.bias[idx[2]], table.bias[idx[3]]);
+    const __m128i scale = _mm_setr_epi32(table.scale[idx[0]], table.scale[idx[1]], table.scale[idx[2]], table.scale[idx[3]]);
+
+    /* Scale is less than 2^16 and t less than 2^8, so the 32-bit product can be assembled from 16-bit multiplications */
+    const __m128i product   = _mm_or_si128(_mm_mullo_epi16(scale, t), _mm_slli_epi32(_mm_mulhi_epu16(scale, t), 16));
+    const __m128i srgb      = _mm_srli_epi32(_mm_add_epi32(bias, product), 16);
+
+    /* Encode alpha lanes */
+    const __m128 unorm  = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    const __m128i alpha = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(unorm, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+
+    return _mm_or_si128(_mm_and_si128(alphaMask, alpha), _mm_andnot_si128(alphaMask, srgb));
+}
+
+static std::size_t EncodeSRGB8SSE2(const float* src, std::uint8_t* dst, std::size_t count, int alphaComponentMask, const SRGB8EncodeTable& table)
+{
+    const __m128i alphaMask = _mm_setr_epi32(
+        (alphaComponentMask & 0x1) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x2) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x4) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x8) != 0 ? -1 : 0
+    );
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = EncodeSRGB8x4SSE2(_mm_loadu_ps(src + i    ), alphaMask, table);
+        __m128i hi = EncodeSRGB8x4SSE2(_mm_loadu_ps(src + i + 4), alphaMask, table);
+        __m128i v  = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+    return i;
+}
+
+// Encodes 8 floats into 8 integers in [0, 255]; lanes in 'alphaMask' are encoded linearly.
+LLGL_SIMD_TARGET_AVX2
+static inline __m256i EncodeSRGB8x8AVX2(__m256 value, __m256i alphaMask, const SRGB8EncodeTable& table)
+{
+    /* Encode sRGB lanes */
+    const __m256    clamped = _mm256_min_ps(_mm256_max_ps(value, _mm256_castsi256_ps(_mm256_set1_epi32(g_encodeMinBits))), _mm256_castsi256_ps(_mm256_set1_epi32(g_encodeAlmostOne)));
+    const __m256i   bits    = _mm256_castps_si256(clamped);
+    const __m256i   idx     = _mm256_srli_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(g_encodeMinBits)), 20);
+    const __m256i   t       = _mm256_and_si256(_mm256_srli_epi32(bits, 12), _mm256_set1_epi32(0xFF));
+    const __m256i   bias    = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table.bias), idx, 4);
+    const __m256i   scale   = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table.scale), idx, 4);
+    const __m256i   srgb    = _mm256_srli_epi32(_mm256_add_epi32(bias, _mm256_mullo_epi32(scale, t)), 16);
+
+    /* Encode alpha lanes */
+    const __m256    unorm   = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    const __m256i   alpha   = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(unorm, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+
+    return _mm256_blendv_epi8(srgb, alpha, alphaMask);
+}
+
+LLGL_SIMD_TARGET_AVX2
+static std::size_t EncodeSRGB8AVX2(const float* src, std::uint8_t* dst, std::size_t count, int alphaComponentMask, const SRGB8EncodeTable& table)
+{
+    const __m128i alphaMask4 = _mm_setr_epi32(
+        (alphaComponentMask & 0x1) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x2) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x4) != 0 ? -1 : 0,
+        (alphaComponentMask & 0x8) != 0 ? -1 : 0
+    );
+    const __m256i alphaMask = _mm256_inserti128_si256(_mm256_castsi128_si256(alphaMask4), alphaMask4, 1);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i a = EncodeSRGB8x8AVX2(_mm256_loadu_ps(src + i    ), alphaMask, table);
+        __m256i b = EncodeSRGB8x8AVX2(_mm256_loadu_ps(src + i + 8), alphaMask, table);
+
+        /* Packing operates on 128-bit lanes, so pack the lower and upper halves separately */
+        __m128i lo = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+        __m128i hi = _mm_packs_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+#elif defined LLGL_SIMD_NEON
+
+// Encodes 4 floats into 4 integers in [0, 255]; lanes in 'alphaMask' are encoded linearly.
+static inline uint32x4_t EncodeSRGB8x4NEON(float32x4_t value, uint32x4_t alphaMask, const SRGB8EncodeTable& table)
+{
+    /* Encode sRGB lanes; NEON min/max propagate NaN, so clamp the lower bound with a comparison */
+    const float32x4_t minValue  = vreinterpretq_f32_u32(vdupq_n_u32(g_encodeMinBits));
+    const float32x4_t clamped   = vminq_f32(vbslq_f32(vcgtq_f32(value, minValue), value, minValue), vreinterpretq_f32_u32(vdupq_n_u32(g_encodeAlmostOne)));
+    const uint32x4_t  bits      = vreinterpretq_u32_f32(clamped);
+    const uint32x4_t  idx       = vshrq_n_u32(vsubq_u32(bits, vdupq_n_u32(g_encodeMinBits)), 20);
+    const uint32x4_t  t         = vandq_u32(vshrq_n_u32(bits, 12), vdupq_n_u32(0xFF));
+
+    uint32x4_t bias = vdupq_n_u32(table.bias[vgetq_lane_u32(idx, 0)]);
+    bias = vsetq_lane_u32(table.bias[vgetq_lane_u32(idx, 1)], bias, 1);
+    bias = vsetq_lane_u32(table.bias[vgetq_lane_u32(idx, 2)], bias, 2);
+    bias = vsetq_lane_u32(table.bias[vgetq_lane_u32(idx, 3)], bias, 3);
+
+    uint32x4_t scale = vdupq_n_u32(table.scale[vgetq_lane_u32(idx, 0)]);
+    scale = vsetq_lane_u32(table.scale[vgetq_lane_u32(idx, 1)], scale, 1);
+    scale = vsetq_lane_u32(table.scale[vgetq_lane_u32(idx, 2)], scale, 2);
+    scale = vsetq_lane_u32(table.scale[vgetq_lane_u32(idx, 3)], scale, 3);
+
+    const uint32x4_t srgb = vshrq_n_u32(vaddq_u32(bias, vmulq_u32(scale, t)), 16);
+
+    /* Encode alpha lanes */
+    const float32x4_t zero  = vdupq_n_f32(0.0f);
+    const float32x4_t unorm = vminq_f32(vbslq_f32(vcgtq_f32(value, zero), value, zero), vdupq_n_f32(1.0f));
+    const uint32x4_t  alpha = vcvtq_u32_f32(vaddq_f32(vmulq_f32(unorm, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f)));
+
+    return vbslq_u32(alphaMask, alpha, srgb);
+}
+
+static std::size_t EncodeSRGB8NEON(const float* src, std::uint8_t* dst, std::size_t count, int alphaComponentMask, const SRGB8EncodeTable& table)
+{
+    const std::uint32_t alphaMaskBits[4] =
+    {
+        (alphaComponentMask & 0x1) != 0 ? 0xFFFFFFFFu : 0u,
+        (alphaComponentMask & 0x2) != 0 ? 0xFFFFFFFFu : 0u,
+        (alphaComponentMask & 0x4) != 0 ? 0xFFFFFFFFu : 0u,
+        (alphaComponentMask & 0x8) != 0 ? 0xFFFFFFFFu : 0u,
+    };
+    const uint32x4_t alphaMask = vld1q_u32(alphaMaskBits);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x4_t lo = vmovn_u32(EncodeSRGB8x4NEON(vld1q_f32(src + i    ), alphaMask, table));
+        uint16x4_t hi = vmovn_u32(EncodeSRGB8x4NEON(vld1q_f32(src + i + 4), alphaMask, table));
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(lo, hi)));
+    }
+    return i;
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Functions ----- */
+
+int GetAlphaComponentIndex(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::Alpha:    return 0;
+        case ImageFormat::RGBA:     return 3;
+        case ImageFormat::BGRA:     return 3;
+        case ImageFormat::ARGB:     return 0;
+        case ImageFormat::ABGR:     return 0;
+        default:                    return -1;
+    }
+}
+
+void ConvertColorSpaceSRGB(float* data, std::size_t numPixels, ImageFormat format, bool toLinear)
+{
+    ConvertColorSpaceSRGBPrimary(data, numPixels, format, toLinear);
+}
+
+void ConvertColorSpaceSRGB(double* data, std::size_t numPixels, ImageFormat format, bool toLinear)
+{
+    ConvertColorSpaceSRGBPrimary(data, numPixels, format, toLinear);
+}
+
+void DecodeSRGB8(const std::uint8_t* src, float* dst, std::size_t numPixels, ImageFormat format)
+{
+    const auto&         table           = GetSRGB8DecodeTable();
+    const std::size_t   numComponents   = ImageFormatSize(format);
+    const int           alphaIndex      = GetAlphaComponentIndex(format);
+
+    /* Select lookup table for each component */
+    const float* componentTables[4] = { table.srgb, table.srgb, table.srgb, table.srgb };
+    if (alphaIndex >= 0)
+        componentTables[alphaIndex] = table.unorm;
+
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+        for (std::size_t c = 0; c < numComponents; ++c)
+            dst[c] = componentTables[c][src[c]];
+        src += numComponents;
+        dst += numComponents;
+    }
+}
+
+void EncodeSRGB8(const float* src, std::uint8_t* dst, std::size_t numPixels, ImageFormat format)
+{
+    const auto&         table               = GetSRGB8EncodeTable();
+    const std::size_t   count               = numPixels * ImageFormatSize(format);
+    const int           alphaComponentMask  = GetAlphaComponentMask(format);
+
+    /* Encode groups of components with SIMD instructions; alpha components repeat every 4 components */
+    #if defined LLGL_SIMD_SSE2
+    std::size_t i = (GetCPUFeatures().avx2 ? EncodeSRGB8AVX2(src, dst, count, alphaComponentMask, table) : EncodeSRGB8SSE2(src, dst, count, alphaComponentMask, table));
+    #elif defined LLGL_SIMD_NEON
+    std::size_t i = EncodeSRGB8NEON(src, dst, count, alphaComponentMask, table);
+    #else
+    std::size_t i = 0;
+    #endif
+
+    /* Encode remaining components */
+    for (; i < count; ++i)
+    {
+        if ((alphaComponentMask & (1 << (i % 4))) != 0)
+            dst[i] = EncodeUNorm8Scalar(src[i]);
+        else
+            dst[i] = EncodeSRGB8Scalar(src[i], table);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,72 @@
+/*
+ * ColorSpaceSRGB.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_COLOR_SPACE_SRGB_H
+#define LLGL_COLOR_SPACE_SRGB_H
+
+
+#include <LLGL/Format.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Templates ----- */
+
+// Decodes the specified sRGB value into linear color space with the exact transfer function.
+template <typename T>
+T DecodeSRGB(T value)
+{
+    return (value <= T(0.04045) ? value / T(12.92) : static_cast<T>(std::pow((value + T(0.055)) / T(1.055), T(2.4))));
+}
+
+// Encodes the specified linear value into sRGB color space with the exact transfer function.
+template <typename T>
+T EncodeSRGB(T value)
+{
+    return (value <= T(0.0031308) ? value * T(12.92) : static_cast<T>(T(1.055) * std::pow(value, T(1.0 / 2.4)) - T(0.055)));
+}
+
+
+/* ----- Functions ----- */
+
+// Returns the index of the alpha component for the specified image format, or -1 if the format has no alpha component.
+int GetAlphaComponentIndex(ImageFormat format);
+
+/*
+Converts the color components (i.e. all except alpha) of the specified buffer between sRGB and linear color space with the exact transfer functions.
+The buffer contains 'numPixels' pixels of the specified image format.
+*/
+void ConvertColorSpaceSRGB(float* data, std::size_t numPixels, ImageFormat format, bool toLinear);
+void ConvertColorSpaceSRGB(double* data, std::size_t numPixels, ImageFormat format, bool toLinear);
+
+/*
+Decodes 8-bit sRGB components into linear floats with a 256-entry lookup table.
+Alpha components are only normalized, i.e. they are identical to the regular UInt8 to Float32 conversion.
+*/
+void DecodeSRGB8(const std::uint8_t* src, float* dst, std::size_t numPixels, ImageFormat format);
+
+/*
+Encodes linear floats into 8-bit sRGB components with a piecewise linear approximation, which is vectorized with SSE2/AVX2 or NEON.
+The results are rounded to nearest and differ by at most one from the exact transfer function.
+Alpha components are clamped to [0, 1] and rounded to nearest.
+*/
+void EncodeSRGB8(const float* src, std::uint8_t* dst, std::size_t numPixels, ImageFormat format);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,519 @@
+/*
+ * DataTypeKernels.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "DataTypeKernels.h"
+#include "Float16Compressor.h"
+#include <cstdint>
+
+#if defined LLGL_SIMD_SSE2
+#   include <immintrin.h>
+#elif defined LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Storage type and normalized read/write functions for each data type.
+template <DataType T>
+struct DataTypeTraits;
+
+#define LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS(DATATYPE, TYPE)     \
+    template <>                                                 \
+    struct DataTypeTraits<DataType::DATATYPE>                   \
+    {                                                           \
+        using Type = TYPE;                                      \
+        static inline double Read(const Type& src)              \
+        {                                                       \
+            return ReadNormalizedVariant(src);                  \
+        }                                                       \
+        static inline void Write(Type& dst, double value)       \
+        {                                                       \
+            WriteNormalizedVariant(dst, value);                 \
+        }                                                       \
+    }
+
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( Int8,   std::int8_t   );
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( UInt8,  std::uint8_t  );
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( Int16,  std::int16_t  );
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( UInt16, std::uint16_t );
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( Int32,  std::int32_t  );
+LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS( UInt32, std::uint32_t );
+
+#undef LLGL_DECL_INTEGRAL_DATA_TYPE_TRAITS
+
+template <>
+struct DataTypeTraits<DataType::Float16>
+{
+    using Type = std::uint16_t;
+    static inline double Read(const Type& src)
+    {
+        return static_cast<double>(DecompressFloat16(src));
+    }
+    static inline void Write(Type& dst, double value)
+    {
+        dst = CompressFloat16(static_cast<float>(value));
+    }
+};
+
+template <>
+struct DataTypeTraits<DataType::Float32>
+{
+    using Type = float;
+    static inline double Read(const Type& src)
+    {
+        return static_cast<double>(src);
+    }
+    static inline void Write(Type& dst, double value)
+    {
+        dst = static_cast<float>(value);
+    }
+};
+
+template <>
+struct DataTypeTraits<DataType::Float64>
+{
+    using Type = double;
+    static inline double Read(const Type& src)
+    {
+        return src;
+    }
+    static inline void Write(Type& dst, double value)
+    {
+        dst = value;
+    }
+};
+
+
+/* ----- Generic kernels ----- */
+
+// Generic kernel without per-element type switch; the compiler can unroll and auto-vectorize this loop.
+template <DataType TSrc, DataType TDst>
+void ConvertDataTypeGeneric(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    using SrcTraits = DataTypeTraits<TSrc>;
+    using DstTraits = DataTypeTraits<TDst>;
+
+    auto srcBuf = reinterpret_cast<const typename SrcTraits::Type*>(src);
+    auto dstBuf = reinterpret_cast<typename DstTraits::Type*>(dst);
+
+    for (auto i = idxBegin; i < idxEnd; ++i)
+        DstTraits::Write(dstBuf[i], SrcTraits::Read(srcBuf[i]));
+}
+
+// Number of data types excluding DataType::Undefined.
+static const std::size_t g_numDataTypes = 9;
+
+#define LLGL_GENERIC_KERNEL_ROW(SRC)                            \
+    {                                                           \
+        ConvertDataTypeGeneric< SRC, DataType::Int8    >,       \
+        ConvertDataTypeGeneric< SRC, DataType::UInt8   >,       \
+        ConvertDataTypeGeneric< SRC, DataType::Int16   >,       \
+        ConvertDataTypeGeneric< SRC, DataType::UInt16  >,       \
+        ConvertDataTypeGeneric< SRC, DataType::Int32   >,       \
+        ConvertDataTypeGeneric< SRC, DataType::UInt32  >,       \
+        ConvertDataTypeGeneric< SRC, DataType::Float16 >,       \
+        ConvertDataTypeGeneric< SRC, DataType::Float32 >,       \
+        ConvertDataTypeGeneric< SRC, DataType::Float64 >,       \
+    }
+
+static const DataTypeKernel g_genericKernels[g_numDataTypes][g_numDataTypes] =
+{
+    LLGL_GENERIC_KERNEL_ROW( DataType::Int8    ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::UInt8   ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::Int16   ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::UInt16  ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::Int32   ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::UInt32  ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::Float16 ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::Float32 ),
+    LLGL_GENERIC_KERNEL_ROW( DataType::Float64 ),
+};
+
+#undef LLGL_GENERIC_KERNEL_ROW
+
+
+/* ----- Float16 kernels ----- */
+
+// Float16 <-> Float32 conversions are exact in both directions, so the bulk conversion is a drop-in replacement for the generic kernel.
+static void ConvertFloat16ToFloat32(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+    DecompressFloat16Array(srcBuf + idxBegin, dstBuf + idxBegin, idxEnd - idxBegin);
+}
+
+static void ConvertFloat32ToFloat16(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+    CompressFloat16Array(srcBuf + idxBegin, dstBuf + idxBegin, idxEnd - idxBegin);
+}
+
+
+/* ----- SIMD kernels ----- */
+
+/*
+Note about exactness:
+Integer-to-float conversions use a division instead of a multiplication with the reciprocal,
+because (x / 255) and (x / 65535) in single precision are bitwise identical to the double precision path.
+Float-to-integer conversions multiply in double precision, because the product must be truncated and
+rounding in single precision could otherwise push values like 0.99999994*255 onto the next integer.
+*/
+
+#if defined LLGL_SIMD_SSE2
+
+static void ConvertUInt8ToFloat32SSE2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128  scale = _mm_set1_ps(255.0f);
+
+    auto i = idxBegin;
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBuf + i));
+        __m128i lo  = _mm_unpacklo_epi8(v, zero);
+        __m128i hi  = _mm_unpackhi_epi8(v, zero);
+        _mm_storeu_ps(dstBuf + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dstBuf + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dstBuf + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(dstBuf + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt8, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+static void ConvertUInt16ToFloat32SSE2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128  scale = _mm_set1_ps(65535.0f);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBuf + i));
+        _mm_storeu_ps(dstBuf + i    , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+        _mm_storeu_ps(dstBuf + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt16, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+// Converts 4 floats into 4 truncated 32-bit integers after scaling them in double precision.
+static inline __m128i ScaleTruncateFloat32x4SSE2(const float* src, __m128d scale)
+{
+    __m128  v   = _mm_loadu_ps(src);
+    __m128i lo  = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(v), scale));
+    __m128i hi  = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), scale));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+static void ConvertFloat32ToUInt8SSE2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint8_t*>(dst);
+
+    const __m128d scale = _mm_set1_pd(255.0);
+
+    auto i = idxBegin;
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i a = ScaleTruncateFloat32x4SSE2(srcBuf + i     , scale);
+        __m128i b = ScaleTruncateFloat32x4SSE2(srcBuf + i +  4, scale);
+        __m128i c = ScaleTruncateFloat32x4SSE2(srcBuf + i +  8, scale);
+        __m128i d = ScaleTruncateFloat32x4SSE2(srcBuf + i + 12, scale);
+        __m128i v = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstBuf + i), v);
+    }
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt8>(src, dst, i, idxEnd);
+}
+
+static void ConvertFloat32ToUInt16SSE2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+
+    const __m128d scale = _mm_set1_pd(65535.0);
+    const __m128i bias  = _mm_set1_epi32(32768);
+    const __m128i sign  = _mm_set1_epi16(static_cast<short>(0x8000));
+    const __m128i neg   = _mm_set1_epi32(-1);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        __m128i a = ScaleTruncateFloat32x4SSE2(srcBuf + i    , scale);
+        __m128i b = ScaleTruncateFloat32x4SSE2(srcBuf + i + 4, scale);
+
+        /* Clamp negative integers (and the integer indefinite value of NaN) to zero, like the unsigned pack of the AVX2 kernel */
+        a = _mm_and_si128(a, _mm_cmpgt_epi32(a, neg));
+        b = _mm_and_si128(b, _mm_cmpgt_epi32(b, neg));
+
+        /* SSE2 has no unsigned 32-to-16 bit pack, so shift into signed range, pack with saturation, and flip the sign bit back */
+        a = _mm_sub_epi32(a, bias);
+        b = _mm_sub_epi32(b, bias);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstBuf + i), _mm_xor_si128(_mm_packs_epi32(a, b), sign));
+    }
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt16>(src, dst, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET_AVX2
+static void ConvertUInt8ToFloat32AVX2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const __m256 scale = _mm256_set1_ps(255.0f);
+
+    auto i = idxBegin;
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBuf + i));
+        __m256i lo  = _mm256_cvtepu8_epi32(v);
+        __m256i hi  = _mm256_cvtepu8_epi32(_mm_unpackhi_epi64(v, v));
+        _mm256_storeu_ps(dstBuf + i    , _mm256_div_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dstBuf + i + 8, _mm256_div_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt8, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET_AVX2
+static void ConvertUInt16ToFloat32AVX2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const __m256 scale = _mm256_set1_ps(65535.0f);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBuf + i)));
+        _mm256_storeu_ps(dstBuf + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt16, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+// Converts 8 floats into 8 truncated 32-bit integers (as two 128-bit vectors) after scaling them in double precision.
+LLGL_SIMD_TARGET_AVX2
+static inline void ScaleTruncateFloat32x8AVX2(const float* src, __m256d scale, __m128i& lo, __m128i& hi)
+{
+    __m256 v = _mm256_loadu_ps(src);
+    lo = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), scale));
+    hi = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), scale));
+}
+
+LLGL_SIMD_TARGET_AVX2
+static void ConvertFloat32ToUInt8AVX2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint8_t*>(dst);
+
+    const __m256d scale = _mm256_set1_pd(255.0);
+
+    auto i = idxBegin;
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i a, b, c, d;
+        ScaleTruncateFloat32x8AVX2(srcBuf + i    , scale, a, b);
+        ScaleTruncateFloat32x8AVX2(srcBuf + i + 8, scale, c, d);
+        __m128i v = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstBuf + i), v);
+    }
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt8>(src, dst, i, idxEnd);
+}
+
+LLGL_SIMD_TARGET_AVX2
+static void ConvertFloat32ToUInt16AVX2(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+
+    const __m256d scale = _mm256_set1_pd(65535.0);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        __m128i a, b;
+        ScaleTruncateFloat32x8AVX2(srcBuf + i, scale, a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstBuf + i), _mm_packus_epi32(a, b));
+    }
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt16>(src, dst, i, idxEnd);
+}
+
+#elif defined LLGL_SIMD_NEON
+
+static void ConvertUInt8ToFloat32NEON(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+
+    auto i = idxBegin;
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        uint8x16_t v    = vld1q_u8(srcBuf + i);
+        uint16x8_t lo   = vmovl_u8(vget_low_u8(v));
+        uint16x8_t hi   = vmovl_u8(vget_high_u8(v));
+        vst1q_f32(dstBuf + i     , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+        vst1q_f32(dstBuf + i +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+        vst1q_f32(dstBuf + i +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+        vst1q_f32(dstBuf + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt8, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+static void ConvertUInt16ToFloat32NEON(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+
+    const float32x4_t scale = vdupq_n_f32(65535.0f);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        uint16x8_t v = vld1q_u16(srcBuf + i);
+        vst1q_f32(dstBuf + i    , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), scale));
+        vst1q_f32(dstBuf + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), scale));
+    }
+
+    ConvertDataTypeGeneric<DataType::UInt16, DataType::Float32>(src, dst, i, idxEnd);
+}
+
+// Converts 4 floats into 4 truncated 32-bit integers after scaling them in double precision.
+static inline int32x4_t ScaleTruncateFloat32x4NEON(const float* src, float64x2_t scale)
+{
+    float32x4_t v   = vld1q_f32(src);
+    int64x2_t   lo  = vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(v)), scale));
+    int64x2_t   hi  = vcvtq_s64_f64(vmulq_f64(vcvt_high_f64_f32(v), scale));
+    return vcombine_s32(vqmovn_s64(lo), vqmovn_s64(hi));
+}
+
+static void ConvertFloat32ToUInt8NEON(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint8_t*>(dst);
+
+    const float64x2_t scale = vdupq_n_f64(255.0);
+
+    auto i = idxBegin;
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        uint16x4_t a = vqmovun_s32(ScaleTruncateFloat32x4NEON(srcBuf + i    , scale));
+        uint16x4_t b = vqmovun_s32(ScaleTruncateFloat32x4NEON(srcBuf + i + 4, scale));
+        vst1_u8(dstBuf + i, vqmovn_u16(vcombine_u16(a, b)));
+    }
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt8>(src, dst, i, idxEnd);
+}
+
+static void ConvertFloat32ToUInt16NEON(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+
+    const float64x2_t scale = vdupq_n_f64(65535.0);
+
+    auto i = idxBegin;
+    for (; i + 4 <= idxEnd; i += 4)
+        vst1_u16(dstBuf + i, vqmovun_s32(ScaleTruncateFloat32x4NEON(srcBuf + i, scale)));
+
+    ConvertDataTypeGeneric<DataType::Float32, DataType::UInt16>(src, dst, i, idxEnd);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+// Returns the SIMD kernel for the specified pair of data types or null if there is none.
+static DataTypeKernel GetDataTypeKernelSIMD(DataType srcDataType, DataType dstDataType, const CPUFeatures& cpuFeatures)
+{
+    /* Float16 array conversions select their SIMD path internally */
+    if (srcDataType == DataType::Float16 && dstDataType == DataType::Float32)
+        return ConvertFloat16ToFloat32;
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::Float16)
+        return ConvertFloat32ToFloat16;
+
+    #if defined LLGL_SIMD_SSE2
+
+    if (!cpuFeatures.sse2)
+        return nullptr;
+
+    const bool avx2 = cpuFeatures.avx2;
+
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+        return (avx2 ? ConvertUInt8ToFloat32AVX2 : ConvertUInt8ToFloat32SSE2);
+    if (srcDataType == DataType::UInt16 && dstDataType == DataType::Float32)
+        return (avx2 ? ConvertUInt16ToFloat32AVX2 : ConvertUInt16ToFloat32SSE2);
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+        return (avx2 ? ConvertFloat32ToUInt8AVX2 : ConvertFloat32ToUInt8SSE2);
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt16)
+        return (avx2 ? ConvertFloat32ToUInt16AVX2 : ConvertFloat32ToUInt16SSE2);
+
+    #elif defined LLGL_SIMD_NEON
+
+    if (!cpuFeatures.neon)
+        return nullptr;
+
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+        return ConvertUInt8ToFloat32NEON;
+    if (srcDataType == DataType::UInt16 && dstDataType == DataType::Float32)
+        return ConvertUInt16ToFloat32NEON;
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+        return ConvertFloat32ToUInt8NEON;
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt16)
+        return ConvertFloat32ToUInt16NEON;
+
+    #endif
+
+    return nullptr;
+}
+
+
+/* ----- Functions ----- */
+
+DataTypeKernel GetDataTypeKernel(DataType srcDataType, DataType dstDataType)
+{
+    return GetDataTypeKernel(srcDataType, dstDataType, GetCPUFeatures());
+}
+
+LLGL_EXPORT DataTypeKernel GetDataTypeKernel(DataType srcDataType, DataType dstDataType, const CPUFeatures& cpuFeatures)
+{
+    if (srcDataType == DataType::Undefined || dstDataType == DataType::Undefined)
+        return nullptr;
+
+    if (auto kernel = GetDataTypeKernelSIMD(srcDataType, dstDataType, cpuFeatures))
+        return kernel;
+
+    const auto srcIdx = static_cast<std::size_t>(srcDataType) - 1;
+    const auto dstIdx = static_cast<std::size_t>(dstDataType) - 1;
+
+    return g_genericKernels[srcIdx][dstIdx];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
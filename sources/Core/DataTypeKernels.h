@@ -0,0 +1,71 @@
+/*
+ * DataTypeKernels.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DATA_TYPE_KERNELS_H
+#define LLGL_DATA_TYPE_KERNELS_H
+
+
+#include "CPUFeatures.h"
+#include <LLGL/Format.h>
+#include <limits>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Templates ----- */
+
+// Reads the specified source variant and returns it to the normalized range [0, 1].
+template <typename T>
+double ReadNormalizedVariant(const T& src)
+{
+    auto min = static_cast<double>(std::numeric_limits<T>::min());
+    auto max = static_cast<double>(std::numeric_limits<T>::max());
+    return (static_cast<double>(src) - min) / (max - min);
+}
+
+// Writes the specified value from the range [0, 1] to the destination variant.
+template <typename T>
+void WriteNormalizedVariant(T& dst, double value)
+{
+    auto min = static_cast<double>(std::numeric_limits<T>::min());
+    auto max = static_cast<double>(std::numeric_limits<T>::max());
+    dst = static_cast<T>(value * (max - min) + min);
+}
+
+
+/* ----- Functions ----- */
+
+/*
+Kernel function to convert the components within the range [idxBegin, idxEnd) from one data type into another.
+Results are identical to ReadNormalizedVariant/WriteNormalizedVariant, i.e. the kernels are drop-in replacements for the generic conversion.
+*/
+using DataTypeKernel = void (*)(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd);
+
+/*
+Returns the specialized conversion kernel for the specified pair of data types or null if there is none.
+SIMD kernels (SSE2, AVX2, F16C, AVX-512, NEON) are selected at runtime for the most frequent pairs (e.g. UInt8 <-> Float32 and Float16 <-> Float32).
+*/
+DataTypeKernel GetDataTypeKernel(DataType srcDataType, DataType dstDataType);
+
+/*
+Returns the specialized conversion kernel for the specified pair of data types, but only selects SIMD kernels of the specified CPU features.
+This allows to verify each SIMD kernel against the generic conversion regardless of the host CPU.
+*/
+LLGL_EXPORT DataTypeKernel GetDataTypeKernel(DataType srcDataType, DataType dstDataType, const CPUFeatures& cpuFeatures);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,6 +6,14 @@
  */
 
 #include "Float16Compressor.h"
+#include "CPUFeatures.h"
+#include <cstring>
+
+#if defined LLGL_SIMD_SSE2
+#   include <immintrin.h>
+#elif defined LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
 
 
 namespace LLGL
@@ -13,94 +21,410 @@ namespace LLGL
 
 
 /*
-This class has been adopted from a public-domain code sample.
-see http://stackoverflow.com/questions/1659440/32-bit-to-16-bit-floating-point-conversion
+Conversion between 32-bit and 16-bit floats with round-to-nearest-even.
+All code paths produce the same results as the F16C instructions (VCVTPS2PH with _MM_FROUND_TO_NEAREST_INT and VCVTPH2PS):
+- Values that are too large for a 16-bit float are rounded to infinity.
+- Values that are too small for a normalized 16-bit float are rounded to subnormals or zero.
+- NaN values are converted to quiet NaN values and keep as many of their payload bits as possible.
+The algorithm is adopted from the public-domain code samples by Fabian Giesen (see https://gist.github.com/rygorous/2156668).
 */
-class Float16Compressor
-{
-
-    public:
-
-        static std::uint16_t Compress(float value)
-        {
-            Bits v, s;
-            v.f = value;
-            std::uint32_t sign = v.si & signN;
-            v.si ^= sign;
-            sign >>= shiftSign; // logical shift
-            s.si = mulN;
-            s.si = static_cast<std::int32_t>(s.f * v.f); // correct subnormals
-            v.si ^= (s.si ^ v.si) & -(minN > v.si);
-            v.si ^= (infN ^ v.si) & -((infN > v.si) & (v.si > maxN));
-            v.si ^= (nanN ^ v.si) & -((nanN > v.si) & (v.si > infN));
-            v.ui >>= shift; // logical shift
-            v.si ^= ((v.si - maxD) ^ v.si) & -(v.si > maxC);
-            v.si ^= ((v.si - minD) ^ v.si) & -(v.si > subC);
-            return (v.ui | sign);
-        }
-
-        static float Decompress(std::uint16_t value)
-        {
-            Bits v;
-            v.ui = value;
-            int32_t sign = v.si & signC;
-            v.si ^= sign;
-            sign <<= shiftSign;
-            v.si ^= ((v.si + minD) ^ v.si) & -(v.si > subC);
-            v.si ^= ((v.si + maxD) ^ v.si) & -(v.si > maxC);
-            Bits s;
-            s.si = mulC;
-            s.f *= v.si;
-            int32_t mask = -(norC > v.si);
-            v.si <<= shift;
-            v.si ^= (s.si ^ v.si) & mask;
-            v.si |= sign;
-            return v.f;
-        }
-
-    private:
-
-        union Bits
-        {
-            float           f;
-            std::int32_t    si;
-            std::uint32_t   ui;
-        };
-
-        static const std::int32_t shift     = 13;
-        static const std::int32_t shiftSign = 16;
-
-        static const std::int32_t infN      = 0x7f800000; // flt32 infinity
-        static const std::int32_t maxN      = 0x477fe000; // max flt16 normal as a flt32
-        static const std::int32_t minN      = 0x38800000; // min flt16 normal as a flt32
-        static const std::int32_t signN     = 0x80000000; // flt32 sign bit
-
-        static const std::int32_t infC      = (infN >> shift);
-        static const std::int32_t nanN      = ((infC + 1) << shift); // minimum flt16 nan as a flt32
-        static const std::int32_t maxC      = (maxN >> shift);
-        static const std::int32_t minC      = (minN >> shift);
-        static const std::int32_t signC     = (signN >> shiftSign); // flt16 sign bit
-
-        static const std::int32_t mulN      = 0x52000000; // (1 << 23) / minN
-        static const std::int32_t mulC      = 0x33800000; // minN / (1 << (23 - shift))
-
-        static const std::int32_t subC      = 0x003ff; // max flt32 subnormal down shifted
-        static const std::int32_t norC      = 0x00400; // min flt32 normal down shifted
-
-        static const std::int32_t maxD      = (infC - maxC - 1);
-        static const std::int32_t minD      = (minC - subC - 1);
-
-};
 
+/* ----- Internal constants ----- */
+
+static const std::uint32_t g_f32Infinity        = 0x7F800000; // flt32 infinity
+static const std::uint32_t g_f32SignMask        = 0x80000000; // flt32 sign bit
+static const std::uint32_t g_f32Float16Max      = 0x47800000; // 2^16, flt32 values at or above this are infinity or NaN in flt16
+static const std::uint32_t g_f32Float16MinNorm  = 0x38800000; // 2^-14, i.e. min flt16 normal as a flt32
+static const std::uint32_t g_f32DenormMagic     = 0x3F000000; // 0.5, adding it aligns the flt16 subnormal bits at the bottom of the mantissa
+static const std::uint32_t g_f32RebiasRound     = 0xC8000FFF; // (15 - 127) << 23 plus rounding bias of 0xFFF
+static const std::uint32_t g_f16QuietNaN        = 0x7E00;
+static const std::uint32_t g_f16Infinity        = 0x7C00;
+static const std::uint32_t g_f16ShiftedExp      = 0x0F800000; // flt16 exponent mask shifted into flt32 position
+static const std::uint32_t g_f16Rebias          = 0x38000000; // (127 - 15) << 23
+static const std::uint32_t g_f16RebiasInfNaN    = 0x38000000; // (128 - 16) << 23
+static const std::uint32_t g_f16DenormMagic     = 0x38800000; // 2^-14, i.e. 113 << 23
+
+
+/* ----- Scalar conversion ----- */
+
+static inline std::uint32_t FloatToBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float BitsToFloat(std::uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static std::uint16_t CompressFloat16Scalar(float value)
+{
+    auto bits = FloatToBits(value);
+
+    const auto sign = (bits & g_f32SignMask);
+    bits ^= sign;
+
+    std::uint32_t result;
+
+    if (bits >= g_f32Float16Max)
+    {
+        /* Result is infinity or quiet NaN with truncated payload */
+        if (bits > g_f32Infinity)
+            result = (g_f16QuietNaN | ((bits >> 13) & 0x03FF));
+        else
+            result = g_f16Infinity;
+    }
+    else if (bits < g_f32Float16MinNorm)
+    {
+        /* Result is subnormal or zero: let the FPU round the value at the bottom of the mantissa */
+        result = FloatToBits(BitsToFloat(bits) + BitsToFloat(g_f32DenormMagic)) - g_f32DenormMagic;
+    }
+    else
+    {
+        /* Result is normalized: rebias exponent and round to nearest even, which may carry into infinity */
+        const auto mantissaOdd = ((bits >> 13) & 1);
+        bits += g_f32RebiasRound;
+        bits += mantissaOdd;
+        result = (bits >> 13);
+    }
+
+    return static_cast<std::uint16_t>(result | (sign >> 16));
+}
+
+static float DecompressFloat16Scalar(std::uint16_t value)
+{
+    auto bits = (static_cast<std::uint32_t>(value) & 0x7FFF) << 13;
+    const auto exp = (bits & g_f16ShiftedExp);
+
+    bits += g_f16Rebias;
+
+    if (exp == g_f16ShiftedExp)
+    {
+        /* Infinity or NaN: adjust exponent and set quiet bit for NaN values */
+        bits += g_f16RebiasInfNaN;
+        if ((bits & 0x007FFFFF) != 0)
+            bits |= 0x00400000;
+    }
+    else if (exp == 0)
+    {
+        /* Zero or subnormal: renormalize with the FPU */
+        bits = FloatToBits(BitsToFloat(bits + (1u << 23)) - BitsToFloat(g_f16DenormMagic));
+    }
+
+    bits |= ((static_cast<std::uint32_t>(value) & 0x8000) << 16);
+
+    return BitsToFloat(bits);
+}
+
+
+/* ----- SIMD conversion ----- */
+
+#if defined LLGL_SIMD_SSE2
+
+static inline __m128i SelectSSE2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Converts 4 floats into 4 half floats in the lower 16 bits of each 32-bit lane.
+static inline __m128i CompressFloat16x4SSE2(__m128 value)
+{
+    __m128i bits = _mm_castps_si128(value);
+
+    const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(g_f32SignMask)));
+    bits = _mm_xor_si128(bits, sign);
+
+    /* Infinity and NaN */
+    const __m128i isInfOrNaN    = _mm_cmpgt_epi32(bits, _mm_set1_epi32(static_cast<int>(g_f32Float16Max - 1)));
+    const __m128i isNaN         = _mm_cmpgt_epi32(bits, _mm_set1_epi32(static_cast<int>(g_f32Infinity)));
+    const __m128i nan           = _mm_or_si128(_mm_set1_epi32(g_f16QuietNaN), _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(0x03FF)));
+    const __m128i infOrNaN      = SelectSSE2(isNaN, nan, _mm_set1_epi32(g_f16Infinity));
+
+    /* Subnormals and zero */
+    const __m128i isSubnormal   = _mm_cmplt_epi32(bits, _mm_set1_epi32(static_cast<int>(g_f32Float16MinNorm)));
+    const __m128  denormMagic   = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(g_f32DenormMagic)));
+    const __m128i subnormal     = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(bits), denormMagic)), _mm_castps_si128(denormMagic));
+
+    /* Normalized values */
+    const __m128i mantissaOdd   = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+    const __m128i normal        = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(static_cast<int>(g_f32RebiasRound))), mantissaOdd), 13);
+
+    __m128i result = SelectSSE2(isInfOrNaN, infOrNaN, SelectSSE2(isSubnormal, subnormal, normal));
+    return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+}
+
+// Converts 4 half floats in the lower 16 bits of each 32-bit lane into 4 floats.
+static inline __m128 DecompressFloat16x4SSE2(__m128i value)
+{
+    const __m128i shiftedExp = _mm_set1_epi32(g_f16ShiftedExp);
+
+    __m128i bits = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x7FFF)), 13);
+    const __m128i exp = _mm_and_si128(bits, shiftedExp);
+
+    bits = _mm_add_epi32(bits, _mm_set1_epi32(g_f16Rebias));
+
+    /* Infinity and NaN */
+    const __m128i isInfOrNaN    = _mm_cmpeq_epi32(exp, shiftedExp);
+    const __m128i hasMantissa   = _mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_setzero_si128()), _mm_set1_epi32(-1));
+    const __m128i quietBit      = _mm_and_si128(hasMantissa, _mm_set1_epi32(0x00400000));
+    const __m128i infOrNaN      = _mm_or_si128(_mm_add_epi32(bits, _mm_set1_epi32(g_f16RebiasInfNaN)), quietBit);
+
+    /* Subnormals and zero */
+    const __m128i isSubnormal   = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const __m128  denormMagic   = _mm_castsi128_ps(_mm_set1_epi32(g_f16DenormMagic));
+    const __m128i subnormal     = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), denormMagic));
+
+    bits = SelectSSE2(isInfOrNaN, infOrNaN, SelectSSE2(isSubnormal, subnormal, bits));
+    bits = _mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x8000)), 16));
+
+    return _mm_castsi128_ps(bits);
+}
+
+static void CompressFloat16ArraySSE2(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = CompressFloat16x4SSE2(_mm_loadu_ps(src + i    ));
+        __m128i hi = CompressFloat16x4SSE2(_mm_loadu_ps(src + i + 4));
+
+        /* SSE2 has no unsigned 32-to-16 bit pack, so sign-extend the lower 16 bits to make the signed pack lossless */
+        lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+        hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = CompressFloat16Scalar(src[i]);
+}
+
+static void DecompressFloat16ArraySSE2(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i    , DecompressFloat16x4SSE2(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_ps(dst + i + 4, DecompressFloat16x4SSE2(_mm_unpackhi_epi16(v, zero)));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = DecompressFloat16Scalar(src[i]);
+}
+
+LLGL_SIMD_TARGET_F16C
+static void CompressFloat16ArrayF16C(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+
+    for (; i < count; ++i)
+        dst[i] = CompressFloat16Scalar(src[i]);
+}
+
+LLGL_SIMD_TARGET_F16C
+static void DecompressFloat16ArrayF16C(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = DecompressFloat16Scalar(src[i]);
+}
+
+LLGL_SIMD_TARGET_AVX512
+static void CompressFloat16ArrayAVX512(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+
+    for (; i < count; ++i)
+        dst[i] = CompressFloat16Scalar(src[i]);
+}
+
+LLGL_SIMD_TARGET_AVX512
+static void DecompressFloat16ArrayAVX512(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(v));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = DecompressFloat16Scalar(src[i]);
+}
+
+#elif defined LLGL_SIMD_NEON
+
+// Converts 4 floats into 4 half floats in the lower 16 bits of each 32-bit lane.
+static inline uint32x4_t CompressFloat16x4NEON(float32x4_t value)
+{
+    uint32x4_t bits = vreinterpretq_u32_f32(value);
+
+    const uint32x4_t sign = vandq_u32(bits, vdupq_n_u32(g_f32SignMask));
+    bits = veorq_u32(bits, sign);
+
+    /* Infinity and NaN */
+    const uint32x4_t isInfOrNaN     = vcgeq_u32(bits, vdupq_n_u32(g_f32Float16Max));
+    const uint32x4_t isNaN          = vcgtq_u32(bits, vdupq_n_u32(g_f32Infinity));
+    const uint32x4_t nan            = vorrq_u32(vdupq_n_u32(g_f16QuietNaN), vandq_u32(vshrq_n_u32(bits, 13), vdupq_n_u32(0x03FF)));
+    const uint32x4_t infOrNaN       = vbslq_u32(isNaN, nan, vdupq_n_u32(g_f16Infinity));
+
+    /* Subnormals and zero */
+    const uint32x4_t isSubnormal    = vcltq_u32(bits, vdupq_n_u32(g_f32Float16MinNorm));
+    const float32x4_t denormMagic   = vreinterpretq_f32_u32(vdupq_n_u32(g_f32DenormMagic));
+    const uint32x4_t subnormal      = vsubq_u32(vreinterpretq_u32_f32(vaddq_f32(vreinterpretq_f32_u32(bits), denormMagic)), vdupq_n_u32(g_f32DenormMagic));
+
+    /* Normalized values */
+    const uint32x4_t mantissaOdd    = vandq_u32(vshrq_n_u32(bits, 13), vdupq_n_u32(1));
+    const uint32x4_t normal         = vshrq_n_u32(vaddq_u32(vaddq_u32(bits, vdupq_n_u32(g_f32RebiasRound)), mantissaOdd), 13);
+
+    uint32x4_t result = vbslq_u32(isInfOrNaN, infOrNaN, vbslq_u32(isSubnormal, subnormal, normal));
+    return vorrq_u32(result, vshrq_n_u32(sign, 16));
+}
+
+// Converts 4 half floats in 32-bit lanes into 4 floats.
+static inline float32x4_t DecompressFloat16x4NEON(uint32x4_t value)
+{
+    const uint32x4_t shiftedExp = vdupq_n_u32(g_f16ShiftedExp);
+
+    uint32x4_t bits = vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x7FFF)), 13);
+    const uint32x4_t exp = vandq_u32(bits, shiftedExp);
+
+    bits = vaddq_u32(bits, vdupq_n_u32(g_f16Rebias));
+
+    /* Infinity and NaN */
+    const uint32x4_t isInfOrNaN     = vceqq_u32(exp, shiftedExp);
+    const uint32x4_t hasMantissa    = vtstq_u32(bits, vdupq_n_u32(0x007FFFFF));
+    const uint32x4_t quietBit       = vandq_u32(hasMantissa, vdupq_n_u32(0x00400000));
+    const uint32x4_t infOrNaN       = vorrq_u32(vaddq_u32(bits, vdupq_n_u32(g_f16RebiasInfNaN)), quietBit);
+
+    /* Subnormals and zero */
+    const uint32x4_t isSubnormal    = vceqq_u32(exp, vdupq_n_u32(0));
+    const float32x4_t denormMagic   = vreinterpretq_f32_u32(vdupq_n_u32(g_f16DenormMagic));
+    const uint32x4_t subnormal      = vreinterpretq_u32_f32(vsubq_f32(vreinterpretq_f32_u32(vaddq_u32(bits, vdupq_n_u32(1u << 23))), denormMagic));
+
+    bits = vbslq_u32(isInfOrNaN, infOrNaN, vbslq_u32(isSubnormal, subnormal, bits));
+    bits = vorrq_u32(bits, vshlq_n_u32(vandq_u32(value, vdupq_n_u32(0x8000)), 16));
+
+    return vreinterpretq_f32_u32(bits);
+}
+
+static void CompressFloat16ArrayNEON(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x4_t lo = vmovn_u32(CompressFloat16x4NEON(vld1q_f32(src + i    )));
+        uint16x4_t hi = vmovn_u32(CompressFloat16x4NEON(vld1q_f32(src + i + 4)));
+        vst1q_u16(dst + i, vcombine_u16(lo, hi));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = CompressFloat16Scalar(src[i]);
+}
+
+static void DecompressFloat16ArrayNEON(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t v = vld1q_u16(src + i);
+        vst1q_f32(dst + i    , DecompressFloat16x4NEON(vmovl_u16(vget_low_u16(v))));
+        vst1q_f32(dst + i + 4, DecompressFloat16x4NEON(vmovl_u16(vget_high_u16(v))));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = DecompressFloat16Scalar(src[i]);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Functions ----- */
 
 LLGL_EXPORT std::uint16_t CompressFloat16(float value)
 {
-    return Float16Compressor::Compress(value);
+    return CompressFloat16Scalar(value);
 }
 
 LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
 {
-    return Float16Compressor::Decompress(value);
+    return DecompressFloat16Scalar(value);
+}
+
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    CompressFloat16Array(src, dst, count, GetCPUFeatures());
+}
+
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count, const CPUFeatures& cpuFeatures)
+{
+    #if defined LLGL_SIMD_SSE2
+
+    if (cpuFeatures.avx512f)
+        return CompressFloat16ArrayAVX512(src, dst, count);
+    if (cpuFeatures.f16c)
+        return CompressFloat16ArrayF16C(src, dst, count);
+    if (cpuFeatures.sse2)
+        return CompressFloat16ArraySSE2(src, dst, count);
+
+    #elif defined LLGL_SIMD_NEON
+
+    if (cpuFeatures.neon)
+        return CompressFloat16ArrayNEON(src, dst, count);
+
+    #endif
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = CompressFloat16Scalar(src[i]);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    DecompressFloat16Array(src, dst, count, GetCPUFeatures());
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count, const CPUFeatures& cpuFeatures)
+{
+    #if defined LLGL_SIMD_SSE2
+
+    if (cpuFeatures.avx512f)
+        return DecompressFloat16ArrayAVX512(src, dst, count);
+    if (cpuFeatures.f16c)
+        return DecompressFloat16ArrayF16C(src, dst, count);
+    if (cpuFeatures.sse2)
+        return DecompressFloat16ArraySSE2(src, dst, count);
+
+    #elif defined LLGL_SIMD_NEON
+
+    if (cpuFeatures.neon)
+        return DecompressFloat16ArrayNEON(src, dst, count);
+
+    #endif
+
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = DecompressFloat16Scalar(src[i]);
 }
 
 
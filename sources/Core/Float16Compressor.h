@@ -10,19 +10,45 @@
 
 
 #include <LLGL/Export.h>
+#include "CPUFeatures.h"
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
-// Compresses the specified 32-bit float into a 16-bit float (represented as 16-bit unsigned integer).
+// Compresses the specified 32-bit float into a 16-bit float (represented as 16-bit unsigned integer) with round-to-nearest-even.
 LLGL_EXPORT std::uint16_t CompressFloat16(float value);
 
 // Decompresses the specified 16-bit float (represented as 16-bit unsigned integer) into a 32-bit float.
 LLGL_EXPORT float DecompressFloat16(std::uint16_t value);
 
+/*
+Compresses the specified array of 32-bit floats into 16-bit floats.
+The conversion uses F16C or AVX-512 if available, and SSE2 or NEON otherwise.
+The results are identical to CompressFloat16 on all code paths.
+*/
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count);
+
+/*
+Decompresses the specified array of 16-bit floats into 32-bit floats.
+The conversion uses F16C or AVX-512 if available, and SSE2 or NEON otherwise.
+The results are identical to DecompressFloat16 on all code paths.
+*/
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count);
+
+/*
+Compresses the specified array of 32-bit floats into 16-bit floats, but only selects the code paths of the specified CPU features.
+This allows to verify each code path against the scalar conversion regardless of the host CPU.
+Without any CPU features, the scalar conversion is used.
+*/
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count, const CPUFeatures& cpuFeatures);
+
+// Decompresses the specified array of 16-bit floats into 32-bit floats, but only selects the code paths of the specified CPU features.
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count, const CPUFeatures& cpuFeatures);
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,41 @@
+/*
+ * HashUtils.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_HASH_UTILS_H
+#define LLGL_HASH_UTILS_H
+
+
+#include <cstddef>
+#include <functional>
+
+
+namespace LLGL
+{
+
+namespace Utils
+{
+
+
+// Combines the hash value of 'value' with the specified seed (same formula as boost::hash_combine).
+// Values that compare equal (such as +0.0f and -0.0f) must result in the same hash value, which is guaranteed by std::hash.
+template <typename T>
+void HashCombine(std::size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+
+} // /namespace Utils
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
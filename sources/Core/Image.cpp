@@ -7,6 +7,8 @@
 
 #include <LLGL/Image.h>
 #include "ImageUtils.h"
+#include "ImageResampling.h"
+#include "BlockCompression.h"
 #include <algorithm>
 #include <string.h>
 
@@ -77,12 +79,17 @@ Image& Image::operator = (Image&& rhs)
 
 /* ----- Storage ----- */
 
-void Image::Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount)
+static std::size_t GetRequiredImageDataSize(const Extent3D& extent, const ImageFormat format, const DataType dataType)
+{
+    return static_cast<std::size_t>(ImageFormatSize(format) * DataTypeSize(dataType) * extent.width * extent.height * extent.depth);
+}
+
+void Image::Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount, long flags)
 {
     /* Convert image buffer (if necessary) */
     if (data_)
     {
-        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, threadCount))
+        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, GetExtent(), threadCount, flags))
             data_ = std::move(convertedData);
     }
 
@@ -150,7 +157,40 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
 
 void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
 {
-    //todo
+    Resize(extent, (filter == SamplerFilter::Nearest ? ResizeFilter::Nearest : ResizeFilter::Linear));
+}
+
+void Image::Resize(const Extent3D& extent, const ResizeFilter filter, std::size_t threadCount)
+{
+    if (extent != GetExtent())
+    {
+        if (data_ && GetNumPixels() > 0 && extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            /* Resample previous image buffer into new image buffer */
+            const auto prevExtent = GetExtent();
+            const auto srcDesc = GetSrcDesc();
+
+            auto data = GenerateEmptyByteBuffer(GetRequiredImageDataSize(extent, GetFormat(), GetDataType()), false);
+
+            const DstImageDescriptor dstDesc
+            {
+                GetFormat(),
+                GetDataType(),
+                data.get(),
+                GetRequiredImageDataSize(extent, GetFormat(), GetDataType())
+            };
+
+            ResampleImageBuffer(srcDesc, prevExtent, dstDesc, extent, filter, threadCount);
+
+            extent_ = extent;
+            data_   = std::move(data);
+        }
+        else
+        {
+            /* Nothing to resample */
+            Resize(extent);
+        }
+    }
 }
 
 void Image::Swap(Image& rhs)
@@ -290,11 +330,6 @@ void Image::Fill(Offset3D offset, Extent3D extent, const ColorRGBAd& fillColor)
     //TODO
 }
 
-static std::size_t GetRequiredImageDataSize(const Extent3D& extent, const ImageFormat format, const DataType dataType)
-{
-    return static_cast<std::size_t>(ImageFormatSize(format) * DataTypeSize(dataType) * extent.width * extent.height * extent.depth);
-}
-
 static void ValidateImageDataSize(const Extent3D& extent, const DstImageDescriptor& imageDesc)
 {
     const auto requiredDataSize = GetRequiredImageDataSize(extent, imageDesc.format, imageDesc.dataType);
@@ -460,17 +495,24 @@ std::uint32_t Image::GetBytesPerPixel() const
 
 std::uint32_t Image::GetRowStride() const
 {
-    return (GetBytesPerPixel() * GetExtent().width);
+    /* Compressed images are stored in rows of 4x4 blocks */
+    if (IsCompressedFormat(GetFormat()))
+        return (GetCompressedBlockSize(GetFormat()) * ((GetExtent().width + 3) / 4));
+    else
+        return (GetBytesPerPixel() * GetExtent().width);
 }
 
 std::uint32_t Image::GetDepthStride() const
 {
-    return (GetRowStride() * GetExtent().height);
+    if (IsCompressedFormat(GetFormat()))
+        return (GetRowStride() * ((GetExtent().height + 3) / 4));
+    else
+        return (GetRowStride() * GetExtent().height);
 }
 
 std::uint32_t Image::GetDataSize() const
 {
-    return (GetNumPixels() * GetBytesPerPixel());
+    return (GetDepthStride() * GetExtent().depth);
 }
 
 std::uint32_t Image::GetNumPixels() const
@@ -16,6 +16,11 @@
 #include "../Core/Helper.h"
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "DataTypeKernels.h"
+#include "ThreadPool.h"
+#include "ImageResampling.h"
+#include "BlockCompression.h"
+#include "ColorSpaceSRGB.h"
 
 
 namespace LLGL
@@ -86,52 +91,6 @@ using VariantColor = ColorRGBAT<Variant>;
 
 /* ----- Internal functions ----- */
 
-// Reads the specified source variant and returns it to the normalized range [0, 1].
-template <typename T>
-double ReadNormalizedVariant(const T& src)
-{
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    return (static_cast<double>(src) - min) / (max - min);
-}
-
-// Writes the specified value from the range [0, 1] to the destination variant.
-template <typename T>
-void WriteNormalizedVariant(T& dst, double value)
-{
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    dst = static_cast<T>(value * (max - min) + min);
-}
-
-static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantConstBuffer& srcBuffer, std::size_t idx)
-{
-    switch (srcDataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            return ReadNormalizedVariant(srcBuffer.int8[idx]);
-        case DataType::UInt8:
-            return ReadNormalizedVariant(srcBuffer.uint8[idx]);
-        case DataType::Int16:
-            return ReadNormalizedVariant(srcBuffer.int16[idx]);
-        case DataType::UInt16:
-            return ReadNormalizedVariant(srcBuffer.uint16[idx]);
-        case DataType::Int32:
-            return ReadNormalizedVariant(srcBuffer.int32[idx]);
-        case DataType::UInt32:
-            return ReadNormalizedVariant(srcBuffer.uint32[idx]);
-        case DataType::Float16:
-            return static_cast<double>(DecompressFloat16(srcBuffer.uint16[idx]));
-        case DataType::Float32:
-            return static_cast<double>(srcBuffer.real32[idx]);
-        case DataType::Float64:
-            return srcBuffer.real64[idx];
-    }
-    return 0.0;
-}
-
 static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dstBuffer, std::size_t idx, double value)
 {
     switch (dstDataType)
@@ -168,27 +127,8 @@ static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dst
     }
 }
 
-// Worker thread procedure for the "ConvertImageBufferDataType" function
-static void ConvertImageBufferDataTypeWorker(
-    DataType                    srcDataType,
-    const VariantConstBuffer&   srcBuffer,
-    DataType                    dstDataType,
-    VariantBuffer&              dstBuffer,
-    std::size_t                 idxBegin,
-    std::size_t                 idxEnd)
-{
-    for (auto i = idxBegin; i < idxEnd; ++i)
-    {
-        /* Read normalized variant from source buffer */
-        double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
-
-        /* Write normalized variant to destination buffer */
-        WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
-    }
-}
-
 // Minimal number of entries each worker thread shall process
-static const std::size_t g_threadMinWorkSize = 64;
+static const std::size_t g_threadMinWorkSize = 4096;
 
 static void ConvertImageBufferDataType(
     DataType    srcDataType,
@@ -206,49 +146,20 @@ static void ConvertImageBufferDataType(
     if (dstBufferSize != requiredDstBufferSize)
         throw std::invalid_argument("cannot convert image data type with destination buffer size mismatch");
 
-    /* Get variant buffer for source and destination images */
-    VariantConstBuffer src { srcBuffer };
-    VariantBuffer dst { dstBuffer };
+    /* Every pair of defined data types has a specialized kernel */
+    auto kernel = GetDataTypeKernel(srcDataType, dstDataType);
+    if (!kernel)
+        throw std::invalid_argument("cannot convert image data type from or to undefined data type");
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
+    GetGlobalThreadPool().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [kernel, srcBuffer, dstBuffer](std::size_t idxBegin, std::size_t idxEnd)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType,
-                std::ref(src),
-                dstDataType,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
+            kernel(srcBuffer, dstBuffer, idxBegin, idxEnd);
         }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
-    }
+    );
 }
 
 static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
@@ -481,35 +392,11 @@ static void ConvertImageBufferFormat(
     VariantConstBuffer src { srcImageDesc.data };
     VariantBuffer dst { dstImageDesc.data };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                std::ref(src),
-                dstImageDesc.format,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
+    GetGlobalThreadPool().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
             ConvertImageBufferFormatWorker(
                 srcImageDesc.format,
@@ -517,30 +404,186 @@ static void ConvertImageBufferFormat(
                 src,
                 dstImageDesc.format,
                 dst,
-                offset,
-                offset + workSizeRemain
+                idxBegin,
+                idxEnd
             );
         }
+    );
+}
 
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
+// Size (in bytes) of the intermediate tile buffer for each worker thread; small enough to stay in the L1/L2 cache
+static const std::size_t g_fusedTileSize = 16384;
+
+// Worker thread procedure for the "ConvertImageBufferFormatAndDataType" function
+static void ConvertImageBufferFormatAndDataTypeWorker(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    DataTypeKernel              kernel,
+    std::size_t                 idxBegin,
+    std::size_t                 idxEnd)
+{
+    /* Get image parameters */
+    const auto srcFormatSize    = ImageFormatSize(srcImageDesc.format);
+    const auto dstFormatSize    = ImageFormatSize(dstImageDesc.format);
+    const auto srcPixelSize     = srcFormatSize * DataTypeSize(srcImageDesc.dataType);
+    const auto dstPixelSize     = dstFormatSize * DataTypeSize(dstImageDesc.dataType);
+    const auto tilePixelSize    = srcFormatSize * DataTypeSize(dstImageDesc.dataType);
+    const auto tileNumPixels    = std::max<std::size_t>(1, g_fusedTileSize / tilePixelSize);
+
+    /* Allocate tile buffer that holds the source pixels with the destination data type */
+    auto tileBuffer = MakeUniqueArray<char>(tileNumPixels * tilePixelSize);
+
+    auto src = reinterpret_cast<const char*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<char*>(dstImageDesc.data);
+
+    for (auto idx = idxBegin; idx < idxEnd; idx += tileNumPixels)
+    {
+        const auto numPixels        = std::min(tileNumPixels, idxEnd - idx);
+        const auto numComponents    = numPixels * srcFormatSize;
+
+        /* Convert data type of current tile */
+        const void* srcTile = src + idx * srcPixelSize;
+
+        kernel(srcTile, tileBuffer.get(), 0, numComponents);
+
+        /* Convert format of current tile directly into the destination buffer */
+        VariantConstBuffer srcTileBuffer { tileBuffer.get() };
+        VariantBuffer dstTileBuffer { dst + idx * dstPixelSize };
+        ConvertImageBufferFormatWorker(srcImageDesc.format, dstImageDesc.dataType, srcTileBuffer, dstImageDesc.format, dstTileBuffer, 0, numPixels);
     }
-    else
+}
+
+/*
+Converts format and data type in a single pass over the source image.
+Each worker converts the data type of a small tile of pixels and then writes the reformatted pixels directly into the destination,
+so the extra memory is only one tile per thread instead of a full intermediate image.
+*/
+static void ConvertImageBufferFormatAndDataType(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount)
+{
+    /* Validate destination buffer size */
+    auto imageSize              = srcImageDesc.dataSize / (ImageFormatSize(srcImageDesc.format) * DataTypeSize(srcImageDesc.dataType));
+    auto requiredDstBufferSize  = imageSize * ImageFormatSize(dstImageDesc.format) * DataTypeSize(dstImageDesc.dataType);
+
+    if (dstImageDesc.dataSize != requiredDstBufferSize)
+        throw std::invalid_argument("cannot convert image format with destination buffer size mismatch");
+
+    auto kernel = GetDataTypeKernel(srcImageDesc.dataType, dstImageDesc.dataType);
+    if (!kernel)
+        throw std::invalid_argument("cannot convert image data type from or to undefined data type");
+
+    GetGlobalThreadPool().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            ConvertImageBufferFormatAndDataTypeWorker(srcImageDesc, dstImageDesc, kernel, idxBegin, idxEnd);
+        }
+    );
+}
+
+// Conversion flags that require the color space conversion
+static const long g_colorSpaceConversionFlags = (ImageConversionFlags::DecodeSRGB | ImageConversionFlags::EncodeSRGB);
+
+// Worker thread procedure for the "ConvertImageBufferColorSpace" function
+static void ConvertImageBufferColorSpaceWorker(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    long                        flags,
+    std::size_t                 idxBegin,
+    std::size_t                 idxEnd)
+{
+    const bool decodeSRGB = ((flags & ImageConversionFlags::DecodeSRGB) != 0);
+    const bool encodeSRGB = ((flags & ImageConversionFlags::EncodeSRGB) != 0);
+
+    /* Get image parameters */
+    const auto srcFormatSize    = ImageFormatSize(srcImageDesc.format);
+    const auto dstFormatSize    = ImageFormatSize(dstImageDesc.format);
+    const auto srcPixelSize     = srcFormatSize * DataTypeSize(srcImageDesc.dataType);
+    const auto dstPixelSize     = dstFormatSize * DataTypeSize(dstImageDesc.dataType);
+    const auto tileNumPixels    = std::max<std::size_t>(1, g_fusedTileSize / (std::max(srcFormatSize, dstFormatSize) * sizeof(float)));
+
+    /* Allocate tile buffers that hold the pixels in linear color space with single precision */
+    auto linearTile     = MakeUniqueArray<float>(tileNumPixels * srcFormatSize);
+    auto formattedTile  = (srcImageDesc.format != dstImageDesc.format ? MakeUniqueArray<float>(tileNumPixels * dstFormatSize) : nullptr);
+
+    const auto srcKernel = GetDataTypeKernel(srcImageDesc.dataType, DataType::Float32);
+    const auto dstKernel = GetDataTypeKernel(DataType::Float32, dstImageDesc.dataType);
+
+    auto src = reinterpret_cast<const char*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<char*>(dstImageDesc.data);
+
+    for (auto idx = idxBegin; idx < idxEnd; idx += tileNumPixels)
     {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(
-            srcImageDesc.format,
-            srcImageDesc.dataType,
-            src,
-            dstImageDesc.format,
-            dst,
-            0,
-            imageSize
-        );
+        const auto numPixels = std::min(tileNumPixels, idxEnd - idx);
+
+        const void* srcTile = src + idx * srcPixelSize;
+        void*       dstTile = dst + idx * dstPixelSize;
+
+        /* Read current tile in linear color space */
+        if (decodeSRGB && srcImageDesc.dataType == DataType::UInt8)
+            DecodeSRGB8(reinterpret_cast<const std::uint8_t*>(srcTile), linearTile.get(), numPixels, srcImageDesc.format);
+        else
+        {
+            srcKernel(srcTile, linearTile.get(), 0, numPixels * srcFormatSize);
+            if (decodeSRGB)
+                ConvertColorSpaceSRGB(linearTile.get(), numPixels, srcImageDesc.format, true);
+        }
+
+        /* Convert format of current tile */
+        float* tile = linearTile.get();
+
+        if (formattedTile)
+        {
+            VariantConstBuffer srcTileBuffer { linearTile.get() };
+            VariantBuffer dstTileBuffer { formattedTile.get() };
+            ConvertImageBufferFormatWorker(srcImageDesc.format, DataType::Float32, srcTileBuffer, dstImageDesc.format, dstTileBuffer, 0, numPixels);
+            tile = formattedTile.get();
+        }
+
+        /* Write current tile into the destination buffer (in sRGB color space) */
+        if (encodeSRGB && dstImageDesc.dataType == DataType::UInt8)
+            EncodeSRGB8(tile, reinterpret_cast<std::uint8_t*>(dstTile), numPixels, dstImageDesc.format);
+        else
+        {
+            if (encodeSRGB)
+                ConvertColorSpaceSRGB(tile, numPixels, dstImageDesc.format, false);
+            dstKernel(tile, dstTile, 0, numPixels * dstFormatSize);
+        }
     }
 }
 
+/*
+Converts format, data type, and color space in a single pass over the source image.
+The tiles are converted in single precision, where 8-bit sRGB components are decoded with a lookup table and encoded with a vectorized approximation.
+*/
+static void ConvertImageBufferColorSpace(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    long                        flags,
+    std::size_t                 threadCount)
+{
+    /* Validate destination buffer size */
+    auto imageSize              = srcImageDesc.dataSize / (ImageFormatSize(srcImageDesc.format) * DataTypeSize(srcImageDesc.dataType));
+    auto requiredDstBufferSize  = imageSize * ImageFormatSize(dstImageDesc.format) * DataTypeSize(dstImageDesc.dataType);
+
+    if (dstImageDesc.dataSize != requiredDstBufferSize)
+        throw std::invalid_argument("cannot convert image color space with destination buffer size mismatch");
+
+    GetGlobalThreadPool().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            ConvertImageBufferColorSpaceWorker(srcImageDesc, dstImageDesc, flags, idxBegin, idxEnd);
+        }
+    );
+}
+
 static void ValidateSourceImageDesc(const SrcImageDescriptor& imageDesc)
 {
     LLGL_ASSERT_PTR(imageDesc.data);
@@ -572,7 +615,8 @@ static void ValidateImageConversionParams(
 LLGL_EXPORT bool ConvertImageBuffer(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
-    std::size_t                 threadCount)
+    std::size_t                 threadCount,
+    long                        flags)
 {
     /* Validate input parameters */
     ValidateSourceImageDesc(srcImageDesc);
@@ -582,34 +626,16 @@ LLGL_EXPORT bool ConvertImageBuffer(
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
 
-    if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
+    if ((flags & g_colorSpaceConversionFlags) != 0)
     {
-        /* Convert image data type with intermediate buffer */
-        auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstImageDesc.dataType);
-        auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-        ConvertImageBufferDataType(
-            srcImageDesc.dataType,
-            srcImageDesc.data,
-            srcImageDesc.dataSize,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize,
-            threadCount
-        );
-
-        /* Set new source buffer and source data type */
-        const SrcImageDescriptor intermediateImageDesc
-        {
-            srcImageDesc.format,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize
-        };
-
-        /* Convert image format */
-        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
-
+        /* Convert image color space (and format and data type) in a single pass */
+        ConvertImageBufferColorSpace(srcImageDesc, dstImageDesc, flags, threadCount);
+        return true;
+    }
+    else if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
+    {
+        /* Convert image data type and format in a single pass */
+        ConvertImageBufferFormatAndDataType(srcImageDesc, dstImageDesc, threadCount);
         return true;
     }
     else if (srcImageDesc.dataType != dstImageDesc.dataType)
@@ -640,7 +666,8 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     const SrcImageDescriptor&   srcImageDesc,
     ImageFormat                 dstFormat,
     DataType                    dstDataType,
-    std::size_t                 threadCount)
+    std::size_t                 threadCount,
+    long                        flags)
 {
     /* Validate input parameters */
     ValidateSourceImageDesc(srcImageDesc);
@@ -660,36 +687,23 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
         srcNumPixels * DataTypeSize(dstDataType) * ImageFormatSize(dstFormat)
     };
 
-    if (srcImageDesc.dataType != dstDataType && srcImageDesc.format != dstFormat)
+    if ((flags & g_colorSpaceConversionFlags) != 0)
     {
+        /* Convert image color space (and format and data type) in a single pass */
         auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
         {
-            /* Convert image data type with intermediate buffer */
-            auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstDataType);
-            auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-            ConvertImageBufferDataType(
-                srcImageDesc.dataType,
-                srcImageDesc.data,
-                srcImageDesc.dataSize,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize,
-                threadCount
-            );
-
-            /* Set new source buffer and source data type */
-            const SrcImageDescriptor intermediateImageDesc
-            {
-                srcImageDesc.format,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize
-            };
-
-            /* Convert image format */
             dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
+            ConvertImageBufferColorSpace(srcImageDesc, dstImageDesc, flags, threadCount);
+        }
+        return dstImage;
+    }
+    else if (srcImageDesc.dataType != dstDataType && srcImageDesc.format != dstFormat)
+    {
+        /* Convert image data type and format in a single pass */
+        auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
+        {
+            dstImageDesc.data = dstImage.get();
+            ConvertImageBufferFormatAndDataType(srcImageDesc, dstImageDesc, threadCount);
         }
         return dstImage;
     }
@@ -725,6 +739,134 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     return nullptr;
 }
 
+static void ValidateCompressedImageDataType(ImageFormat format, DataType dataType)
+{
+    if (format == ImageFormat::BC4 || format == ImageFormat::BC5)
+    {
+        if (dataType != DataType::UInt8 && dataType != DataType::Int8)
+            throw std::invalid_argument("BC4 and BC5 compressed images must have data type UInt8 or Int8");
+    }
+    else if (dataType != DataType::UInt8)
+        throw std::invalid_argument("BC1, BC2, and BC3 compressed images must have data type UInt8");
+}
+
+// Returns the size (in bytes) of an image with the specified attributes, including compressed images.
+static std::size_t GetImageDataSize(ImageFormat format, DataType dataType, const Extent3D& extent)
+{
+    if (IsCompressedFormat(format))
+        return GetCompressedImageDataSize(format, extent);
+    else
+        return (static_cast<std::size_t>(GetMemoryFootprint(format, dataType, 1)) * extent.width * extent.height * extent.depth);
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount,
+    long                        flags)
+{
+    /* Use regular conversion if no compressed image is involved */
+    if (!IsCompressedFormat(srcImageDesc.format) && !IsCompressedFormat(dstImageDesc.format))
+        return ConvertImageBuffer(srcImageDesc, dstImageDesc, threadCount, flags);
+
+    /* Validate input parameters */
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+
+    if (IsDepthStencilFormat(srcImageDesc.format) || IsDepthStencilFormat(dstImageDesc.format))
+        throw std::invalid_argument("cannot convert depth-stencil image formats");
+    if (IsCompressedFormat(srcImageDesc.format))
+        ValidateCompressedImageDataType(srcImageDesc.format, srcImageDesc.dataType);
+    if (IsCompressedFormat(dstImageDesc.format))
+        ValidateCompressedImageDataType(dstImageDesc.format, dstImageDesc.dataType);
+
+    const auto srcDataSize = GetImageDataSize(srcImageDesc.format, srcImageDesc.dataType, extent);
+    const auto dstDataSize = GetImageDataSize(dstImageDesc.format, dstImageDesc.dataType, extent);
+
+    if (srcImageDesc.dataSize < srcDataSize)
+        throw std::invalid_argument("source image data size is too small for the specified extent");
+    if (dstImageDesc.dataSize < dstDataSize)
+        throw std::invalid_argument("destination image data size is too small for the specified extent");
+
+    const bool isSameFormat = (srcImageDesc.format == dstImageDesc.format && srcImageDesc.dataType == dstImageDesc.dataType);
+
+    if ((isSameFormat && (flags & g_colorSpaceConversionFlags) == 0) || srcDataSize == 0)
+        return false;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Decode source image into 8-bit components */
+    SrcImageDescriptor decodedSrcDesc{ srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, srcDataSize };
+    ByteBuffer decodedSrc;
+
+    if (IsCompressedFormat(srcImageDesc.format))
+    {
+        decodedSrcDesc.format   = GetDecompressedImageFormat(srcImageDesc.format);
+        decodedSrcDesc.dataSize = GetImageDataSize(decodedSrcDesc.format, decodedSrcDesc.dataType, extent);
+        decodedSrc              = GenerateEmptyByteBuffer(decodedSrcDesc.dataSize, false);
+        decodedSrcDesc.data     = decodedSrc.get();
+
+        const bool isSigned = (srcImageDesc.dataType == DataType::Int8);
+        DecodeBlockCompressedImage(srcImageDesc.format, isSigned, srcImageDesc.data, decodedSrc.get(), extent, threadCount);
+    }
+
+    if (IsCompressedFormat(dstImageDesc.format))
+    {
+        /* Convert source image into the 8-bit components the encoder expects, then encode it */
+        auto encoderSrc = ConvertImageBuffer(decodedSrcDesc, GetDecompressedImageFormat(dstImageDesc.format), dstImageDesc.dataType, threadCount, flags);
+
+        const bool isSigned     = (dstImageDesc.dataType == DataType::Int8);
+        const bool highQuality  = ((flags & ImageConversionFlags::HighQualityCompression) != 0);
+
+        EncodeBlockCompressedImage(
+            dstImageDesc.format,
+            isSigned,
+            (encoderSrc ? encoderSrc.get() : decodedSrcDesc.data),
+            dstImageDesc.data,
+            extent,
+            highQuality,
+            threadCount
+        );
+    }
+    else
+    {
+        /* Convert decoded image into destination format */
+        const DstImageDescriptor uncompressedDstDesc{ dstImageDesc.format, dstImageDesc.dataType, dstImageDesc.data, dstDataSize };
+        if (!ConvertImageBuffer(decodedSrcDesc, uncompressedDstDesc, threadCount, flags))
+            ::memcpy(dstImageDesc.data, decodedSrcDesc.data, dstDataSize);
+    }
+
+    return true;
+}
+
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    const Extent3D&             extent,
+    std::size_t                 threadCount,
+    long                        flags)
+{
+    /* Use regular conversion if no compressed image is involved */
+    if (!IsCompressedFormat(srcImageDesc.format) && !IsCompressedFormat(dstFormat))
+        return ConvertImageBuffer(srcImageDesc, dstFormat, dstDataType, threadCount, flags);
+
+    if (srcImageDesc.format == dstFormat && srcImageDesc.dataType == dstDataType && (flags & g_colorSpaceConversionFlags) == 0)
+        return nullptr;
+
+    /* Allocate destination image buffer and convert image into it */
+    DstImageDescriptor dstImageDesc{ dstFormat, dstDataType, nullptr, GetImageDataSize(dstFormat, dstDataType, extent) };
+
+    auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
+    {
+        dstImageDesc.data = dstImage.get();
+        ConvertImageBuffer(srcImageDesc, dstImageDesc, extent, threadCount, flags);
+    }
+    return dstImage;
+}
+
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
 static std::size_t GetFlattenedImageBufferPos(
     std::uint32_t x,
@@ -847,6 +989,88 @@ LLGL_EXPORT ByteBuffer GenerateEmptyByteBuffer(std::size_t bufferSize, bool init
 }
 
 
+// Returns the extent of the specified MIP-map level (excluding array layers), which is halved for each dimension of the texture type.
+static Extent3D GetMipChainExtent(const TextureDescriptor& textureDesc, std::uint32_t mipLevel)
+{
+    const auto numDims  = NumTextureDimensions(textureDesc.type);
+    const auto& extent  = textureDesc.extent;
+    return Extent3D
+    {
+        std::max(1u, extent.width >> mipLevel),
+        (numDims >= 2 ? std::max(1u, extent.height >> mipLevel) : 1u),
+        (numDims >= 3 ? std::max(1u, extent.depth  >> mipLevel) : 1u)
+    };
+}
+
+LLGL_EXPORT std::vector<MipChainSubresource> GetMipChainSubresources(
+    const TextureDescriptor&    textureDesc,
+    ImageFormat                 format,
+    DataType                    dataType)
+{
+    const auto numMipLevels = NumMipLevels(textureDesc);
+    const auto numLayers    = (IsArrayTexture(textureDesc.type) || IsCubeTexture(textureDesc.type) ? textureDesc.arrayLayers : 1u);
+    const auto bpp          = static_cast<std::size_t>(ImageFormatSize(format)) * DataTypeSize(dataType);
+
+    std::vector<MipChainSubresource> subresources(numMipLevels);
+
+    std::size_t offset = 0;
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        auto& subresource = subresources[mipLevel];
+        {
+            subresource.extent          = GetMipChainExtent(textureDesc, mipLevel);
+            subresource.numArrayLayers  = numLayers;
+            subresource.offset          = offset;
+            subresource.dataSize        = bpp * subresource.extent.width * subresource.extent.height * subresource.extent.depth * numLayers;
+        }
+        offset += subresource.dataSize;
+    }
+
+    return subresources;
+}
+
+LLGL_EXPORT ByteBuffer GenerateMipChain(
+    const TextureDescriptor&            textureDesc,
+    const SrcImageDescriptor&           srcImageDesc,
+    std::vector<MipChainSubresource>&   subresources,
+    std::size_t                         threadCount)
+{
+    /* Validate input parameters */
+    ValidateSourceImageDesc(srcImageDesc);
+
+    if (IsCompressedFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot generate MIP-map chain for compressed image formats");
+    if (IsDepthStencilFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot generate MIP-map chain for depth-stencil image formats");
+
+    subresources = GetMipChainSubresources(textureDesc, srcImageDesc.format, srcImageDesc.dataType);
+    if (subresources.empty())
+        return nullptr;
+
+    const auto& baseLevel = subresources.front();
+    if (srcImageDesc.dataSize < baseLevel.dataSize)
+        throw std::invalid_argument("source image data size is too small for the first MIP-map level");
+
+    /* Allocate buffer for the entire MIP-map chain and copy first MIP-map level */
+    const auto& lastLevel = subresources.back();
+    auto mipChain = GenerateEmptyByteBuffer(lastLevel.offset + lastLevel.dataSize, false);
+
+    ::memcpy(mipChain.get(), srcImageDesc.data, baseLevel.dataSize);
+
+    /* Generate all other MIP-map levels */
+    const bool sRGB = ((GetFormatAttribs(textureDesc.format).flags & FormatFlags::IsColorSpace_sRGB) != 0);
+
+    GenerateMipChainLevels(
+        SrcImageDescriptor{ srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, baseLevel.dataSize },
+        subresources,
+        mipChain.get(),
+        sRGB,
+        threadCount
+    );
+
+    return mipChain;
+}
+
 } // /namespace LLGL
 
 
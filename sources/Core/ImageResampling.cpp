@@ -0,0 +1,675 @@
+/*
+ * ImageResampling.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageResampling.h"
+#include "ColorSpaceSRGB.h"
+#include "DataTypeKernels.h"
+#include "ThreadPool.h"
+#include "Helper.h"
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/* ----- Filter functions ----- */
+
+static const double g_pi = 3.14159265358979323846;
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= g_pi;
+    return std::sin(x) / x;
+}
+
+// Returns the modified Bessel function of the first kind of order zero (power series).
+static double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0, halfX = x * 0.5;
+    for (int k = 1; k < 32 && term > sum * 1.0e-16; ++k)
+    {
+        const double t = halfX / k;
+        term *= t * t;
+        sum += term;
+    }
+    return sum;
+}
+
+static double BoxFilter(double x)
+{
+    return (x >= -0.5 && x < 0.5 ? 1.0 : 0.0);
+}
+
+static double TentFilter(double x)
+{
+    x = std::abs(x);
+    return (x < 1.0 ? 1.0 - x : 0.0);
+}
+
+static double LanczosFilter(double x)
+{
+    x = std::abs(x);
+    return (x < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0);
+}
+
+static double KaiserFilter(double x)
+{
+    const double radius = 3.0, beta = 4.0;
+    x = std::abs(x);
+    if (x >= radius)
+        return 0.0;
+    const double t = x / radius;
+    return Sinc(x) * BesselI0(beta * std::sqrt(1.0 - t*t)) / BesselI0(beta);
+}
+
+struct FilterDescriptor
+{
+    double (*func)(double);
+    double support;
+};
+
+static FilterDescriptor GetFilterDesc(ResizeFilter filter)
+{
+    switch (filter)
+    {
+        case ResizeFilter::Box:     return { BoxFilter,     0.5 };
+        case ResizeFilter::Lanczos: return { LanczosFilter, 3.0 };
+        case ResizeFilter::Kaiser:  return { KaiserFilter,  3.0 };
+        default:                    return { TentFilter,    1.0 };
+    }
+}
+
+
+/* ----- Axis filter ----- */
+
+// Contiguous range of source taps for a single destination coordinate.
+struct FilterContrib
+{
+    std::size_t first;  // Index of the first source tap
+    std::size_t count;  // Number of source taps
+    std::size_t offset; // Offset into the weight array
+};
+
+template <typename T>
+struct AxisFilter
+{
+    std::vector<FilterContrib>  contribs;
+    std::vector<T>              weights;
+};
+
+// Builds the normalized filter weights to resample one dimension from 'srcSize' to 'dstSize' (edges are clamped).
+template <typename T>
+void BuildAxisFilter(AxisFilter<T>& axis, std::uint32_t srcSize, std::uint32_t dstSize, const FilterDescriptor& filterDesc)
+{
+    const double scale          = static_cast<double>(dstSize) / static_cast<double>(srcSize);
+    const double filterScale    = std::max(1.0, 1.0 / scale);
+    const double radius         = filterDesc.support * filterScale;
+    const auto   lastIdx        = static_cast<long>(srcSize) - 1;
+
+    std::vector<double> tmp;
+
+    axis.contribs.resize(dstSize);
+    axis.weights.clear();
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        const double center = (static_cast<double>(i) + 0.5) / scale;
+        const auto   left   = static_cast<long>(std::floor(center - radius - 0.5));
+        const auto   right  = static_cast<long>(std::ceil(center + radius - 0.5));
+        const auto   first  = Clamp(left, 0l, lastIdx);
+        const auto   last   = Clamp(right, 0l, lastIdx);
+
+        /* Accumulate weights and fold taps outside the image into the edge taps */
+        tmp.assign(static_cast<std::size_t>(last - first + 1), 0.0);
+        double sum = 0.0;
+
+        for (auto j = left; j <= right; ++j)
+        {
+            const double w = filterDesc.func((static_cast<double>(j) + 0.5 - center) / filterScale);
+            tmp[static_cast<std::size_t>(Clamp(j, first, last) - first)] += w;
+            sum += w;
+        }
+
+        if (sum == 0.0)
+        {
+            /* Fall back to nearest sample */
+            std::fill(tmp.begin(), tmp.end(), 0.0);
+            tmp[static_cast<std::size_t>(Clamp(static_cast<long>(center), first, last) - first)] = 1.0;
+            sum = 1.0;
+        }
+
+        /* Trim zero weights at both ends */
+        std::size_t begin = 0, end = tmp.size();
+        while (begin + 1 < end && tmp[begin] == 0.0)
+            ++begin;
+        while (end - 1 > begin && tmp[end - 1] == 0.0)
+            --end;
+
+        auto& contrib = axis.contribs[i];
+        {
+            contrib.first   = static_cast<std::size_t>(first) + begin;
+            contrib.count   = end - begin;
+            contrib.offset  = axis.weights.size();
+        }
+
+        for (auto k = begin; k < end; ++k)
+            axis.weights.push_back(static_cast<T>(tmp[k] / sum));
+    }
+}
+
+
+/* ----- Filter passes ----- */
+
+// Minimal number of components each worker thread shall process
+static const std::size_t g_threadMinWorkSize = 4096;
+
+static std::size_t GetMinRowsPerChunk(std::size_t rowSize)
+{
+    return std::max<std::size_t>(1, g_threadMinWorkSize / std::max<std::size_t>(1, rowSize));
+}
+
+// Resamples all rows along the X axis; the component count is a template parameter so the inner loops get unrolled.
+template <typename T, std::size_t NumComponents>
+void ResampleRowsX(
+    const T*                src,
+    T*                      dst,
+    std::size_t             srcWidth,
+    std::size_t             dstWidth,
+    std::size_t             numRows,
+    const AxisFilter<T>&    axis,
+    std::size_t             threadCount)
+{
+    GetGlobalThreadPool().ParallelFor(
+        numRows,
+        GetMinRowsPerChunk(dstWidth * NumComponents),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const T* srcRow = src + row * srcWidth * NumComponents;
+                T*       dstRow = dst + row * dstWidth * NumComponents;
+
+                for (std::size_t x = 0; x < dstWidth; ++x)
+                {
+                    const auto& contrib = axis.contribs[x];
+                    const T*    weights = axis.weights.data() + contrib.offset;
+                    const T*    srcPx   = srcRow + contrib.first * NumComponents;
+
+                    T acc[NumComponents] = {};
+                    for (std::size_t k = 0; k < contrib.count; ++k)
+                    {
+                        for (std::size_t c = 0; c < NumComponents; ++c)
+                            acc[c] += weights[k] * srcPx[k * NumComponents + c];
+                    }
+
+                    for (std::size_t c = 0; c < NumComponents; ++c)
+                        dstRow[x * NumComponents + c] = acc[c];
+                }
+            }
+        }
+    );
+}
+
+template <typename T>
+void ResampleX(
+    const T*                src,
+    T*                      dst,
+    std::size_t             srcWidth,
+    std::size_t             dstWidth,
+    std::size_t             numRows,
+    std::size_t             numComponents,
+    const AxisFilter<T>&    axis,
+    std::size_t             threadCount)
+{
+    switch (numComponents)
+    {
+        case 1: ResampleRowsX<T, 1>(src, dst, srcWidth, dstWidth, numRows, axis, threadCount); break;
+        case 2: ResampleRowsX<T, 2>(src, dst, srcWidth, dstWidth, numRows, axis, threadCount); break;
+        case 3: ResampleRowsX<T, 3>(src, dst, srcWidth, dstWidth, numRows, axis, threadCount); break;
+        case 4: ResampleRowsX<T, 4>(src, dst, srcWidth, dstWidth, numRows, axis, threadCount); break;
+    }
+}
+
+/*
+Resamples along an outer axis (Y or Z): each destination row is a weighted sum of entire source rows.
+The inner loop runs over contiguous rows, so it is vectorized by the compiler.
+Row (outer, inner, taps) of the destination maps to source row ((outer * srcAxisSize + tap) * innerSize + inner).
+*/
+template <typename T>
+void ResampleOuterAxis(
+    const T*                src,
+    T*                      dst,
+    std::size_t             rowSize,
+    std::size_t             numOuter,
+    std::size_t             srcAxisSize,
+    std::size_t             dstAxisSize,
+    std::size_t             innerSize,
+    const AxisFilter<T>&    axis,
+    std::size_t             threadCount)
+{
+    GetGlobalThreadPool().ParallelFor(
+        numOuter * dstAxisSize * innerSize,
+        GetMinRowsPerChunk(rowSize),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto  inner   = row % innerSize;
+                const auto  dstIdx  = (row / innerSize) % dstAxisSize;
+                const auto  outer   = row / (innerSize * dstAxisSize);
+
+                const auto& contrib = axis.contribs[dstIdx];
+                const T*    weights = axis.weights.data() + contrib.offset;
+
+                T* dstRow = dst + row * rowSize;
+                std::fill(dstRow, dstRow + rowSize, T(0));
+
+                for (std::size_t k = 0; k < contrib.count; ++k)
+                {
+                    const T  w      = weights[k];
+                    const T* srcRow = src + ((outer * srcAxisSize + contrib.first + k) * innerSize + inner) * rowSize;
+                    for (std::size_t i = 0; i < rowSize; ++i)
+                        dstRow[i] += w * srcRow[i];
+                }
+            }
+        }
+    );
+}
+
+
+/* ----- Load and store ----- */
+
+// Stores the normalized values with rounding and clamping (the regular data type conversion truncates, and filters may overshoot).
+template <typename TInt, typename T>
+void StoreNormalizedRounded(const T* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    const auto min = static_cast<double>(std::numeric_limits<TInt>::min());
+    const auto max = static_cast<double>(std::numeric_limits<TInt>::max());
+
+    auto dstBuf = reinterpret_cast<TInt*>(dst);
+    for (auto i = idxBegin; i < idxEnd; ++i)
+    {
+        const auto value = Clamp(static_cast<double>(src[i]), 0.0, 1.0);
+        dstBuf[i] = static_cast<TInt>(std::floor(value * (max - min) + min + 0.5));
+    }
+}
+
+template <typename T>
+void StoreResampledBuffer(const T* src, DataType workDataType, const DstImageDescriptor& dstImageDesc, std::size_t count, std::size_t threadCount)
+{
+    auto dst = dstImageDesc.data;
+
+    GetGlobalThreadPool().ParallelFor(
+        count,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
+        {
+            switch (dstImageDesc.dataType)
+            {
+                case DataType::Int8:    StoreNormalizedRounded<std::int8_t   >(src, dst, idxBegin, idxEnd); break;
+                case DataType::UInt8:   StoreNormalizedRounded<std::uint8_t  >(src, dst, idxBegin, idxEnd); break;
+                case DataType::Int16:   StoreNormalizedRounded<std::int16_t  >(src, dst, idxBegin, idxEnd); break;
+                case DataType::UInt16:  StoreNormalizedRounded<std::uint16_t >(src, dst, idxBegin, idxEnd); break;
+                case DataType::Int32:   StoreNormalizedRounded<std::int32_t  >(src, dst, idxBegin, idxEnd); break;
+                case DataType::UInt32:  StoreNormalizedRounded<std::uint32_t >(src, dst, idxBegin, idxEnd); break;
+                default:
+                {
+                    /* Floating-point data is not clamped (e.g. for HDR images) */
+                    if (auto kernel = GetDataTypeKernel(workDataType, dstImageDesc.dataType))
+                        kernel(src, dst, idxBegin, idxEnd);
+                    else
+                        ::memcpy(reinterpret_cast<T*>(dst) + idxBegin, src + idxBegin, (idxEnd - idxBegin) * sizeof(T));
+                }
+                break;
+            }
+        }
+    );
+}
+
+// Resamples the working buffer 'src' and returns a pointer to the result, which is either 'src' itself or one of the two intermediate buffers.
+template <typename T>
+const T* ResampleWorkBuffer(
+    const T*                    src,
+    const Extent3D&             srcExtent,
+    const Extent3D&             dstExtent,
+    std::size_t                 numComponents,
+    const FilterDescriptor&     filterDesc,
+    std::vector<T>&             bufferA,
+    std::vector<T>&             bufferB,
+    std::size_t                 threadCount)
+{
+    AxisFilter<T> axis;
+    Extent3D extent = srcExtent;
+
+    /* Resample X axis */
+    if (extent.width != dstExtent.width)
+    {
+        BuildAxisFilter(axis, extent.width, dstExtent.width, filterDesc);
+        bufferA.resize(static_cast<std::size_t>(dstExtent.width) * extent.height * extent.depth * numComponents);
+        ResampleX(src, bufferA.data(), extent.width, dstExtent.width, extent.height * extent.depth, numComponents, axis, threadCount);
+        src = bufferA.data();
+        extent.width = dstExtent.width;
+    }
+
+    /* Resample Y axis */
+    if (extent.height != dstExtent.height)
+    {
+        BuildAxisFilter(axis, extent.height, dstExtent.height, filterDesc);
+        auto& dst = (src == bufferA.data() ? bufferB : bufferA);
+        dst.resize(static_cast<std::size_t>(extent.width) * dstExtent.height * extent.depth * numComponents);
+        ResampleOuterAxis(src, dst.data(), extent.width * numComponents, extent.depth, extent.height, dstExtent.height, 1, axis, threadCount);
+        src = dst.data();
+        extent.height = dstExtent.height;
+    }
+
+    /* Resample Z axis */
+    if (extent.depth != dstExtent.depth)
+    {
+        BuildAxisFilter(axis, extent.depth, dstExtent.depth, filterDesc);
+        auto& dst = (src == bufferA.data() ? bufferB : bufferA);
+        dst.resize(static_cast<std::size_t>(extent.width) * extent.height * dstExtent.depth * numComponents);
+        ResampleOuterAxis(src, dst.data(), extent.width * numComponents, 1, extent.depth, dstExtent.depth, extent.height, axis, threadCount);
+        src = dst.data();
+        extent.depth = dstExtent.depth;
+    }
+
+    return src;
+}
+
+template <typename T>
+void ResampleImageBufferFiltered(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    DataType                    workDataType,
+    ResizeFilter                filter,
+    std::size_t                 threadCount)
+{
+    const std::size_t numComponents = ImageFormatSize(srcImageDesc.format);
+
+    /* Load source image in working precision */
+    ByteBuffer convertedSrc;
+    const T* src = reinterpret_cast<const T*>(srcImageDesc.data);
+
+    if (srcImageDesc.dataType != workDataType)
+    {
+        convertedSrc = ConvertImageBuffer(srcImageDesc, srcImageDesc.format, workDataType, threadCount);
+        src = reinterpret_cast<const T*>(convertedSrc.get());
+    }
+
+    /* Resample all axes */
+    std::vector<T> bufferA, bufferB;
+    src = ResampleWorkBuffer(src, srcExtent, dstExtent, numComponents, GetFilterDesc(filter), bufferA, bufferB, threadCount);
+
+    /* Store result in destination data type */
+    const std::size_t count = static_cast<std::size_t>(dstExtent.width) * dstExtent.height * dstExtent.depth * numComponents;
+    StoreResampledBuffer(src, workDataType, dstImageDesc, count, threadCount);
+}
+
+static void ResampleImageBufferNearest(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    std::size_t                 threadCount)
+{
+    const std::size_t bpp = ImageFormatSize(srcImageDesc.format) * DataTypeSize(srcImageDesc.dataType);
+
+    /* Map each destination coordinate to the source coordinate of its pixel center */
+    auto mapAxis = [](std::uint32_t srcSize, std::uint32_t dstSize)
+    {
+        std::vector<std::size_t> indices(dstSize);
+        for (std::uint32_t i = 0; i < dstSize; ++i)
+            indices[i] = std::min<std::size_t>(srcSize - 1, (static_cast<std::uint64_t>(i) * 2 + 1) * srcSize / (static_cast<std::uint64_t>(dstSize) * 2));
+        return indices;
+    };
+
+    const auto mapX = mapAxis(srcExtent.width,  dstExtent.width );
+    const auto mapY = mapAxis(srcExtent.height, dstExtent.height);
+    const auto mapZ = mapAxis(srcExtent.depth,  dstExtent.depth );
+
+    auto src = reinterpret_cast<const char*>(srcImageDesc.data);
+    auto dst = reinterpret_cast<char*>(dstImageDesc.data);
+
+    GetGlobalThreadPool().ParallelFor(
+        static_cast<std::size_t>(dstExtent.height) * dstExtent.depth,
+        GetMinRowsPerChunk(dstExtent.width * bpp),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto y        = row % dstExtent.height;
+                const auto z        = row / dstExtent.height;
+                const char* srcRow  = src + (mapZ[z] * srcExtent.height + mapY[y]) * srcExtent.width * bpp;
+                char*       dstRow  = dst + row * dstExtent.width * bpp;
+
+                for (std::uint32_t x = 0; x < dstExtent.width; ++x)
+                    ::memcpy(dstRow + x * bpp, srcRow + mapX[x] * bpp, bpp);
+            }
+        }
+    );
+}
+
+/* ----- MIP-map chain ----- */
+
+// Stores the working buffer in linear color space into the destination image in sRGB color space.
+template <typename T>
+void StoreResampledBufferSRGB(
+    const T*                    src,
+    DataType                    workDataType,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 count,
+    std::vector<T>&             encodeBuffer,
+    std::size_t                 threadCount)
+{
+    const std::size_t numComponents = ImageFormatSize(dstImageDesc.format);
+    const std::size_t numPixels     = count / numComponents;
+
+    if (workDataType == DataType::Float32 && dstImageDesc.dataType == DataType::UInt8)
+    {
+        /* Encode 8-bit components directly with the vectorized approximation */
+        auto srcFloat = reinterpret_cast<const float*>(src);
+        auto dstUInt8 = reinterpret_cast<std::uint8_t*>(dstImageDesc.data);
+
+        GetGlobalThreadPool().ParallelFor(
+            numPixels,
+            GetMinRowsPerChunk(numComponents),
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                EncodeSRGB8(srcFloat + idxBegin * numComponents, dstUInt8 + idxBegin * numComponents, idxEnd - idxBegin, dstImageDesc.format);
+            }
+        );
+    }
+    else
+    {
+        /* Encode color components with the exact transfer function, then store them in the destination data type */
+        encodeBuffer.assign(src, src + count);
+
+        GetGlobalThreadPool().ParallelFor(
+            numPixels,
+            GetMinRowsPerChunk(numComponents),
+            threadCount,
+            [&](std::size_t idxBegin, std::size_t idxEnd)
+            {
+                ConvertColorSpaceSRGB(encodeBuffer.data() + idxBegin * numComponents, idxEnd - idxBegin, dstImageDesc.format, false);
+            }
+        );
+
+        StoreResampledBuffer(encodeBuffer.data(), workDataType, dstImageDesc, count, threadCount);
+    }
+}
+
+static std::size_t GetNumSubresourceComponents(const MipChainSubresource& subresource, std::size_t numComponents)
+{
+    const auto& extent = subresource.extent;
+    return (static_cast<std::size_t>(extent.width) * extent.height * extent.depth * subresource.numArrayLayers * numComponents);
+}
+
+template <typename T>
+void GenerateMipChainLevelsFiltered(
+    const SrcImageDescriptor&                   srcImageDesc,
+    const std::vector<MipChainSubresource>&     subresources,
+    char*                                       dst,
+    DataType                                    workDataType,
+    bool                                        sRGB,
+    std::size_t                                 threadCount)
+{
+    const std::size_t numComponents = ImageFormatSize(srcImageDesc.format);
+    const auto        filterDesc    = GetFilterDesc(ResizeFilter::Box);
+
+    /* Load base level in working precision (and linear color space) */
+    std::vector<T> prevLevel(GetNumSubresourceComponents(subresources[0], numComponents));
+
+    if (srcImageDesc.dataType != workDataType || sRGB)
+    {
+        ConvertImageBuffer(
+            srcImageDesc,
+            DstImageDescriptor{ srcImageDesc.format, workDataType, prevLevel.data(), prevLevel.size() * sizeof(T) },
+            threadCount,
+            (sRGB ? ImageConversionFlags::DecodeSRGB : 0)
+        );
+    }
+    else
+        ::memcpy(prevLevel.data(), srcImageDesc.data, prevLevel.size() * sizeof(T));
+
+    /* Downsample each MIP level from the previous one, so the base level is only read once */
+    std::vector<T> nextLevel, bufferA, bufferB, encodedLevel;
+
+    for (std::size_t mipLevel = 1; mipLevel < subresources.size(); ++mipLevel)
+    {
+        const auto& prev = subresources[mipLevel - 1];
+        const auto& next = subresources[mipLevel];
+
+        const auto prevLayerSize = GetNumSubresourceComponents(prev, numComponents) / prev.numArrayLayers;
+        const auto nextLayerSize = GetNumSubresourceComponents(next, numComponents) / next.numArrayLayers;
+
+        nextLevel.resize(nextLayerSize * next.numArrayLayers);
+
+        for (std::uint32_t layer = 0; layer < next.numArrayLayers; ++layer)
+        {
+            const T* result = ResampleWorkBuffer(
+                prevLevel.data() + layer * prevLayerSize, prev.extent, next.extent, numComponents, filterDesc, bufferA, bufferB, threadCount
+            );
+            ::memcpy(nextLevel.data() + layer * nextLayerSize, result, nextLayerSize * sizeof(T));
+        }
+
+        /* Store MIP level in destination data type (and sRGB color space) */
+        const DstImageDescriptor dstImageDesc{ srcImageDesc.format, srcImageDesc.dataType, dst + next.offset, next.dataSize };
+
+        if (sRGB)
+            StoreResampledBufferSRGB(nextLevel.data(), workDataType, dstImageDesc, nextLevel.size(), encodedLevel, threadCount);
+        else
+            StoreResampledBuffer(nextLevel.data(), workDataType, dstImageDesc, nextLevel.size(), threadCount);
+
+        std::swap(prevLevel, nextLevel);
+    }
+}
+
+static std::size_t GetRequiredImageDataSize(const Extent3D& extent, ImageFormat format, DataType dataType)
+{
+    return (static_cast<std::size_t>(ImageFormatSize(format)) * DataTypeSize(dataType) * extent.width * extent.height * extent.depth);
+}
+
+
+/* ----- Functions ----- */
+
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResizeFilter                filter,
+    std::size_t                 threadCount)
+{
+    /* Validate input parameters */
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot resample image with source and destination images having different format or data type");
+    if (IsCompressedFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot resample compressed image formats");
+    if (filter != ResizeFilter::Nearest && IsDepthStencilFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot resample depth-stencil image formats with other filters than ResizeFilter::Nearest");
+    if (srcImageDesc.dataSize < GetRequiredImageDataSize(srcExtent, srcImageDesc.format, srcImageDesc.dataType))
+        throw std::invalid_argument("source image data size is too small for resampling");
+    if (dstImageDesc.dataSize < GetRequiredImageDataSize(dstExtent, dstImageDesc.format, dstImageDesc.dataType))
+        throw std::invalid_argument("destination image data size is too small for resampling");
+
+    if (srcExtent.width == 0 || srcExtent.height == 0 || srcExtent.depth == 0 ||
+        dstExtent.width == 0 || dstExtent.height == 0 || dstExtent.depth == 0)
+    {
+        return;
+    }
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    if (filter == ResizeFilter::Nearest)
+        ResampleImageBufferNearest(srcImageDesc, srcExtent, dstImageDesc, dstExtent, threadCount);
+    else
+    {
+        /* Use double precision for 32-bit data types that do not fit into the mantissa of a float */
+        switch (srcImageDesc.dataType)
+        {
+            case DataType::Int32:
+            case DataType::UInt32:
+            case DataType::Float64:
+                ResampleImageBufferFiltered<double>(srcImageDesc, srcExtent, dstImageDesc, dstExtent, DataType::Float64, filter, threadCount);
+                break;
+            default:
+                ResampleImageBufferFiltered<float>(srcImageDesc, srcExtent, dstImageDesc, dstExtent, DataType::Float32, filter, threadCount);
+                break;
+        }
+    }
+}
+
+
+void GenerateMipChainLevels(
+    const SrcImageDescriptor&                   srcImageDesc,
+    const std::vector<MipChainSubresource>&     subresources,
+    char*                                       dst,
+    bool                                        sRGB,
+    std::size_t                                 threadCount)
+{
+    if (subresources.size() < 2)
+        return;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Use double precision for 32-bit data types that do not fit into the mantissa of a float */
+    switch (srcImageDesc.dataType)
+    {
+        case DataType::Int32:
+        case DataType::UInt32:
+        case DataType::Float64:
+            GenerateMipChainLevelsFiltered<double>(srcImageDesc, subresources, dst, DataType::Float64, sRGB, threadCount);
+            break;
+        default:
+            GenerateMipChainLevelsFiltered<float>(srcImageDesc, subresources, dst, DataType::Float32, sRGB, threadCount);
+            break;
+    }
+}
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,58 @@
+/*
+ * ImageResampling.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_RESAMPLING_H
+#define LLGL_IMAGE_RESAMPLING_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Types.h>
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Resamples the source image into the destination image with the specified filter.
+Source and destination must have the same format and data type, and their buffers must not overlap.
+Non-nearest filters are applied separately for each dimension, where each pass is split across threads by rows.
+*/
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResizeFilter                filter,
+    std::size_t                 threadCount
+);
+
+/*
+Generates the MIP levels 1 to N-1 of the specified subresources, where N is the number of subresources.
+Each level is downsampled from the previous level in working precision with a box filter, i.e. the levels are not quantized in between.
+The color components of sRGB images are filtered in linear color space.
+The source image descriptor specifies the base level, which is not written to the destination buffer.
+*/
+void GenerateMipChainLevels(
+    const SrcImageDescriptor&                   srcImageDesc,
+    const std::vector<MipChainSubresource>&     subresources,
+    char*                                       dst,
+    bool                                        sRGB,
+    std::size_t                                 threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
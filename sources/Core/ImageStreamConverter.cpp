@@ -0,0 +1,201 @@
+/*
+ * ImageStreamConverter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageStreamConverter.h>
+#include "BlockCompression.h"
+#include "Helper.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of the specified number of rows, including partial rows of 4x4 blocks for compressed formats.
+static std::size_t GetRowsDataSize(ImageFormat format, DataType dataType, std::uint32_t width, std::uint32_t numRows)
+{
+    if (IsCompressedFormat(format))
+        return GetCompressedImageDataSize(format, Extent3D{ width, numRows, 1 });
+    else
+        return (static_cast<std::size_t>(GetMemoryFootprint(format, dataType, 1)) * width * numRows);
+}
+
+ImageStreamConverter::ImageStreamConverter(const ImageStreamConverterDescriptor& desc, const ImageStreamCallback& callback) :
+    desc_     { desc     },
+    callback_ { callback }
+{
+    if (!callback_)
+        throw std::invalid_argument("cannot create image stream converter without callback");
+
+    /* Compressed formats are converted in rows of 4x4 blocks */
+    if (IsCompressedFormat(desc.srcFormat) || IsCompressedFormat(desc.dstFormat))
+        rowsPerUnit_ = 4;
+
+    srcUnitSize_ = GetSrcDataSize(rowsPerUnit_);
+
+    /* Determine how many rows fit into a single chunk */
+    const auto dstUnitSize = GetDstDataSize(rowsPerUnit_);
+
+    if (desc.ringBuffer != nullptr)
+    {
+        if (desc.ringBufferSize < dstUnitSize)
+            throw std::invalid_argument("ring buffer of image stream converter is too small for a single row of the destination image");
+        chunkBufferSize_ = std::min(desc.ringBufferSize, desc.maxChunkSize);
+    }
+    else
+        chunkBufferSize_ = desc.maxChunkSize;
+
+    const auto unitsPerChunk = std::max<std::size_t>(1, chunkBufferSize_ / std::max<std::size_t>(1, dstUnitSize));
+    maxRowsPerChunk_ = static_cast<std::uint32_t>(std::min<std::size_t>(unitsPerChunk * rowsPerUnit_, std::max(desc.extent.height, rowsPerUnit_)));
+
+    /* Allocate internal buffers; the chunk buffer is only as large as the largest chunk */
+    chunkBufferSize_ = GetDstDataSize(maxRowsPerChunk_);
+
+    if (desc.ringBuffer == nullptr)
+        chunkBuffer_ = MakeUniqueArray<char>(chunkBufferSize_);
+
+    pendingBuffer_ = MakeUniqueArray<char>(srcUnitSize_);
+}
+
+void ImageStreamConverter::Write(const void* data, std::size_t dataSize)
+{
+    auto src = reinterpret_cast<const char*>(data);
+
+    while (dataSize > 0)
+    {
+        if (IsComplete())
+            throw std::out_of_range("data of image stream exceeds the size of the image");
+
+        const auto numRowsLeft      = desc_.extent.height - row_;
+        const auto numUnitRows      = std::min(rowsPerUnit_, numRowsLeft);
+        const auto unitDataSize     = GetSrcDataSize(numUnitRows);
+
+        if (pendingSize_ > 0 || dataSize < unitDataSize)
+        {
+            /* Accumulate incomplete row in the pending buffer */
+            const auto size = std::min(unitDataSize - pendingSize_, dataSize);
+            ::memcpy(pendingBuffer_.get() + pendingSize_, src, size);
+
+            pendingSize_    += size;
+            src             += size;
+            dataSize        -= size;
+
+            if (pendingSize_ == unitDataSize)
+            {
+                ConvertRows(pendingBuffer_.get(), numUnitRows);
+                pendingSize_ = 0;
+            }
+        }
+        else
+        {
+            /* Convert as many complete rows as possible directly from the source data, but never across a slice */
+            auto numRows = std::min(numRowsLeft, maxRowsPerChunk_);
+
+            if (GetSrcDataSize(numRows) > dataSize)
+                numRows = std::min(numRows, static_cast<std::uint32_t>(dataSize / srcUnitSize_) * rowsPerUnit_);
+
+            const auto size = GetSrcDataSize(numRows);
+            ConvertRows(src, numRows);
+
+            src         += size;
+            dataSize    -= size;
+        }
+    }
+}
+
+void ImageStreamConverter::Reset()
+{
+    ringBufferOffset_   = 0;
+    pendingSize_        = 0;
+    slice_              = 0;
+    row_                = 0;
+}
+
+bool ImageStreamConverter::IsComplete() const
+{
+    return (slice_ >= desc_.extent.depth || desc_.extent.width == 0 || desc_.extent.height == 0);
+}
+
+std::uint64_t ImageStreamConverter::GetNumConvertedRows() const
+{
+    return (static_cast<std::uint64_t>(slice_) * desc_.extent.height + row_);
+}
+
+std::size_t ImageStreamConverter::GetMemoryFootprint() const
+{
+    return ((chunkBuffer_ ? chunkBufferSize_ : 0) + srcUnitSize_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::size_t ImageStreamConverter::GetSrcDataSize(std::uint32_t numRows) const
+{
+    return GetRowsDataSize(desc_.srcFormat, desc_.srcDataType, desc_.extent.width, numRows);
+}
+
+std::size_t ImageStreamConverter::GetDstDataSize(std::uint32_t numRows) const
+{
+    return GetRowsDataSize(desc_.dstFormat, desc_.dstDataType, desc_.extent.width, numRows);
+}
+
+void ImageStreamConverter::ConvertRows(const void* src, std::uint32_t numRows)
+{
+    const Extent3D extent{ desc_.extent.width, numRows, 1 };
+
+    const auto srcSize = GetSrcDataSize(numRows);
+    const auto dstSize = GetDstDataSize(numRows);
+
+    /* Select destination for the converted chunk */
+    char* dst = nullptr;
+
+    if (desc_.ringBuffer != nullptr)
+    {
+        if (ringBufferOffset_ + dstSize > desc_.ringBufferSize)
+            ringBufferOffset_ = 0;
+        dst = reinterpret_cast<char*>(desc_.ringBuffer) + ringBufferOffset_;
+        ringBufferOffset_ += dstSize;
+    }
+    else
+        dst = chunkBuffer_.get();
+
+    /* Convert rows into destination, or copy them if no conversion is necessary */
+    const SrcImageDescriptor srcImageDesc{ desc_.srcFormat, desc_.srcDataType, src, srcSize };
+    const DstImageDescriptor dstImageDesc{ desc_.dstFormat, desc_.dstDataType, dst, dstSize };
+
+    if (!ConvertImageBuffer(srcImageDesc, dstImageDesc, extent, desc_.threadCount, desc_.flags))
+        ::memcpy(dst, src, dstSize);
+
+    /* Pass converted chunk to callback */
+    ImageStreamChunk chunk;
+    {
+        chunk.data      = dst;
+        chunk.dataSize  = dstSize;
+        chunk.offset    = Offset3D{ 0, static_cast<std::int32_t>(row_), static_cast<std::int32_t>(slice_) };
+        chunk.extent    = extent;
+    }
+    callback_(chunk);
+
+    /* Move to next rows */
+    row_ += numRows;
+    if (row_ >= desc_.extent.height)
+    {
+        row_ = 0;
+        ++slice_;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,285 @@
+/*
+ * ThreadPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Number of chunks each sub-range is split into; more chunks give better load balancing, fewer chunks less overhead.
+static const std::size_t g_numChunksPerRange = 4;
+
+struct ThreadPool::Job
+{
+    // Sub-range of a participant. Owner and thieves claim chunks from the same atomic counter.
+    struct Range
+    {
+        std::atomic<std::size_t>    next        { 0 };
+        std::size_t                 end         = 0;
+        std::size_t                 chunkSize   = 1;
+    };
+
+    const RangeTask*            task            = nullptr;
+    std::unique_ptr<Range[]>    ranges;
+    std::size_t                 numRanges       = 0;
+    std::atomic<std::size_t>    nextParticipant { 1 };
+    std::atomic<std::size_t>    remaining       { 0 };
+    std::mutex                  mutex;
+    std::condition_variable     finished;
+    std::exception_ptr          exception;
+};
+
+
+/* ----- ThreadPool class ----- */
+
+ThreadPool::ThreadPool(std::size_t numWorkers) :
+    numWorkers_ { numWorkers }
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    JoinWorkers();
+}
+
+void ThreadPool::SetNumWorkers(std::size_t numWorkers)
+{
+    std::unique_lock<std::mutex> lock { mutex_ };
+
+    /* Wait for other resize operations, then keep new jobs off the workers until all jobs in flight are done */
+    idle_.wait(lock, [this]() { return !resizing_; });
+
+    if (numWorkers_ == numWorkers)
+        return;
+
+    resizing_ = true;
+    idle_.wait(lock, [this]() { return (activeJobs_ == 0); });
+
+    /* Join previous workers outside the lock; new workers are launched on next use */
+    std::vector<std::thread> workers;
+    workers.swap(workers_);
+    stop_ = true;
+
+    lock.unlock();
+    jobAvail_.notify_all();
+
+    for (auto& w : workers)
+        w.join();
+
+    lock.lock();
+    numWorkers_ = numWorkers;
+    resizing_   = false;
+    lock.unlock();
+
+    idle_.notify_all();
+}
+
+std::size_t ThreadPool::GetNumWorkers() const
+{
+    return numWorkers_;
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t minChunkSize, std::size_t maxThreadCount, const RangeTask& task)
+{
+    minChunkSize = std::max<std::size_t>(1, minChunkSize);
+
+    /* Determine number of participants, which is limited by the amount of work */
+    auto numParticipants = std::min(maxThreadCount, count / minChunkSize);
+
+    if (numParticipants >= 2)
+    {
+        /* Register job in flight, unless the worker threads are being resized */
+        std::lock_guard<std::mutex> guard { mutex_ };
+        if (resizing_)
+            numParticipants = 1;
+        else
+        {
+            numParticipants = std::min(numParticipants, numWorkers_.load() + 1);
+            if (numParticipants >= 2)
+            {
+                if (workers_.empty())
+                    LaunchWorkers();
+                ++activeJobs_;
+            }
+        }
+    }
+
+    if (numParticipants < 2)
+    {
+        /* Execute task only on calling thread */
+        if (count > 0)
+            task(0, count);
+        return;
+    }
+
+    /* Split index range into sub-ranges with adaptive chunk sizes */
+    auto job = std::make_shared<Job>();
+    {
+        job->task       = (&task);
+        job->numRanges  = numParticipants;
+        job->ranges     = std::unique_ptr<Job::Range[]>(new Job::Range[numParticipants]);
+        job->remaining  = count;
+
+        const auto rangeSize    = count / numParticipants;
+        const auto rangeRemain  = count % numParticipants;
+        const auto chunkSize    = std::max(minChunkSize, rangeSize / g_numChunksPerRange);
+
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < numParticipants; ++i)
+        {
+            auto& range = job->ranges[i];
+            range.next      = offset;
+            offset         += rangeSize + (i < rangeRemain ? 1 : 0);
+            range.end       = offset;
+            range.chunkSize = chunkSize;
+        }
+    }
+
+    /* Submit job to worker threads */
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        jobs_.push_back(job);
+    }
+    jobAvail_.notify_all();
+
+    /* Participate on calling thread with the first sub-range */
+    RunJob(*job, 0);
+
+    /* Wait until the chunks that were claimed by worker threads are done */
+    {
+        std::unique_lock<std::mutex> lock { job->mutex };
+        job->finished.wait(lock, [&job]() { return (job->remaining == 0); });
+    }
+
+    /* Remove job from queue if not all workers have picked it up, and notify pending resize operations once the pool is idle */
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        auto it = std::find(jobs_.begin(), jobs_.end(), job);
+        if (it != jobs_.end())
+            jobs_.erase(it);
+        if (--activeJobs_ == 0)
+            idle_.notify_all();
+    }
+
+    if (job->exception)
+        std::rethrow_exception(job->exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ThreadPool::LaunchWorkers()
+{
+    const auto numWorkers = numWorkers_.load();
+    stop_ = false;
+    workers_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&ThreadPool::WorkerProc, this);
+}
+
+void ThreadPool::JoinWorkers()
+{
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        stop_ = true;
+    }
+    jobAvail_.notify_all();
+
+    for (auto& w : workers_)
+        w.join();
+
+    workers_.clear();
+}
+
+void ThreadPool::WorkerProc()
+{
+    for (;;)
+    {
+        std::shared_ptr<Job> job;
+        std::size_t participant = 0;
+
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            jobAvail_.wait(lock, [this]() { return (stop_ || !jobs_.empty()); });
+
+            if (stop_)
+                return;
+
+            /* Join front job and remove it from the queue once all sub-ranges have an owner */
+            job         = jobs_.front();
+            participant = job->nextParticipant++;
+
+            if (participant + 1 >= job->numRanges)
+                jobs_.pop_front();
+        }
+
+        if (participant < job->numRanges)
+            RunJob(*job, participant);
+    }
+}
+
+void ThreadPool::RunJob(Job& job, std::size_t participant)
+{
+    /* Process own sub-range first, then steal chunks from the other sub-ranges */
+    for (std::size_t i = 0; i < job.numRanges; ++i)
+    {
+        auto& range = job.ranges[(participant + i) % job.numRanges];
+
+        for (;;)
+        {
+            const auto idxBegin = range.next.fetch_add(range.chunkSize);
+            if (idxBegin >= range.end)
+                break;
+
+            const auto idxEnd = std::min(idxBegin + range.chunkSize, range.end);
+
+            try
+            {
+                (*job.task)(idxBegin, idxEnd);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard { job.mutex };
+                if (!job.exception)
+                    job.exception = std::current_exception();
+            }
+
+            /* Notify calling thread when the last chunk is done */
+            const auto numIndices = idxEnd - idxBegin;
+            if (job.remaining.fetch_sub(numIndices) == numIndices)
+            {
+                std::lock_guard<std::mutex> guard { job.mutex };
+                job.finished.notify_all();
+            }
+        }
+    }
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT ThreadPool& GetGlobalThreadPool()
+{
+    static ThreadPool threadPool { std::max(1u, std::thread::hardware_concurrency()) - 1u };
+    return threadPool;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
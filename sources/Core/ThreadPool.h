@@ -0,0 +1,102 @@
+/*
+ * ThreadPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <deque>
+
+
+namespace LLGL
+{
+
+
+/*
+Thread pool with persistent worker threads for CPU side bulk work (e.g. image conversion).
+Work is distributed with ParallelFor: the index range is split into one sub-range per participating thread,
+each thread processes chunks of its own sub-range and then steals chunks from the other sub-ranges.
+The calling thread always participates, so nested or concurrent calls cannot deadlock.
+*/
+class LLGL_EXPORT ThreadPool
+{
+
+    public:
+
+        // Task function for the index range [idxBegin, idxEnd).
+        using RangeTask = std::function<void(std::size_t idxBegin, std::size_t idxEnd)>;
+
+    public:
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        // Initializes the thread pool with the specified number of worker threads. Workers are only launched on first use.
+        ThreadPool(std::size_t numWorkers);
+        ~ThreadPool();
+
+        /*
+        Sets the number of worker threads, i.e. the maximal number of threads excluding the calling thread.
+        Blocks until all jobs in flight are done; ParallelFor calls that start during the resize run on their calling thread only.
+        This must not be called from within a task of this thread pool.
+        */
+        void SetNumWorkers(std::size_t numWorkers);
+
+        // Returns the number of worker threads.
+        std::size_t GetNumWorkers() const;
+
+        /*
+        Runs the specified task for the index range [0, count) and blocks until all indices have been processed.
+        At most 'maxThreadCount' threads (including the calling thread) participate and no chunk is smaller than 'minChunkSize'.
+        If a task throws an exception, the first exception is re-thrown on the calling thread after all chunks are done.
+        */
+        void ParallelFor(std::size_t count, std::size_t minChunkSize, std::size_t maxThreadCount, const RangeTask& task);
+
+    private:
+
+        struct Job;
+
+        void LaunchWorkers();
+        void JoinWorkers();
+        void WorkerProc();
+
+        static void RunJob(Job& job, std::size_t participant);
+
+    private:
+
+        std::atomic<std::size_t>            numWorkers_     { 0 };
+        std::vector<std::thread>            workers_;
+        std::deque<std::shared_ptr<Job>>    jobs_;
+        std::mutex                          mutex_;
+        std::condition_variable             jobAvail_;
+        std::condition_variable             idle_;
+        std::size_t                         activeJobs_     = 0;
+        bool                                resizing_       = false;
+        bool                                stop_           = false;
+
+};
+
+// Returns the global thread pool of this library. By default, it has one worker thread less than the number of hardware threads.
+LLGL_EXPORT ThreadPool& GetGlobalThreadPool();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
+#include "../../../Core/Helper.h"
 #include <limits.h>
 
 #include <fstream>//!!!
@@ -51,6 +52,14 @@ static const Reg g_amd64TempReg     = Reg::RAX;
 
 #endif
 
+/*
+Callee-saved registers that are preserved by the entry point:
+the first integer parameter of the entry point (e.g. the GL state manager) is kept in RBX across all function calls,
+and R12 is used as loop counter for repeated function calls.
+*/
+static const Reg g_amd64VarArgReg   = Reg::RBX;
+static const Reg g_amd64CounterReg  = Reg::R12;
+
 static const std::size_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
 static const std::size_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
 
@@ -84,6 +93,14 @@ void AMD64Assembler::Begin()
     /* Reset data about local stack */
     localStackSize_ = 128;//0;
     paramStackSize_ = 0;
+    cachedVarArg_   = 0xF;
+
+    supplements_.clear();
+    callTargets_.clear();
+    callTargetIndices_.clear();
+    callSites_.clear();
+    varArgDisp_.clear();
+    stackChunkOffsets_.clear();
 
     /* Write entry point prologue */
     WritePrologue();
@@ -92,13 +109,17 @@ void AMD64Assembler::Begin()
 
 void AMD64Assembler::End()
 {
+    /* Write remaining function calls */
+    FlushFuncCalls();
+
     /* Pop local stack */
     if (localStackSize_ > 0)
         AddImm32(Reg::RSP, localStackSize_);
 
-    /* Write entry point epilogue and append supplement at the end of program */
+    /* Write entry point epilogue and append supplement and call targets at the end of program */
     WriteEpilogue();
     ApplySupplements();
+    ApplyCallTargets();
 
     // TEST: write program to file
     #if 0
@@ -144,7 +165,12 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
 
         if (arg.param < 0xF)
         {
-            if (arg.param < varArgDisp_.size())
+            if (arg.param == cachedVarArg_)
+            {
+                /* Move parameter from callee-saved register into destination register */
+                MovReg(dstReg, g_amd64VarArgReg);
+            }
+            else if (arg.param < varArgDisp_.size())
             {
                 /* Move parameter from local stack into destination register */
                 if (IsFltReg(dstReg))
@@ -153,11 +179,6 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
                     MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
             }
         }
-        else if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
-        {
-            /* R8-R15 registers are only supported for 64-bit operand size */
-            MovRegImm64(dstReg, arg.value.i64);
-        }
         else
         {
             /* Move value into destination register */
@@ -179,8 +200,7 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
                     MovRegImm64(dstReg, arg.value.i64);
                     break;
                 case ArgType::StackPtr:
-                    MovReg(dstReg, Reg::RBP);
-                    SubImm32(dstReg, stackChunkOffsets_[arg.value.i8]);
+                    LeaRegMem(dstReg, Reg::RBP, MakeDisp(-static_cast<std::int32_t>(stackChunkOffsets_[arg.value.i8])));
                     break;
                 case ArgType::Float:
                     MovSSRegImm32(dstReg, arg.value.f32);
@@ -210,6 +230,19 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
         }
 
         /* Push argument onto stack */
+        if (arg.param < 0xF)
+        {
+            if (arg.param == cachedVarArg_)
+                MovMemReg(Reg::RSP, g_amd64VarArgReg, stackDisp);
+            else if (arg.param < varArgDisp_.size())
+            {
+                MovRegMem(g_amd64TempReg, Reg::RBP, varArgDisp_[arg.param]);
+                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
+            }
+            stackDisp.disp8 += 8;
+            continue;
+        }
+
         switch (arg.type)
         {
             case ArgType::Byte:
@@ -227,17 +260,67 @@ void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farC
                 stackDisp.disp8 += 8;
                 break;
             case ArgType::StackPtr:
-                MovReg(g_amd64TempReg, Reg::RBP);
-                SubImm32(g_amd64TempReg, stackChunkOffsets_[arg.value.i8]);
+                LeaRegMem(g_amd64TempReg, Reg::RBP, MakeDisp(-static_cast<std::int32_t>(stackChunkOffsets_[arg.value.i8])));
                 MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
                 stackDisp.disp8 += 8;
                 break;
         }
     }
 
-    /* Write 'call' instruction */
-    MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(addr));
-    CallNear(g_amd64TempReg);
+    /* Write 'call' instruction that loads the function address from the end of the program */
+    CallNearIndirect(addr);
+}
+
+void AMD64Assembler::WriteRepeatedFuncCall(const void* addr, JITCallConv conv, bool farCall, std::uint32_t count)
+{
+    /* Write function call only once inside a loop with a counter in a callee-saved register */
+    MovRegImm32(g_amd64CounterReg, count);
+    {
+        const auto loopBegin = GetAssembly().size();
+        WriteFuncCall(addr, conv, farCall);
+        DecReg32(g_amd64CounterReg);
+        JumpIfNotZero(loopBegin);
+    }
+}
+
+void AMD64Assembler::WriteStackCopy(std::uint8_t idx, const void* data, std::uint32_t size)
+{
+    /* Copy data with a call to 'memcpy' if it cannot be copied with a few 16, 8, and 4 byte moves */
+    if (size % 4 != 0 || size > 256)
+    {
+        JITCompiler::WriteStackCopy(idx, data, size);
+        return;
+    }
+
+    /* Load source address into temporary register and copy data with SSE2 registers */
+    const auto dstOffset = -static_cast<std::int32_t>(stackChunkOffsets_[idx]);
+
+    MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(data));
+
+    for (std::uint32_t offset = 0; offset < size;)
+    {
+        const auto srcDisp = MakeDisp(static_cast<std::int32_t>(offset));
+        const auto dstDisp = MakeDisp(dstOffset + static_cast<std::int32_t>(offset));
+
+        if (size - offset >= 16)
+        {
+            MovDQURegMem(Reg::XMM0, g_amd64TempReg, srcDisp);
+            MovDQUMemReg(Reg::RBP, Reg::XMM0, dstDisp);
+            offset += 16;
+        }
+        else if (size - offset >= 8)
+        {
+            MovRegMem(Reg::RCX, g_amd64TempReg, srcDisp);
+            MovMemReg(Reg::RBP, Reg::RCX, dstDisp);
+            offset += 8;
+        }
+        else
+        {
+            MovRegMem(Reg::ECX, g_amd64TempReg, srcDisp);
+            MovMemReg(Reg::RBP, Reg::ECX, dstDisp);
+            offset += 4;
+        }
+    }
 }
 
 
@@ -250,6 +333,14 @@ bool AMD64Assembler::IsLittleEndian() const
     return true;
 }
 
+AMD64Assembler::Displacement AMD64Assembler::MakeDisp(std::int32_t disp)
+{
+    if (disp >= SCHAR_MIN && disp <= SCHAR_MAX)
+        return Disp8{ static_cast<std::int8_t>(disp) };
+    else
+        return Disp32{ disp };
+}
+
 std::uint8_t AMD64Assembler::DispMod(const Displacement& disp) const
 {
     if (disp.disp32 != 0)
@@ -280,20 +371,16 @@ void AMD64Assembler::WritePrologue()
     PushReg(Reg::RBP);
     MovReg(Reg::RBP, Reg::RSP);
 
-    #if 1
-    /* Store general purpose registers */
-    //TODO: determine which registers must be stored
-    PushReg(Reg::RBX);
-    #endif
+    /* Store callee-saved registers that are used by the program */
+    PushReg(g_amd64VarArgReg);
+    PushReg(g_amd64CounterReg);
 }
 
 void AMD64Assembler::WriteEpilogue()
 {
-    #if 1
-    /* Restore general purpose registers */
-    //TODO: determine which registers must be restored
-    PopReg(Reg::RBX);
-    #endif
+    /* Restore callee-saved registers */
+    PopReg(g_amd64CounterReg);
+    PopReg(g_amd64VarArgReg);
 
     /* Restore base stack pointer (RBP) */
     PopReg(Reg::RBP);
@@ -314,12 +401,13 @@ void AMD64Assembler::WriteStackFrame(
     for (auto chunk : stackChunks)
         stackChunksSize += chunk;
 
-    /* Allocate local stack */
-    localStackSize_ += varArgSize;
+    /* Allocate local stack (after the preserved RBX and R12 registers) */
+    const std::uint32_t savedRegsSize = 16;
 
-    std::uint32_t chunkStackOffset = localStackSize_ + 8;
+    localStackSize_ += varArgSize + stackChunksSize + 8;
 
-    localStackSize_ += stackChunksSize;
+    /* Keep stack 16-byte aligned for all subsequent calls (RSP is 16-byte aligned after RBP, RBX, and R12 have been pushed) */
+    localStackSize_ = GetAlignedSize(localStackSize_, 16u);
 
     if (localStackSize_ > 0)
         SubImm32(Reg::RSP, localStackSize_);
@@ -327,7 +415,7 @@ void AMD64Assembler::WriteStackFrame(
     /* Store parameters in local stack */
     std::size_t numIntRegs = 0, numFltRegs = 0;
     std::int8_t paramStackOffset = 16; // first parameter at [EBP+16]
-    std::int8_t localStackOffset = -16; // local variables after preserved EBX
+    std::int8_t localStackOffset = -static_cast<std::int8_t>(savedRegsSize + 8); // local variables after preserved RBX and R12
 
     for (auto type : varArgTypes)
     {
@@ -362,6 +450,13 @@ void AMD64Assembler::WriteStackFrame(
         {
             localStackOffset -= 8; // x64 register size of 64 bits
             MovMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+
+            /* Keep first integer parameter in callee-saved register */
+            if (cachedVarArg_ == 0xF)
+            {
+                MovReg(g_amd64VarArgReg, srcReg);
+                cachedVarArg_ = static_cast<std::uint8_t>(varArgDisp_.size());
+            }
         }
 
         /* Store parameter offset within stack frame */
@@ -371,7 +466,9 @@ void AMD64Assembler::WriteStackFrame(
     /* Determine stack base for arguments of subsequent calls */
     argStackBase_.disp8 = localStackOffset;
 
-    /* Determine stack base for allocated stack chunks */
+    /* Determine stack base for allocated stack chunks right after the parameters, so they can be addressed with small displacements */
+    std::uint32_t chunkStackOffset = static_cast<std::uint32_t>(-localStackOffset);
+
     stackChunkOffsets_.reserve(stackChunks.size());
     for (auto chunk : stackChunks)
     {
@@ -398,6 +495,22 @@ void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
         WriteByte(REX_Prefix | prefix);
 }
 
+// Writes the REX prefix for an instruction with 'reg' in the <reg> field and 'rmReg' in the <r/m> field. The operand size is determined by 'reg'.
+void AMD64Assembler::WriteOptREXRegRM(Reg reg, Reg rmReg)
+{
+    std::uint8_t prefix = 0;
+
+    if (Is64Reg(reg))
+        prefix |= REX_W;
+    if (reg >= Reg::R8 && reg <= Reg::R15)
+        prefix |= REX_R;
+    if (rmReg >= Reg::R8 && rmReg <= Reg::R15)
+        prefix |= REX_B;
+
+    if (prefix != 0)
+        WriteByte(REX_Prefix | prefix);
+}
+
 void AMD64Assembler::WriteOptDisp(const Displacement& disp)
 {
     if (disp.disp32 != 0)
@@ -449,6 +562,28 @@ void AMD64Assembler::ApplySupplements()
     }
 }
 
+void AMD64Assembler::ApplyCallTargets()
+{
+    auto& code = GetAssembly();
+
+    /* Align table of function addresses to 8 bytes with 'int3' padding */
+    while (code.size() % 8 != 0)
+        WriteByte(0xCC);
+
+    const auto tableOffset = code.size();
+
+    for (auto addr : callTargets_)
+        WritePtr(addr);
+
+    /* Override displacement dummies of all call sites */
+    for (const auto& site : callSites_)
+    {
+        auto rip = site.dstOffset + 4;
+        std::uint32_t disp32 = static_cast<std::uint32_t>(tableOffset + site.target * 8 - rip);
+        ::memcpy(&(code[site.dstOffset]), &disp32, sizeof(disp32));
+    }
+}
+
 void AMD64Assembler::ErrInvalidUseOfRSP()
 {
     #ifdef LLGL_DEBUG
@@ -516,32 +651,44 @@ void AMD64Assembler::Pop(Reg dstReg)
 // Opcode: 89 /r
 void AMD64Assembler::MovReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteOptREXRegRM(srcReg, dstReg);
     WriteByte(Opcode_MovMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
+// Opcode: [REX.B] B8 +rd id
+// 32-bit operations zero-extend into the 64-bit register, so this is also used for 64-bit values with the upper half cleared.
 void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
 {
+    const bool extReg = (dstReg >= Reg::R8 && dstReg <= Reg::R15);
+
     if (dword != 0)
     {
+        if (extReg)
+            WriteByte(REX_Prefix | REX_B);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteDWord(dword);
     }
     else
-        XOrReg(dstReg, dstReg);
+    {
+        /* Clear register with 32-bit 'xor' instruction */
+        if (extReg)
+            WriteByte(REX_Prefix | REX_R | REX_B);
+        WriteByte(Opcode_XOrMemReg);
+        WriteByte(Operand_Mod11 | RegByte(dstReg) << 3 | RegByte(dstReg));
+    }
 }
 
 void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
 {
-    if (qword != 0)
+    if (qword <= 0xFFFFFFFFull)
+        MovRegImm32(dstReg, static_cast<std::uint32_t>(qword));
+    else
     {
         WriteOptREX(dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteQWord(qword);
     }
-    else
-        XOrReg(dstReg, dstReg);
 }
 
 void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp)
@@ -556,7 +703,7 @@ void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displ
 
 void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
 {
-    WriteOptREX(srcReg); // prefix
+    WriteOptREXRegRM(srcReg, dstMemReg); // prefix
     WriteByte(Opcode_MovMemReg);
     WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
     WriteOptSIB(dstMemReg);
@@ -565,7 +712,7 @@ void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& di
 
 void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
 {
-    WriteOptREX(dstReg);
+    WriteOptREXRegRM(dstReg, srcMemReg);
     WriteByte(Opcode_MovRegMem);
     WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
     WriteOptSIB(srcMemReg);
@@ -638,6 +785,18 @@ void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement&
     WriteOptDisp(disp);
 }
 
+/* ----- LEA ----- */
+
+// Opcode: REX.W 8D /r
+void AMD64Assembler::LeaRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+{
+    WriteOptREXRegRM(dstReg, srcMemReg);
+    WriteByte(Opcode_LeaRegMem);
+    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
+    WriteOptSIB(srcMemReg);
+    WriteOptDisp(disp);
+}
+
 /* ----- ADD ----- */
 
 void AMD64Assembler::AddImm32(Reg dst, std::uint32_t dword)
@@ -675,11 +834,42 @@ void AMD64Assembler::DivReg(Reg srcReg)
 // Opcode: 31 /r
 void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteOptREXRegRM(srcReg, dstReg);
     WriteByte(Opcode_XOrMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
+/* ----- DEC ----- */
+
+// Opcode: [REX.B] FF /1
+void AMD64Assembler::DecReg32(Reg dstReg)
+{
+    if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
+        WriteByte(REX_Prefix | REX_B);
+    WriteByte(Opcode_DecReg);
+    WriteByte(Operand_Mod11 | (1u << 3) | RegByte(dstReg));
+}
+
+/* ----- JNZ ----- */
+
+// Opcode: 75 cb, or 0F 85 cd
+void AMD64Assembler::JumpIfNotZero(std::size_t dstOffset)
+{
+    const auto offset = static_cast<std::int64_t>(dstOffset) - static_cast<std::int64_t>(GetAssembly().size());
+
+    if (offset - 2 >= SCHAR_MIN)
+    {
+        WriteByte(Opcode_JnzRel8);
+        WriteByte(static_cast<std::uint8_t>(offset - 2));
+    }
+    else
+    {
+        WriteByte(OpcodePrefix_2);
+        WriteByte(Opcode_JnzRel32);
+        WriteDWord(static_cast<std::uint32_t>(offset - 6));
+    }
+}
+
 /* ----- CALL ----- */
 
 void AMD64Assembler::CallNear(Reg reg)
@@ -689,6 +879,25 @@ void AMD64Assembler::CallNear(Reg reg)
     WriteByte(Opcode_CallNear | Operand_Mod11 | RegByte(reg));
 }
 
+// Opcode: FF /2 with RIP-relative address of the function pointer, which is shared by all calls to the same function
+void AMD64Assembler::CallNearIndirect(const void* addr)
+{
+    /* Find or append function address in table of call targets */
+    auto it = callTargetIndices_.find(addr);
+    if (it == callTargetIndices_.end())
+    {
+        it = callTargetIndices_.insert({ addr, callTargets_.size() }).first;
+        callTargets_.push_back(addr);
+    }
+
+    WriteByte(0xFF);
+    WriteByte(Opcode_CallNear | Operand_RIP);
+
+    callSites_.push_back({ it->second, GetAssembly().size() });
+
+    WriteDWord(0); // displacement (dummy)
+}
+
 /* ----- RET ----- */
 
 void AMD64Assembler::RetNear(std::uint16_t word)
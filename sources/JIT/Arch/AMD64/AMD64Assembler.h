@@ -12,6 +12,7 @@
 #include "AMD64Register.h"
 #include "../../JITCompiler.h"
 #include <vector>
+#include <map>
 #include <cstdint>
 
 
@@ -35,11 +36,15 @@ class AMD64Assembler final : public JITCompiler
 
         bool IsLittleEndian() const override;
         void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) override;
+        void WriteRepeatedFuncCall(const void* addr, JITCallConv conv, bool farCall, std::uint32_t count) override;
+        void WriteStackCopy(std::uint8_t idx, const void* data, std::uint32_t size) override;
 
     private:
 
         struct Displacement;
 
+        static Displacement MakeDisp(std::int32_t disp);
+
         std::uint8_t DispMod(const Displacement& disp) const;
         std::uint8_t ModRM(std::uint8_t mode, Reg r0, Reg r1) const;
 
@@ -52,12 +57,14 @@ class AMD64Assembler final : public JITCompiler
         );
 
         void WriteOptREX(Reg reg, bool defaultsTo64Bit = false);
+        void WriteOptREXRegRM(Reg reg, Reg rmReg);
         void WriteOptDisp(const Displacement& disp);
         void WriteOptSIB(Reg reg);
 
         void BeginSupplement(const Arg& arg);
         void EndSupplement();
         void ApplySupplements();
+        void ApplyCallTargets();
 
         void ErrInvalidUseOfRSP();
 
@@ -90,12 +97,18 @@ class AMD64Assembler final : public JITCompiler
         void MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
         void MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
 
+        void LeaRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
+
         void AddImm32(Reg dstReg, std::uint32_t dword);
         void SubImm32(Reg dstReg, std::uint32_t dword);
         void DivReg(Reg srcReg);
         void XOrReg(Reg dstReg, Reg srcReg);
+        void DecReg32(Reg dstReg);
+
+        void JumpIfNotZero(std::size_t dstOffset);
 
         void CallNear(Reg reg);
+        void CallNearIndirect(const void* addr);
 
         void RetNear(std::uint16_t word = 0);
         void RetFar(std::uint16_t word = 0);
@@ -116,6 +129,12 @@ class AMD64Assembler final : public JITCompiler
             std::size_t     dstOffset;  // Destination byte offset where the instruction must be updated
         };
 
+        struct CallSite
+        {
+            std::size_t     target;     // Index into the list of call targets
+            std::size_t     dstOffset;  // Destination byte offset of the RIP-relative displacement
+        };
+
         struct Displacement
         {
             Displacement();
@@ -149,6 +168,14 @@ class AMD64Assembler final : public JITCompiler
         // Supplement data that must be updated after encoding
         std::vector<Supplement>     supplements_;
 
+        // Unique function addresses that are written at the end of the program and all call sites that refer to them
+        std::vector<const void*>                callTargets_;
+        std::map<const void*, std::size_t>      callTargetIndices_;
+        std::vector<CallSite>                   callSites_;
+
+        // Index of the entry point parameter that is kept in a callee-saved register (0xF if unused)
+        std::uint8_t                cachedVarArg_   = 0xF;
+
         // Displacements of parameters within stack frame
         std::vector<Displacement>   varArgDisp_;
 
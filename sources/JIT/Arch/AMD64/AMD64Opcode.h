@@ -80,11 +80,15 @@ enum Opcode : std::uint8_t
     Opcode_MovMemImm    = 0xC7, // C7 /0 id
     Opcode_MovMemReg    = 0x89, // 89 /r
     Opcode_MovRegMem    = 0x8B, // 8B /r
+    Opcode_LeaRegMem    = 0x8D, // 8D /r
     Opcode_RetNear      = 0xC3, // C3
     Opcode_RetFar       = 0xCB, // CB
     Opcode_RetNearImm16 = 0xC2, // C2 iw
     Opcode_RetFarImm16  = 0xCA, // CA iw
     Opcode_CallNear     = 0x10, // /2 => 00 010 000 => 0x10
+    Opcode_DecReg       = 0xFF, // FF /1
+    Opcode_JnzRel8      = 0x75, // 75 cb
+    Opcode_JnzRel32     = 0x85, // 0F 85 cd
     Opcode_Int          = 0xCD, // CD ib
 };
 
@@ -23,6 +23,8 @@ void IA32Assembler::Begin()
 
 void IA32Assembler::End()
 {
+    /* Write remaining function calls */
+    FlushFuncCalls();
     //TODO
 }
 
@@ -0,0 +1,289 @@
+/*
+ * JITCodeHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "JITCodeHeap.h"
+#include "JITMemory.h"
+#include "../Core/Helper.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Default size (in bytes) of each region. Larger programs get a region of their own.
+static const std::size_t g_regionSize       = 64 * 1024;
+
+// Alignment (in bytes) of each program entry point.
+static const std::size_t g_blockAlignment   = 16;
+
+JITCodeHeap::JITCodeHeap() :
+    pageSize_ { GetJITMemoryPageSize() }
+{
+}
+
+JITCodeHeap::~JITCodeHeap()
+{
+    for (const auto& region : regions_)
+        FreeJITMemory(region->addr, region->size);
+}
+
+JITCodeHeap& JITCodeHeap::Get()
+{
+    static JITCodeHeap instance;
+    return instance;
+}
+
+JITCodeHeap::Block JITCodeHeap::Alloc(const void* code, std::size_t size)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    const auto alignedSize = GetAlignedSize(std::max(size, std::size_t(1)), g_blockAlignment);
+
+    /* Find first writable region with a free range that is large enough */
+    Region*     region = nullptr;
+    std::size_t offset = 0;
+
+    for (const auto& r : regions_)
+    {
+        if (!r->executable.load(std::memory_order_relaxed) && AllocRange(*r, alignedSize, offset))
+        {
+            region = r.get();
+            break;
+        }
+    }
+
+    if (region == nullptr)
+    {
+        /* Create new region for this program */
+        region = CreateRegion(alignedSize);
+        AllocRange(*region, alignedSize, offset);
+    }
+
+    region->allocatedBytes += alignedSize;
+    region->numAllocations++;
+
+    /* Copy code into writable memory; it is executable after the entire region has been protected */
+    ::memcpy(region->addr + offset, code, size);
+
+    Block block;
+    {
+        block.addr      = region->addr + offset;
+        block.size      = alignedSize;
+        block.region    = region;
+    }
+    return block;
+}
+
+void JITCodeHeap::Free(const Block& block)
+{
+    if (block.region == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto region = reinterpret_cast<Region*>(block.region);
+    auto offset = static_cast<std::size_t>(reinterpret_cast<std::uint8_t*>(block.addr) - region->addr);
+
+    region->allocatedBytes -= block.size;
+    region->numAllocations--;
+
+    if (!region->executable.load(std::memory_order_relaxed))
+    {
+        /* Recycle range immediately while the region is still writable */
+        FreeRange(*region, offset, block.size);
+    }
+
+    if (region->numAllocations == 0)
+    {
+        /* Keep a single empty region of default size for subsequent programs and release all others */
+        const bool anotherRegionEmpty = std::any_of(
+            regions_.begin(),
+            regions_.end(),
+            [region](const RegionPtr& r)
+            {
+                return (r.get() != region && r->numAllocations == 0 && !r->executable.load(std::memory_order_relaxed));
+            }
+        );
+
+        if (region->size != g_regionSize || anotherRegionEmpty)
+            ReleaseRegion(region);
+        else
+            ResetRegion(*region);
+    }
+}
+
+void JITCodeHeap::MakeExecutable(const Block& block)
+{
+    auto region = reinterpret_cast<Region*>(block.region);
+    if (region == nullptr || region->executable.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    if (!region->executable.load(std::memory_order_relaxed))
+    {
+        /* Protect entire region at once; this makes all programs in this region executable */
+        ProtectJITMemory(region->addr, region->size, true);
+        region->executable.store(true, std::memory_order_release);
+        ++protectionChanges_;
+    }
+}
+
+JITCodeHeapStatistics JITCodeHeap::GetStatistics() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    JITCodeHeapStatistics stats;
+    {
+        stats.numRegions        = regions_.size();
+        stats.peakReservedBytes = peakReservedBytes_;
+        stats.protectionChanges = protectionChanges_;
+    }
+
+    for (const auto& region : regions_)
+    {
+        stats.numAllocations    += region->numAllocations;
+        stats.reservedBytes     += region->size;
+        stats.allocatedBytes    += region->allocatedBytes;
+
+        if (region->executable.load(std::memory_order_relaxed))
+            stats.numExecutableRegions++;
+        else
+            stats.writableFreeBytes += (region->size - region->allocatedBytes);
+    }
+
+    return stats;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool JITCodeHeap::AllocRange(Region& region, std::size_t size, std::size_t& offset)
+{
+    /* Find first free range that is large enough */
+    for (auto it = region.freeRanges.begin(); it != region.freeRanges.end(); ++it)
+    {
+        if (it->size >= size)
+        {
+            offset = it->offset;
+            if (it->size > size)
+            {
+                it->offset  += size;
+                it->size    -= size;
+            }
+            else
+                region.freeRanges.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JITCodeHeap::FreeRange(Region& region, std::size_t offset, std::size_t size)
+{
+    auto& ranges = region.freeRanges;
+
+    /* Find insertion point to keep free ranges sorted by offset */
+    auto next = std::lower_bound(
+        ranges.begin(),
+        ranges.end(),
+        offset,
+        [](const Range& range, std::size_t off)
+        {
+            return (range.offset < off);
+        }
+    );
+
+    /* Merge with previous range */
+    if (next != ranges.begin())
+    {
+        auto prev = next - 1;
+        if (prev->offset + prev->size == offset)
+        {
+            prev->size += size;
+
+            /* Merge with next range as well */
+            if (next != ranges.end() && offset + size == next->offset)
+            {
+                prev->size += next->size;
+                ranges.erase(next);
+            }
+            return;
+        }
+    }
+
+    /* Merge with next range */
+    if (next != ranges.end() && offset + size == next->offset)
+    {
+        next->offset    = offset;
+        next->size      += size;
+        return;
+    }
+
+    ranges.insert(next, Range{ offset, size });
+}
+
+void JITCodeHeap::ResetRegion(Region& region)
+{
+    if (region.executable.load(std::memory_order_relaxed))
+    {
+        ProtectJITMemory(region.addr, region.size, false);
+        region.executable.store(false, std::memory_order_relaxed);
+        ++protectionChanges_;
+    }
+
+    region.freeRanges.clear();
+    region.freeRanges.push_back({ 0, region.size });
+}
+
+JITCodeHeap::Region* JITCodeHeap::CreateRegion(std::size_t minSize)
+{
+    auto region = MakeUnique<Region>();
+    {
+        region->size = GetAlignedSize(std::max(minSize, g_regionSize), pageSize_);
+        region->addr = reinterpret_cast<std::uint8_t*>(AllocJITMemory(region->size));
+        region->freeRanges.push_back({ 0, region->size });
+    }
+    regions_.push_back(std::move(region));
+
+    /* Track peak of reserved memory */
+    std::size_t reservedBytes = 0;
+    for (const auto& r : regions_)
+        reservedBytes += r->size;
+    peakReservedBytes_ = std::max(peakReservedBytes_, reservedBytes);
+
+    return regions_.back().get();
+}
+
+void JITCodeHeap::ReleaseRegion(Region* region)
+{
+    auto it = std::find_if(
+        regions_.begin(),
+        regions_.end(),
+        [region](const RegionPtr& r)
+        {
+            return (r.get() == region);
+        }
+    );
+
+    if (it != regions_.end())
+    {
+        FreeJITMemory(region->addr, region->size);
+        regions_.erase(it);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
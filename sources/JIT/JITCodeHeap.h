@@ -0,0 +1,134 @@
+/*
+ * JITCodeHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_JIT_CODE_HEAP_H
+#define LLGL_JIT_CODE_HEAP_H
+
+
+#include <LLGL/Export.h>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Usage statistics of the JIT code heap.
+struct JITCodeHeapStatistics
+{
+    std::size_t numRegions           = 0; // Number of virtual memory regions.
+    std::size_t numExecutableRegions = 0; // Number of regions with read/execute protection.
+    std::size_t numAllocations       = 0; // Number of JIT programs that currently live in the code heap.
+    std::size_t reservedBytes        = 0; // Size (in bytes) of all regions.
+    std::size_t allocatedBytes       = 0; // Size (in bytes) of all allocated blocks including alignment padding.
+    std::size_t writableFreeBytes    = 0; // Size (in bytes) of free ranges that can still be allocated, i.e. free ranges in writable regions.
+    std::size_t peakReservedBytes    = 0; // Highest number of reserved bytes since the code heap was created.
+    std::size_t protectionChanges    = 0; // Number of protection changes since the code heap was created.
+};
+
+/*
+Executable memory heap for JIT programs with W^X policy, i.e. memory is never writable and executable at the same time.
+Programs are sub-allocated from large regions: all programs that are written into a region before any of them is executed
+are turned executable with a single protection change. After that, the region no longer accepts new programs.
+Free ranges are recycled while a region is still writable, and a region is reset to read/write protection
+once all of its programs have been released.
+*/
+class LLGL_EXPORT JITCodeHeap
+{
+
+    public:
+
+        // Block of native code within the code heap.
+        struct Block
+        {
+            void*       addr    = nullptr;
+            std::size_t size    = 0;
+            void*       region  = nullptr; // Opaque reference to the region this block belongs to.
+        };
+
+    public:
+
+        JITCodeHeap(const JITCodeHeap&) = delete;
+        JITCodeHeap& operator = (const JITCodeHeap&) = delete;
+
+        ~JITCodeHeap();
+
+        // Returns the instance of this code heap.
+        static JITCodeHeap& Get();
+
+        // Allocates a block for the specified code and copies it into the code heap. The block is not executable until MakeExecutable is called.
+        Block Alloc(const void* code, std::size_t size);
+
+        // Releases the specified block. The range is recycled immediately or when the entire region has been released.
+        void Free(const Block& block);
+
+        // Changes the region of the specified block to read/execute protection, which also applies to all other blocks in that region.
+        void MakeExecutable(const Block& block);
+
+        // Returns the current usage statistics of the code heap.
+        JITCodeHeapStatistics GetStatistics() const;
+
+    private:
+
+        struct Range
+        {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        struct Region
+        {
+            std::uint8_t*           addr            = nullptr;
+            std::size_t             size            = 0;
+            std::size_t             allocatedBytes  = 0;
+            std::size_t             numAllocations  = 0;
+            std::atomic<bool>       executable      { false };
+            std::vector<Range>      freeRanges;     // Sorted by offset.
+        };
+
+        using RegionPtr = std::unique_ptr<Region>;
+
+    private:
+
+        JITCodeHeap();
+
+        // Allocates a range within the specified region, or returns false if there is no free range large enough.
+        bool AllocRange(Region& region, std::size_t size, std::size_t& offset);
+
+        // Returns the specified range to the region and merges it with its adjacent free ranges.
+        void FreeRange(Region& region, std::size_t offset, std::size_t size);
+
+        // Resets the specified region to read/write protection and marks its entire memory as free.
+        void ResetRegion(Region& region);
+
+        Region* CreateRegion(std::size_t minSize);
+        void ReleaseRegion(Region* region);
+
+    private:
+
+        mutable std::mutex      mutex_;
+        std::vector<RegionPtr>  regions_;
+        std::size_t             pageSize_           = 0;
+        std::size_t             peakReservedBytes_  = 0;
+        std::size_t             protectionChanges_  = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
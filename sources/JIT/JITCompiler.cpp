@@ -9,13 +9,12 @@
 #include "AssemblyTypes.h"
 #include "../Core/Helper.h"
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string.h>
 
 #include <LLGL/Platform/Platform.h>
-#if defined LLGL_OS_WIN32
-#   include "Platform/Win32/Win32JITProgram.h"
-#else
-#   include "Platform/POSIX/POSIXJITProgram.h"
-#endif
 
 #if defined LLGL_ARCH_ARM
 //#   include "Arch/ARM/ARMAssembler.h"
@@ -32,6 +31,16 @@ namespace LLGL
 
 using namespace JIT;
 
+static bool IsEqualArg(const Arg& lhs, const Arg& rhs)
+{
+    return (lhs.type == rhs.type && lhs.param == rhs.param && lhs.value.i64 == rhs.value.i64);
+}
+
+static bool IsEqualArgList(const std::vector<Arg>& lhs, const std::vector<Arg>& rhs)
+{
+    return (lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), IsEqualArg));
+}
+
 std::unique_ptr<JITCompiler> JITCompiler::Create()
 {
     std::unique_ptr<JITCompiler> compiler;
@@ -106,6 +115,24 @@ std::uint8_t JITCompiler::StackAlloc(std::uint32_t size)
     return idx;
 }
 
+void JITCompiler::CopyToStack(std::uint8_t idx, const void* data, std::uint32_t size)
+{
+    /* Never skip the copy silently, since the following function call would read stale data from the stack */
+    if (idx >= stackAllocs_.size())
+        throw std::out_of_range("invalid stack allocation index " + std::to_string(idx) + " for JIT stack copy");
+    if (size > stackAllocs_[idx])
+    {
+        throw std::out_of_range(
+            "JIT stack copy of " + std::to_string(size) + " byte(s) exceeds stack allocation of " +
+            std::to_string(stackAllocs_[idx]) + " byte(s)"
+        );
+    }
+
+    /* Write pending function call first, since the copy might be encoded without a function call */
+    FlushFuncCalls();
+    WriteStackCopy(idx, data, size);
+}
+
 void JITCompiler::PushVarArg(std::uint8_t idx)
 {
     if (idx < entryVarArgs_.size() && idx < 0xF)
@@ -128,6 +155,7 @@ void JITCompiler::PushStackPtr(std::uint8_t idx)
         {
             arg.type        = ArgType::StackPtr;
             arg.param       = 0xF;
+            arg.value.i64   = 0;
             arg.value.i8    = idx;
         }
         args_.push_back(arg);
@@ -217,7 +245,27 @@ void JITCompiler::PushDouble(double value)
 
 void JITCompiler::FuncCall(const void* addr, JITCallConv conv, bool farCall)
 {
-    WriteFuncCall(addr, conv, farCall);
+    /* Collapse identical consecutive function calls, so they can be written as a single loop */
+    if ( pendingCall_.count > 0          &&
+         pendingCall_.addr    == addr    &&
+         pendingCall_.conv    == conv    &&
+         pendingCall_.farCall == farCall &&
+         IsEqualArgList(pendingCall_.args, args_) )
+    {
+        ++pendingCall_.count;
+        args_.clear();
+        return;
+    }
+
+    /* Write previous function call and keep the new one pending */
+    FlushFuncCalls();
+
+    pendingCall_.addr       = addr;
+    pendingCall_.conv       = conv;
+    pendingCall_.farCall    = farCall;
+    pendingCall_.count      = 1;
+    pendingCall_.args.swap(args_);
+
     args_.clear();
 }
 
@@ -240,24 +288,33 @@ void JITCompiler::PushSSizeT(std::int64_t value)
  * ======= Protected: =======
  */
 
+void JITCompiler::WriteRepeatedFuncCall(const void* addr, JITCallConv conv, bool farCall, std::uint32_t count)
+{
+    for (std::uint32_t i = 0; i < count; ++i)
+        WriteFuncCall(addr, conv, farCall);
+}
+
+void JITCompiler::WriteStackCopy(std::uint8_t idx, const void* data, std::uint32_t size)
+{
+    Call(::memcpy, JITStackPtr{ idx }, data, static_cast<std::size_t>(size));
+}
+
+void JITCompiler::FlushFuncCalls()
+{
+    if (pendingCall_.count == 1)
+        WriteFuncCall(pendingCall_.addr, pendingCall_.conv, pendingCall_.farCall);
+    else if (pendingCall_.count > 1)
+        WriteRepeatedFuncCall(pendingCall_.addr, pendingCall_.conv, pendingCall_.farCall, pendingCall_.count);
+
+    pendingCall_.count = 0;
+    pendingCall_.args.clear();
+}
+
 void JITCompiler::Write(const void* data, std::size_t size)
 {
-    assembly_.reserve(assembly_.size() + size);
-    auto byteAlignedData = reinterpret_cast<const std::int8_t*>(data);
-    #if 0
-    if (littleEndian_)
-    {
-        /* Encode for little endian */
-        for (std::size_t i = 0; i < size; ++i)
-            assembly_.push_back(byteAlignedData[size - i - 1u]);
-    }
-    else
-    #endif
-    {
-        /* Encode for big endian */
-        for (std::size_t i = 0; i < size; ++i)
-            assembly_.push_back(byteAlignedData[i]);
-    }
+    /* Append bytes without reserving the exact size, which would defeat the geometric growth of the container */
+    auto byteAlignedData = reinterpret_cast<const std::uint8_t*>(data);
+    assembly_.insert(assembly_.end(), byteAlignedData, byteAlignedData + size);
 }
 
 void JITCompiler::WriteByte(std::uint8_t data)
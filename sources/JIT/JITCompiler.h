@@ -75,6 +75,13 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
         virtual void Begin() = 0;
         virtual void End() = 0;
 
+        /*
+        Encodes a copy of the specified data into the stack allocation 'idx' (e.g. for arguments that are passed by reference).
+        The data is read when the program is executed, so it must remain valid for the lifetime of the program.
+        Throws std::out_of_range if 'idx' is not a valid stack allocation or 'size' exceeds its size.
+        */
+        void CopyToStack(std::uint8_t idx, const void* data, std::uint32_t size);
+
         // Pushes the entry point parameter, specified by the zero-based index 'idx', to the argument list.
         void PushVarArg(std::uint8_t idx);
 
@@ -137,6 +144,18 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
         virtual bool IsLittleEndian() const = 0;
         virtual void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) = 0;
 
+        /*
+        Encodes the same function call for the specified number of times.
+        The default implementation writes the function call repeatedly; architectures with a loop encoding should override this.
+        */
+        virtual void WriteRepeatedFuncCall(const void* addr, JITCallConv conv, bool farCall, std::uint32_t count);
+
+        // Encodes a copy into a stack allocation. The default implementation calls 'memcpy'.
+        virtual void WriteStackCopy(std::uint8_t idx, const void* data, std::uint32_t size);
+
+        // Writes the function call that is still pending (must be called before the epilogue is written in 'End').
+        void FlushFuncCalls();
+
     protected:
 
         void Write(const void* data, std::size_t size);
@@ -160,10 +179,10 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
             return assembly_;
         }
 
-        // Returns the list of function arguments.
+        // Returns the list of function arguments of the function call that is currently written.
         inline const std::vector<JIT::Arg>& GetArgs() const
         {
-            return args_;
+            return pendingCall_.args;
         }
 
         // Returns the list of entry point variadic arguments.
@@ -198,12 +217,25 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
         template <typename... Args>
         inline void PushArgs(Args&&... args);
 
+    private:
+
+        // Function call that has not been written yet, so identical consecutive calls can be collapsed.
+        struct PendingCall
+        {
+            const void*             addr    = nullptr;
+            JITCallConv             conv    = JITCallConv::CDecl;
+            bool                    farCall = false;
+            std::uint32_t           count   = 0;
+            std::vector<JIT::Arg>   args;
+        };
+
     private:
 
         bool                        littleEndian_   = false;
         std::vector<std::uint8_t>   assembly_;
 
         std::vector<JIT::Arg>       args_;
+        PendingCall                 pendingCall_;
         std::vector<JIT::ArgType>   entryVarArgs_;
         std::vector<std::uint32_t>  stackAllocs_;
 
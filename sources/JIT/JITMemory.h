@@ -0,0 +1,41 @@
+/*
+ * JITMemory.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_JIT_MEMORY_H
+#define LLGL_JIT_MEMORY_H
+
+
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+// Returns the size (in bytes) of a virtual memory page. Protection can only be changed for entire pages.
+std::size_t GetJITMemoryPageSize();
+
+// Allocates the specified amount of virtual memory with read/write protection. The size must be a multiple of the page size.
+void* AllocJITMemory(std::size_t size);
+
+// Releases the virtual memory that was allocated with AllocJITMemory.
+void FreeJITMemory(void* addr, std::size_t size);
+
+// Changes the protection of the specified pages to read/execute if 'executable' is true, or to read/write otherwise.
+void ProtectJITMemory(void* addr, std::size_t size, bool executable);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
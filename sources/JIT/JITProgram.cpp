@@ -0,0 +1,42 @@
+/*
+ * JITProgram.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "JITProgram.h"
+
+
+namespace LLGL
+{
+
+
+std::unique_ptr<JITProgram> JITProgram::Create(const void* code, std::size_t size)
+{
+    return std::unique_ptr<JITProgram>(new JITProgram(JITCodeHeap::Get().Alloc(code, size)));
+}
+
+JITProgram::JITProgram(const JITCodeHeap::Block& block) :
+    block_ { block }
+{
+}
+
+JITProgram::~JITProgram()
+{
+    JITCodeHeap::Get().Free(block_);
+}
+
+JITProgram::EntryPointPtr JITProgram::GetEntryPoint() const
+{
+    /* Protect code heap region before first execution; this is a no-op once the region is executable */
+    JITCodeHeap::Get().MakeExecutable(block_);
+    return reinterpret_cast<EntryPointPtr>(block_.addr);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
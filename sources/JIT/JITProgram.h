@@ -9,6 +9,7 @@
 #define LLGL_JIT_PROGRAM_H
 
 
+#include "JITCodeHeap.h"
 #include <LLGL/NonCopyable.h>
 #include <cstddef>
 #include <memory>
@@ -18,7 +19,7 @@ namespace LLGL
 {
 
 
-// Wrapper class for platform dependent native code.
+// Wrapper class for platform dependent native code, which is sub-allocated from the JIT code heap.
 class LLGL_EXPORT JITProgram : public NonCopyable
 {
 
@@ -32,25 +33,24 @@ class LLGL_EXPORT JITProgram : public NonCopyable
         // Creates a new JIT program with the specified code.
         static std::unique_ptr<JITProgram> Create(const void* code, std::size_t size);
 
-        // Returns the main entry point of the native JIT program.
-        inline EntryPointPtr GetEntryPoint() const
-        {
-            return entryPoint_;
-        }
-
-    protected:
+        ~JITProgram();
 
-        JITProgram() = default;
+        // Returns the main entry point of the native JIT program. The first call makes the program executable.
+        EntryPointPtr GetEntryPoint() const;
 
-        // Sets the address for the function pointer that can be executed.
-        inline void SetEntryPoint(void* addr)
+        // Returns the size (in bytes) this program occupies in the code heap.
+        inline std::size_t GetSize() const
         {
-            entryPoint_ = reinterpret_cast<EntryPointPtr>(addr);
+            return block_.size;
         }
 
     private:
 
-        EntryPointPtr entryPoint_ = nullptr;
+        JITProgram(const JITCodeHeap::Block& block);
+
+    private:
+
+        JITCodeHeap::Block block_;
 
 };
 
@@ -0,0 +1,65 @@
+/*
+ * POSIXJITMemory.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../../JITMemory.h"
+#include <stdexcept>
+#include <string>
+#include <unistd.h> // sysconf
+#include <sys/mman.h> // mmap
+
+
+namespace LLGL
+{
+
+
+std::size_t GetJITMemoryPageSize()
+{
+    return static_cast<std::size_t>(::sysconf(_SC_PAGE_SIZE));
+}
+
+void* AllocJITMemory(std::size_t size)
+{
+    /* Map virtual memory space; memory is never writable and executable at the same time */
+    auto addr = ::mmap(
+        nullptr,
+        size,
+        (PROT_READ | PROT_WRITE),
+        (MAP_PRIVATE | MAP_ANONYMOUS),
+        -1, // must be -1 if MAP_ANONYMOUS is used
+        0
+    );
+
+    if (addr == MAP_FAILED)
+        throw std::runtime_error("failed to map " + std::to_string(size) + " byte(s) of virtual memory for JIT programs");
+
+    return addr;
+}
+
+void FreeJITMemory(void* addr, std::size_t size)
+{
+    ::munmap(addr, size);
+}
+
+void ProtectJITMemory(void* addr, std::size_t size, bool executable)
+{
+    const int prot = (executable ? (PROT_READ | PROT_EXEC) : (PROT_READ | PROT_WRITE));
+    if (::mprotect(addr, size, prot) != 0)
+        throw std::runtime_error("failed to change virtual memory protection for JIT programs");
+
+    #if defined __GNUC__ || defined __clang__
+    /* Instruction cache is not coherent with data cache on all architectures (e.g. ARM) */
+    if (executable)
+        __builtin___clear_cache(reinterpret_cast<char*>(addr), reinterpret_cast<char*>(addr) + size);
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
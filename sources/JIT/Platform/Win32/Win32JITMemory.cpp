@@ -0,0 +1,56 @@
+/*
+ * Win32JITMemory.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../../JITMemory.h"
+#include <stdexcept>
+#include <string>
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+
+namespace LLGL
+{
+
+
+std::size_t GetJITMemoryPageSize()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<std::size_t>(info.dwPageSize);
+}
+
+void* AllocJITMemory(std::size_t size)
+{
+    /* Allocate chunk of virtual memory; memory is never writable and executable at the same time */
+    auto addr = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (addr == 0)
+        throw std::runtime_error("failed to allocate " + std::to_string(size) + " byte(s) of virtual memory for JIT programs");
+    return addr;
+}
+
+void FreeJITMemory(void* addr, std::size_t /*size*/)
+{
+    VirtualFree(addr, 0, MEM_RELEASE);
+}
+
+void ProtectJITMemory(void* addr, std::size_t size, bool executable)
+{
+    DWORD oldProtect = 0;
+    if (VirtualProtect(addr, size, (executable ? PAGE_EXECUTE_READ : PAGE_READWRITE), &oldProtect) == 0)
+        throw std::runtime_error("failed to change virtual memory protection for JIT programs");
+
+    if (executable)
+        FlushInstructionCache(GetCurrentProcess(), addr, size);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
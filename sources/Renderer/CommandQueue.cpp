@@ -0,0 +1,29 @@
+/*
+ * CommandQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandQueue.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Command Buffers ----- */
+
+void CommandQueue::Submit(std::uint32_t numCommandBuffers, CommandBuffer* const * commandBuffers)
+{
+    /* Submit all command buffers in order by default */
+    for (std::uint32_t i = 0; i < numCommandBuffers; ++i)
+        Submit(*commandBuffers[i]);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -210,6 +210,29 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
     return result;
 }
 
+void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        ValidateResourceCPUAccess(bufferDbg.desc.cpuAccessFlags, access, "buffer");
+        ValidateBufferMapping(bufferDbg, true);
+        ValidateBufferBoundary(bufferDbg.desc.size, offset, length);
+    }
+
+    auto result = instance_->MapBuffer(bufferDbg.instance, access, offset, length);
+
+    if (result != nullptr)
+        bufferDbg.mapped = true;
+
+    if (profiler_)
+        profiler_->frameProfile.bufferMappings++;
+
+    return result;
+}
+
 void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
@@ -608,7 +631,15 @@ void DbgRenderSystem::ValidateBufferDesc(const BufferDescriptor& desc, std::uint
     /* Validate flags */
     ValidateBindFlags(desc.bindFlags);
     ValidateCPUAccessFlags(desc.cpuAccessFlags, CPUAccessFlags::ReadWrite, "buffer");
-    ValidateMiscFlags(desc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData), "buffer");
+    ValidateMiscFlags(desc.miscFlags, (MiscFlags::DynamicUsage | MiscFlags::NoInitialData | MiscFlags::PersistentMap), "buffer");
+
+    if ((desc.miscFlags & MiscFlags::PersistentMap) != 0 && (desc.cpuAccessFlags & CPUAccessFlags::ReadWrite) == 0)
+    {
+        LLGL_DBG_WARN(
+            WarningType::ImproperArgument,
+            "'LLGL::MiscFlags::PersistentMap' specified for buffer without any CPU access flags"
+        );
+    }
 
     /* Validate (constant-) buffer size */
     if ((desc.bindFlags & BindFlags::ConstantBuffer) != 0)
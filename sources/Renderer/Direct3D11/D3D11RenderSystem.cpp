@@ -217,6 +217,10 @@ Texture* D3D11RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
     if (imageDesc != nullptr && MustGenerateMipsOnCreate(textureDesc))
         D3D11MipGenerator::Get().GenerateMips(context_.Get(), *texture);
 
+    /* Write remaining MIP-maps if the initial image data contains the entire MIP-map chain */
+    if (imageDesc != nullptr && MustWritePrebuiltMipsOnCreate(textureDesc))
+        WritePrebuiltMips(*texture, textureDesc, *imageDesc);
+
     return TakeOwnership(textures_, std::move(texture));
 }
 
@@ -277,6 +277,10 @@ Texture* D3D12RenderSystem::CreateTexture(const TextureDescriptor& textureDesc,
 
         /* Execute upload commands and wait for GPU to finish execution */
         ExecuteCommandListAndSync();
+
+        /* Write remaining MIP-maps if the initial image data contains the entire MIP-map chain */
+        if (MustWritePrebuiltMipsOnCreate(textureDesc))
+            WritePrebuiltMips(*textureD3D, textureDesc, *imageDesc);
     }
 
     return TakeOwnership(textures_, std::move(textureD3D));
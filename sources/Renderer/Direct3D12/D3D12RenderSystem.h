@@ -82,6 +82,8 @@ class D3D12RenderSystem final : public RenderSystem
 
         void WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize) override;
 
+        using RenderSystem::MapBuffer;
+
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
         void UnmapBuffer(Buffer& buffer) override;
 
@@ -208,11 +208,11 @@ LLGL_EXPORT std::uint32_t ImageFormatSize(const ImageFormat imageFormat)
         case ImageFormat::ABGR:         return 4;
         case ImageFormat::Depth:        return 1;
         case ImageFormat::DepthStencil: return 2;
-        case ImageFormat::BC1:          return 0; // no conversion supported yet
-        case ImageFormat::BC2:          return 0; // no conversion supported yet
-        case ImageFormat::BC3:          return 0; // no conversion supported yet
-        case ImageFormat::BC4:          return 0; // no conversion supported yet
-        case ImageFormat::BC5:          return 0; // no conversion supported yet
+        case ImageFormat::BC1:          return 0; // block compressed, see GetCompressedBlockSize
+        case ImageFormat::BC2:          return 0; // block compressed, see GetCompressedBlockSize
+        case ImageFormat::BC3:          return 0; // block compressed, see GetCompressedBlockSize
+        case ImageFormat::BC4:          return 0; // block compressed, see GetCompressedBlockSize
+        case ImageFormat::BC5:          return 0; // block compressed, see GetCompressedBlockSize
     }
     return 0;
 }
@@ -75,6 +75,8 @@ class MTRenderSystem final : public RenderSystem
 
         void WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize) override;
 
+        using RenderSystem::MapBuffer;
+
         void* MapBuffer(Buffer& buffer, const CPUAccess access) override;
         void UnmapBuffer(Buffer& buffer) override;
 
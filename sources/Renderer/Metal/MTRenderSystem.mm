@@ -139,6 +139,10 @@ Texture* MTRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             }
             [cmdBuffer commit];
         }
+
+        /* Write remaining MIP-maps if the initial image data contains the entire MIP-map chain */
+        if (MustWritePrebuiltMipsOnCreate(textureDesc))
+            WritePrebuiltMips(*textureMT, textureDesc, *imageDesc);
     }
 
     return TakeOwnership(textures_, std::move(textureMT));
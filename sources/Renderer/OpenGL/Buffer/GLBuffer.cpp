@@ -6,6 +6,7 @@
  */
 
 #include "GLBuffer.h"
+#include "GLPersistentMapping.h"
 #include "../GLProfile.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
@@ -95,6 +96,8 @@ BufferDescriptor GLBuffer::GetDesc() const
 
     if (usage == GL_DYNAMIC_DRAW)
         bufferDesc.miscFlags |= MiscFlags::DynamicUsage;
+    if (persistentMapping_)
+        bufferDesc.miscFlags |= MiscFlags::PersistentMap;
 
     return bufferDesc;
 }
@@ -255,6 +258,46 @@ void* GLBuffer::MapBuffer(GLenum access)
     }
 }
 
+void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        return glMapNamedBufferRange(GetID(), offset, length, access);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        GLStateManager::Get().BindGLBuffer(*this);
+        return glMapBufferRange(GetGLTarget(), offset, length, access);
+    }
+    else
+    #endif // /GL_ARB_map_buffer_range
+    {
+        return nullptr;
+    }
+}
+
+void GLBuffer::FlushMappedBufferRange(GLintptr offset, GLsizeiptr length)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        glFlushMappedNamedBufferRange(GetID(), offset, length);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        GLStateManager::Get().BindGLBuffer(*this);
+        glFlushMappedBufferRange(GetGLTarget(), offset, length);
+    }
+    #endif // /GL_ARB_map_buffer_range
+}
+
 void GLBuffer::UnmapBuffer()
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
@@ -270,6 +313,19 @@ void GLBuffer::UnmapBuffer()
     }
 }
 
+void GLBuffer::CreatePersistentMapping(GLsizeiptr size, GLbitfield storageFlags)
+{
+    #ifdef LLGL_GLEXT_BUFFER_STORAGE
+    if ((storageFlags & GL_MAP_PERSISTENT_BIT) != 0)
+    {
+        /* Keep buffer mapped for its entire lifetime; fall back to regular mapping if this failed */
+        persistentMapping_ = MakeUnique<GLPersistentMapping>(*this, size, storageFlags);
+        if (persistentMapping_->GetMappedData() == nullptr)
+            persistentMapping_.reset();
+    }
+    #endif // /LLGL_GLEXT_BUFFER_STORAGE
+}
+
 void GLBuffer::GetBufferParams(GLint* size, GLint* usage, GLint* storageFlags) const
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
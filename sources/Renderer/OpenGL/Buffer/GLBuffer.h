@@ -14,12 +14,15 @@
 #include "../OpenGL.h"
 #include "../RenderState/GLStateManager.h"
 #include <cstdint>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+class GLPersistentMapping;
+
 class GLBuffer : public Buffer
 {
 
@@ -43,11 +46,22 @@ class GLBuffer : public Buffer
         void CopyBufferSubData(const GLBuffer& readBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
 
         void* MapBuffer(GLenum access);
+        void* MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access);
+        void FlushMappedBufferRange(GLintptr offset, GLsizeiptr length);
         void UnmapBuffer();
 
+        // Maps the entire buffer persistently if the storage flags contain GL_MAP_PERSISTENT_BIT (see MiscFlags::PersistentMap).
+        void CreatePersistentMapping(GLsizeiptr size, GLbitfield storageFlags);
+
         // Returns the specified buffer parameters; null pointers are ignored.
         void GetBufferParams(GLint* size, GLint* usage, GLint* storageFlags) const;
 
+        // Returns the persistent mapping of this buffer or null if the buffer is not persistently mapped.
+        inline GLPersistentMapping* GetPersistentMapping() const
+        {
+            return persistentMapping_.get();
+        }
+
         // Returns the hardware buffer ID.
         inline GLuint GetID() const
         {
@@ -81,6 +95,8 @@ class GLBuffer : public Buffer
         GLBufferTarget  target_             = GLBufferTarget::ARRAY_BUFFER;
         bool            indexType16Bits_    = false;
 
+        std::unique_ptr<GLPersistentMapping> persistentMapping_;
+
 };
 
 
@@ -0,0 +1,178 @@
+/*
+ * GLPersistentMapping.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLPersistentMapping.h"
+#include "GLBuffer.h"
+#include "../RenderState/GLFence.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace LLGL
+{
+
+
+/*
+Fence that is shared by all ranges that have been written since the last command buffer submission.
+Only a weak reference is stored here, so the fence is released together with the last range that refers to it.
+*/
+static std::weak_ptr<GLFence> g_pendingFence;
+
+static std::shared_ptr<GLFence> GetPendingFence()
+{
+    auto fence = g_pendingFence.lock();
+    if (!fence)
+    {
+        fence = std::make_shared<GLFence>();
+        g_pendingFence = fence;
+    }
+    return fence;
+}
+
+GLPersistentMapping::GLPersistentMapping(GLBuffer& buffer, GLsizeiptr size, GLbitfield storageFlags) :
+    buffer_ { buffer }
+{
+    #ifdef LLGL_GLEXT_BUFFER_STORAGE
+
+    /* Map entire buffer once; written ranges must be flushed explicitly unless the storage is coherent */
+    GLbitfield access = (storageFlags & (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT));
+
+    coherent_ = ((storageFlags & GL_MAP_COHERENT_BIT) != 0);
+
+    if ((access & GL_MAP_WRITE_BIT) != 0 && !coherent_)
+        access |= GL_MAP_FLUSH_EXPLICIT_BIT;
+
+    mappedData_ = reinterpret_cast<std::uint8_t*>(buffer_.MapBufferRange(0, size, access));
+    size_       = size;
+
+    #endif // /LLGL_GLEXT_BUFFER_STORAGE
+}
+
+void* GLPersistentMapping::Map(GLintptr offset, GLsizeiptr length, bool readAccess, bool writeAccess)
+{
+    if (readAccess)
+    {
+        /* GPU might have written anywhere into the buffer, so wait for all commands (storage with read access is always coherent) */
+        WaitForAllCommands();
+    }
+    else
+    {
+        /* Only wait for commands that might read from the range that is about to be overwritten */
+        WaitForRange(offset, offset + length);
+    }
+
+    mappedOffset_   = offset;
+    mappedLength_   = length;
+    mappedWrite_    = writeAccess;
+
+    return (mappedData_ + offset);
+}
+
+void GLPersistentMapping::Unmap()
+{
+    if (!mappedWrite_ || mappedLength_ == 0)
+        return;
+
+    /* Make written range visible to the GPU */
+    if (!coherent_)
+        buffer_.FlushMappedBufferRange(mappedOffset_, mappedLength_);
+
+    /* Track written range until the next submission has been completed by the GPU */
+    const GLintptr begin    = mappedOffset_;
+    const GLintptr end      = mappedOffset_ + mappedLength_;
+    auto fence              = GetPendingFence();
+
+    if (!pendingRanges_.empty())
+    {
+        /* Merge with previous range if it is contiguous and belongs to the same submission, which is the common case for ring buffers */
+        auto& prev = pendingRanges_.back();
+        if (prev.fence == fence && prev.end == begin)
+        {
+            prev.end = end;
+            mappedWrite_ = false;
+            return;
+        }
+    }
+
+    pendingRanges_.push_back({ begin, end, fence });
+    mappedWrite_ = false;
+}
+
+void GLPersistentMapping::SubmitPendingFence()
+{
+    if (auto fence = g_pendingFence.lock())
+    {
+        fence->Submit();
+        g_pendingFence.reset();
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLPersistentMapping::WaitForRange(GLintptr begin, GLintptr end)
+{
+    /* Find last pending range that overlaps with the specified range */
+    auto numRanges = pendingRanges_.size();
+
+    for (auto i = numRanges; i-- > 0;)
+    {
+        const auto& range = pendingRanges_[i];
+        if (range.begin < end && begin < range.end)
+        {
+            if (range.fence == g_pendingFence.lock())
+            {
+                /* Range has not been submitted yet, so wait for all commands that have been issued so far */
+                WaitForAllCommands();
+            }
+            else
+            {
+                /*
+                Wait for the fence of this range. Fences are signaled in order,
+                so all ranges that have been written before this one are no longer in use either.
+                */
+                range.fence->Wait(std::numeric_limits<GLuint64>::max());
+                pendingRanges_.erase(pendingRanges_.begin(), pendingRanges_.begin() + i + 1);
+            }
+            return;
+        }
+    }
+}
+
+void GLPersistentMapping::WaitForAllCommands()
+{
+    GLFence fence;
+    fence.Submit();
+    fence.Wait(std::numeric_limits<GLuint64>::max());
+
+    /*
+    Only keep the ranges that belong to the pending submission,
+    since they might still be read by commands of deferred command buffers that have not been submitted yet.
+    */
+    auto pendingFence = g_pendingFence.lock();
+
+    pendingRanges_.erase(
+        std::remove_if(
+            pendingRanges_.begin(),
+            pendingRanges_.end(),
+            [&pendingFence](const PendingRange& range)
+            {
+                return (range.fence != pendingFence);
+            }
+        ),
+        pendingRanges_.end()
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,106 @@
+/*
+ * GLPersistentMapping.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PERSISTENT_MAPPING_H
+#define LLGL_GL_PERSISTENT_MAPPING_H
+
+
+#include "../OpenGL.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+class GLFence;
+
+/*
+Persistent mapping of a buffer with immutable storage (see MiscFlags::PersistentMap).
+The buffer is mapped once for its entire lifetime and each map/unmap pair only hands out a pointer into that memory.
+Written ranges are flushed explicitly on unmap and tracked until the GPU has consumed them:
+all ranges that have been written since the last command buffer submission share a single fence,
+which is submitted together with the next command buffer (see GLCommandQueue::Submit).
+Mapping a range only waits if it overlaps with a range the GPU might still be reading.
+*/
+class GLPersistentMapping
+{
+
+    public:
+
+        GLPersistentMapping(const GLPersistentMapping&) = delete;
+        GLPersistentMapping& operator = (const GLPersistentMapping&) = delete;
+
+        // Maps the entire buffer persistently with the specified storage flags (see GL_MAP_PERSISTENT_BIT).
+        GLPersistentMapping(GLBuffer& buffer, GLsizeiptr size, GLbitfield storageFlags);
+
+        // Returns a pointer to the specified range and waits until the GPU has finished reading from it if necessary.
+        void* Map(GLintptr offset, GLsizeiptr length, bool readAccess, bool writeAccess);
+
+        // Flushes the previously mapped range (if it was mapped with write access) and tracks it until the GPU has consumed it.
+        void Unmap();
+
+        // Submits the fence that is shared by all ranges that have been written since the last submission (used by GLCommandQueue).
+        static void SubmitPendingFence();
+
+        // Returns the pointer to the persistently mapped memory or null if mapping the buffer failed.
+        inline void* GetMappedData() const
+        {
+            return mappedData_;
+        }
+
+        // Returns the size (in bytes) of the mapped buffer.
+        inline GLsizeiptr GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        // Range of the buffer that has been written by the CPU and might still be in use by the GPU.
+        struct PendingRange
+        {
+            GLintptr                    begin;
+            GLintptr                    end;
+            std::shared_ptr<GLFence>    fence;
+        };
+
+    private:
+
+        // Waits until the GPU has finished all commands that might read from the specified range.
+        void WaitForRange(GLintptr begin, GLintptr end);
+
+        // Waits until the GPU has finished all commands that have been issued so far.
+        void WaitForAllCommands();
+
+    private:
+
+        GLBuffer&                   buffer_;
+        std::uint8_t*               mappedData_     = nullptr;
+        GLsizeiptr                  size_           = 0;
+        bool                        coherent_       = false;
+
+        GLintptr                    mappedOffset_   = 0;
+        GLsizeiptr                  mappedLength_   = 0;
+        bool                        mappedWrite_    = false;
+
+        std::vector<PendingRange>   pendingRanges_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
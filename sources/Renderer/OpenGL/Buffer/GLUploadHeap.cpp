@@ -0,0 +1,157 @@
+/*
+ * GLUploadHeap.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLUploadHeap.h"
+#include "GLBuffer.h"
+#include "../RenderState/GLFence.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Alignment (in bytes) of each upload within the ring buffer.
+static const GLsizeiptr g_uploadAlignment = 16;
+
+GLUploadHeap::GLUploadHeap()
+{
+}
+
+GLUploadHeap::~GLUploadHeap()
+{
+}
+
+GLUploadHeap& GLUploadHeap::Get()
+{
+    static GLUploadHeap instance;
+    return instance;
+}
+
+void GLUploadHeap::Clear()
+{
+    /* Release ring buffer and fences; the ring buffer is created again with the next upload */
+    if (ringBuffer_)
+    {
+        ringBuffer_->UnmapBuffer();
+        ringBuffer_.reset();
+    }
+
+    for (std::uint32_t i = 0; i < g_numSegments; ++i)
+    {
+        fences_[i].reset();
+        fencesPending_[i] = false;
+    }
+
+    mappedData_     = nullptr;
+    segment_        = 0;
+    segmentOffset_  = 0;
+    unsupported_    = false;
+}
+
+void GLUploadHeap::BufferSubData(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data)
+{
+    if (size < g_minUploadSize || (mappedData_ == nullptr && !CreateRingBuffer()))
+    {
+        /* Fall back to regular buffer update for small uploads or if persistent mapping is not supported */
+        dstBuffer.BufferSubData(dstOffset, size, data);
+        return;
+    }
+
+    auto src = reinterpret_cast<const std::uint8_t*>(data);
+
+    while (size > 0)
+    {
+        /* Move on to the next segment if the current one is full */
+        if (segmentOffset_ >= g_segmentSize)
+            NextSegment();
+
+        /* Write as much data as fits into the current segment directly into the mapped memory */
+        auto chunkSize      = std::min(size, static_cast<GLsizeiptr>(g_segmentSize - segmentOffset_));
+        auto ringOffset     = static_cast<GLintptr>(segment_) * g_segmentSize + segmentOffset_;
+
+        ::memcpy(mappedData_ + ringOffset, src, static_cast<std::size_t>(chunkSize));
+
+        /* Copy data from ring buffer into destination buffer on the GPU timeline */
+        dstBuffer.CopyBufferSubData(*ringBuffer_, ringOffset, dstOffset, chunkSize);
+
+        segmentOffset_  = GetAlignedSize(segmentOffset_ + chunkSize, g_uploadAlignment);
+        src             += chunkSize;
+        dstOffset       += chunkSize;
+        size            -= chunkSize;
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool GLUploadHeap::CreateRingBuffer()
+{
+    if (unsupported_)
+        return false;
+
+    #ifdef LLGL_GLEXT_BUFFER_STORAGE
+    if (HasExtension(GLExt::ARB_buffer_storage)    &&
+        HasExtension(GLExt::ARB_map_buffer_range)  &&
+        HasExtension(GLExt::ARB_copy_buffer)       &&
+        HasExtension(GLExt::ARB_sync))
+    {
+        /* Allocate immutable storage for the entire ring buffer and keep it mapped for its lifetime */
+        const GLsizeiptr    ringSize    = g_segmentSize * g_numSegments;
+        const GLbitfield    flags       = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+        ringBuffer_ = MakeUnique<GLBuffer>(0);
+        ringBuffer_->BufferStorage(ringSize, nullptr, flags, GL_STREAM_DRAW);
+
+        mappedData_ = reinterpret_cast<std::uint8_t*>(ringBuffer_->MapBufferRange(0, ringSize, flags));
+
+        if (mappedData_ != nullptr)
+        {
+            for (std::uint32_t i = 0; i < g_numSegments; ++i)
+                fences_[i] = MakeUnique<GLFence>();
+            return true;
+        }
+
+        /* Release buffer if mapping failed */
+        ringBuffer_.reset();
+    }
+    #endif // /LLGL_GLEXT_BUFFER_STORAGE
+
+    unsupported_ = true;
+    return false;
+}
+
+void GLUploadHeap::NextSegment()
+{
+    /* Submit fence for all copy commands that read from the current segment */
+    fences_[segment_]->Submit();
+    fencesPending_[segment_] = true;
+
+    /* Move on to the next segment and wait until the GPU has finished reading from it */
+    segment_        = (segment_ + 1) % g_numSegments;
+    segmentOffset_  = 0;
+
+    if (fencesPending_[segment_])
+    {
+        fences_[segment_]->Wait(std::numeric_limits<GLuint64>::max());
+        fencesPending_[segment_] = false;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * GLUploadHeap.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_UPLOAD_HEAP_H
+#define LLGL_GL_UPLOAD_HEAP_H
+
+
+#include "../OpenGL.h"
+#include <cstdint>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+class GLFence;
+
+/*
+Singleton ring buffer to stream buffer updates (see UpdateBuffer and WriteBuffer) through persistently mapped memory.
+The data is written directly into the mapped ring buffer and then copied into the destination buffer with glCopyBufferSubData,
+so the driver neither stalls on the destination buffer nor makes another copy of the data.
+The ring buffer is divided into segments that are guarded by a fence each: before the writer enters a segment again,
+it waits until the GPU has finished all copy commands that read from that segment the last time.
+Uploads that are larger than a segment are split into multiple copy commands, so data of any size can be uploaded.
+Uploads that are smaller than 'g_minUploadSize' bypass the ring buffer, because drivers store such small updates inline in their command stream,
+which is cheaper than an additional copy command. If persistent mapping is not supported, the data is uploaded with glBufferSubData instead.
+*/
+class GLUploadHeap
+{
+
+    public:
+
+        // Size (in bytes) of each segment of the ring buffer.
+        static const GLsizeiptr     g_segmentSize   = (1024 * 1024);
+
+        // Number of segments in the ring buffer.
+        static const std::uint32_t  g_numSegments   = 4;
+
+        // Minimum size (in bytes) of uploads that are streamed through the ring buffer. Smaller uploads use glBufferSubData directly.
+        static const GLsizeiptr     g_minUploadSize = 1024;
+
+    public:
+
+        GLUploadHeap(const GLUploadHeap&) = delete;
+        GLUploadHeap& operator = (const GLUploadHeap&) = delete;
+
+        // Returns the instance of this singleton.
+        static GLUploadHeap& Get();
+
+        // Releases the ring buffer and all fences (used by GLRenderSystem).
+        void Clear();
+
+        // Uploads the specified data into the destination buffer. This must only be called on the thread of the GL context.
+        void BufferSubData(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data);
+
+    private:
+
+        GLUploadHeap();
+        ~GLUploadHeap();
+
+        // Creates and maps the ring buffer if persistent mapping is supported. Returns false otherwise.
+        bool CreateRingBuffer();
+
+        // Submits the fence for the current segment and waits for the fence of the next segment.
+        void NextSegment();
+
+    private:
+
+        std::unique_ptr<GLBuffer>   ringBuffer_;
+        std::uint8_t*               mappedData_                   = nullptr;
+        std::unique_ptr<GLFence>    fences_[g_numSegments];
+        bool                        fencesPending_[g_numSegments] = {};
+        std::uint32_t               segment_                      = 0;
+        GLsizeiptr                  segmentOffset_                = 0;
+        bool                        unsupported_                  = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -378,6 +378,23 @@ struct GLCmdMultiDrawElementsIndirect
     GLsizei         stride;
 };
 
+// Layout of the indirect arguments for glDrawElementsIndirect and glMultiDrawElementsIndirect.
+struct GLDrawElementsIndirectCommand
+{
+    GLuint          count;
+    GLuint          instanceCount;
+    GLuint          firstIndex;
+    GLint           baseVertex;
+    GLuint          baseInstance;
+};
+
+struct GLCmdUploadIndirectArgs
+{
+    GLuint          id;
+    GLsizeiptr      size;
+    const GLvoid*   data;
+};
+
 struct GLCmdDispatchCompute
 {
     GLuint numgroups[3];
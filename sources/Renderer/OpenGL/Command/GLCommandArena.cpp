@@ -0,0 +1,147 @@
+/*
+ * GLCommandArena.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandArena.h"
+#include <algorithm>
+#include <new>
+
+
+namespace LLGL
+{
+
+
+GLCommandArena::GLCommandArena(std::size_t pageSize) :
+    pageSize_ { pageSize }
+{
+}
+
+GLCommandArena::~GLCommandArena()
+{
+    for (auto page = first_; page != nullptr;)
+    {
+        auto next = page->next;
+        ::operator delete(page);
+        page = next;
+    }
+}
+
+void GLCommandArena::Clear()
+{
+    /* Reset all used pages, but keep them in the list for the next encoding */
+    if (current_ != nullptr)
+    {
+        for (auto page = first_; page != current_->next; page = page->next)
+            page->size = 0;
+        current_ = first_;
+    }
+}
+
+void GLCommandArena::Reserve(std::size_t size)
+{
+    for (auto capacity = GetCapacity(); capacity < size; capacity += pageSize_)
+    {
+        auto page = AllocPage(pageSize_);
+        if (last_ != nullptr)
+            last_->next = page;
+        else
+            first_ = page;
+        last_ = page;
+    }
+}
+
+std::size_t GLCommandArena::GetSize() const
+{
+    std::size_t size = 0;
+    for (auto page = first_; page != nullptr; page = page->next)
+        size += page->size;
+    return size;
+}
+
+std::size_t GLCommandArena::GetCapacity() const
+{
+    std::size_t capacity = 0;
+    for (auto page = first_; page != nullptr; page = page->next)
+        capacity += page->capacity;
+    return capacity;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandArena::NextPage(std::size_t size)
+{
+    if (current_ == nullptr)
+    {
+        /* Start with first page or allocate the first one */
+        if (first_ == nullptr || first_->capacity < size)
+        {
+            auto page = AllocPage(std::max(pageSize_, size));
+            page->next = first_;
+            first_ = page;
+            if (last_ == nullptr)
+                last_ = page;
+        }
+        current_ = first_;
+    }
+    else if (current_->next != nullptr && current_->next->capacity >= size)
+    {
+        /* Recycle next page that was kept from a previous encoding */
+        current_ = current_->next;
+    }
+    else
+    {
+        /* Search unused pages for an oversized one that was kept from a previous encoding */
+        GLCommandPage* prev = current_->next;
+        GLCommandPage* page = nullptr;
+
+        if (prev != nullptr)
+        {
+            for (; prev->next != nullptr; prev = prev->next)
+            {
+                if (prev->next->capacity >= size)
+                {
+                    /* Unlink page from the list */
+                    page = prev->next;
+                    prev->next = page->next;
+                    if (last_ == page)
+                        last_ = prev;
+                    break;
+                }
+            }
+        }
+
+        /* Insert page after the current one; oversized allocations get a dedicated page */
+        if (page == nullptr)
+            page = AllocPage(std::max(pageSize_, size));
+
+        page->next = current_->next;
+        current_->next = page;
+        if (last_ == current_)
+            last_ = page;
+        current_ = page;
+    }
+}
+
+GLCommandPage* GLCommandArena::AllocPage(std::size_t capacity)
+{
+    auto page = static_cast<GLCommandPage*>(::operator new(sizeof(GLCommandPage) + sizeof(GLCommandHeader) + capacity));
+    {
+        page->next      = nullptr;
+        page->capacity  = capacity;
+        page->size      = 0;
+    }
+    return page;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,125 @@
+/*
+ * GLCommandArena.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_ARENA_H
+#define LLGL_GL_COMMAND_ARENA_H
+
+
+#include "GLCommandOpcode.h"
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Page of the command arena. The command data follows after this header with an offset of sizeof(GLCommandHeader),
+so each command header is followed by a payload that is aligned to g_glCommandAlignment.
+*/
+struct alignas(8) GLCommandPage
+{
+    GLCommandPage*  next;
+    std::size_t     capacity;
+    std::size_t     size;
+
+    // Returns the pointer to the command data of this page.
+    inline std::uint8_t* GetData()
+    {
+        return reinterpret_cast<std::uint8_t*>(this + 1) + sizeof(GLCommandHeader);
+    }
+
+    // Returns the constant pointer to the command data of this page.
+    inline const std::uint8_t* GetData() const
+    {
+        return reinterpret_cast<const std::uint8_t*>(this + 1) + sizeof(GLCommandHeader);
+    }
+};
+
+/*
+Linear allocator for the emulated GL command buffers with a linked list of fixed-size pages.
+Allocations never span multiple pages and never move, so encoding a command is O(1) and no previously recorded command is ever copied.
+Pages are kept when the arena is cleared and recycled for the next encoding, i.e. memory is only returned to the heap when the arena is destroyed.
+Allocations larger than the page size get a dedicated page of sufficient size.
+All allocations must be a multiple of g_glCommandAlignment to keep the command payloads aligned (see GetAlignedGLCommandSize).
+*/
+class GLCommandArena
+{
+
+    public:
+
+        // Default size (in bytes) of each page.
+        static const std::size_t g_defaultPageSize = (64 * 1024);
+
+    public:
+
+        GLCommandArena(std::size_t pageSize = g_defaultPageSize);
+        ~GLCommandArena();
+
+        GLCommandArena(const GLCommandArena&) = delete;
+        GLCommandArena& operator = (const GLCommandArena&) = delete;
+
+        // Allocates the specified number of bytes within the current page, or moves on to the next page if the current page is full.
+        inline void* Alloc(std::size_t size)
+        {
+            if (current_ == nullptr || current_->size + size > current_->capacity)
+                NextPage(size);
+            auto ptr = current_->GetData() + current_->size;
+            current_->size += size;
+            return ptr;
+        }
+
+        // Clears all pages but keeps their memory for reuse.
+        void Clear();
+
+        // Allocates pages until the arena can hold at least the specified number of bytes without further heap allocations.
+        void Reserve(std::size_t size);
+
+        // Returns the number of bytes that are currently allocated within all pages.
+        std::size_t GetSize() const;
+
+        // Returns the total capacity (in bytes) of all pages.
+        std::size_t GetCapacity() const;
+
+        // Returns the first page or null if no page has been allocated yet. Pages without allocations have a size of zero.
+        inline const GLCommandPage* GetFirstPage() const
+        {
+            return first_;
+        }
+
+        // Returns the first page or null if no page has been allocated yet. Commands may be removed from a page by reducing its size.
+        inline GLCommandPage* GetFirstPage()
+        {
+            return first_;
+        }
+
+    private:
+
+        // Moves to the next page that can hold the specified number of bytes, and allocates a new page if necessary.
+        void NextPage(std::size_t size);
+
+        GLCommandPage* AllocPage(std::size_t capacity);
+
+    private:
+
+        std::size_t     pageSize_   = 0;
+        GLCommandPage*  first_      = nullptr;
+        GLCommandPage*  last_       = nullptr;
+        GLCommandPage*  current_    = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
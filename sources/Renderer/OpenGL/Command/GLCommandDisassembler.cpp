@@ -0,0 +1,511 @@
+/*
+ * GLCommandDisassembler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandDisassembler.h"
+#include "GLCommandExecutor.h"
+#include "GLCommandArena.h"
+#include "GLCommand.h"
+#include "../../../Core/HelperMacros.h"
+#include <LLGL/Timer.h>
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+const char* GLOpcodeToString(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        LLGL_CASE_TO_STR( GLOpcodeBufferSubData );
+        LLGL_CASE_TO_STR( GLOpcodeCopyBufferSubData );
+        LLGL_CASE_TO_STR( GLOpcodeClearBufferData );
+        LLGL_CASE_TO_STR( GLOpcodeClearBufferSubData );
+        LLGL_CASE_TO_STR( GLOpcodeCopyImageSubData );
+        LLGL_CASE_TO_STR( GLOpcodeCopyImageToBuffer );
+        LLGL_CASE_TO_STR( GLOpcodeCopyImageFromBuffer );
+        LLGL_CASE_TO_STR( GLOpcodeGenerateMipmap );
+        LLGL_CASE_TO_STR( GLOpcodeGenerateMipmapSubresource );
+        LLGL_CASE_TO_STR( GLOpcodeSetAPIDepState );
+        LLGL_CASE_TO_STR( GLOpcodeExecute );
+        LLGL_CASE_TO_STR( GLOpcodeViewport );
+        LLGL_CASE_TO_STR( GLOpcodeViewportArray );
+        LLGL_CASE_TO_STR( GLOpcodeScissor );
+        LLGL_CASE_TO_STR( GLOpcodeScissorArray );
+        LLGL_CASE_TO_STR( GLOpcodeClearColor );
+        LLGL_CASE_TO_STR( GLOpcodeClearDepth );
+        LLGL_CASE_TO_STR( GLOpcodeClearStencil );
+        LLGL_CASE_TO_STR( GLOpcodeClear );
+        LLGL_CASE_TO_STR( GLOpcodeClearBuffers );
+        LLGL_CASE_TO_STR( GLOpcodeBindVertexArray );
+        LLGL_CASE_TO_STR( GLOpcodeBindGL2XVertexArray );
+        LLGL_CASE_TO_STR( GLOpcodeBindElementArrayBufferToVAO );
+        LLGL_CASE_TO_STR( GLOpcodeBindBufferBase );
+        LLGL_CASE_TO_STR( GLOpcodeBindBuffersBase );
+        LLGL_CASE_TO_STR( GLOpcodeBeginTransformFeedback );
+        LLGL_CASE_TO_STR( GLOpcodeBeginTransformFeedbackNV );
+        LLGL_CASE_TO_STR( GLOpcodeEndTransformFeedback );
+        LLGL_CASE_TO_STR( GLOpcodeEndTransformFeedbackNV );
+        LLGL_CASE_TO_STR( GLOpcodeBindResourceHeap );
+        LLGL_CASE_TO_STR( GLOpcodeBindRenderPass );
+        LLGL_CASE_TO_STR( GLOpcodeBindPipelineState );
+        LLGL_CASE_TO_STR( GLOpcodeSetBlendColor );
+        LLGL_CASE_TO_STR( GLOpcodeSetStencilRef );
+        LLGL_CASE_TO_STR( GLOpcodeSetUniforms );
+        LLGL_CASE_TO_STR( GLOpcodeBeginQuery );
+        LLGL_CASE_TO_STR( GLOpcodeEndQuery );
+        LLGL_CASE_TO_STR( GLOpcodeBeginConditionalRender );
+        LLGL_CASE_TO_STR( GLOpcodeEndConditionalRender );
+        LLGL_CASE_TO_STR( GLOpcodeDrawArrays );
+        LLGL_CASE_TO_STR( GLOpcodeDrawArraysInstanced );
+        LLGL_CASE_TO_STR( GLOpcodeDrawArraysInstancedBaseInstance );
+        LLGL_CASE_TO_STR( GLOpcodeDrawArraysIndirect );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElements );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElementsBaseVertex );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElementsInstanced );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElementsInstancedBaseVertex );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElementsInstancedBaseVertexBaseInstance );
+        LLGL_CASE_TO_STR( GLOpcodeDrawElementsIndirect );
+        LLGL_CASE_TO_STR( GLOpcodeMultiDrawArraysIndirect );
+        LLGL_CASE_TO_STR( GLOpcodeMultiDrawElementsIndirect );
+        LLGL_CASE_TO_STR( GLOpcodeUploadIndirectArgs );
+        LLGL_CASE_TO_STR( GLOpcodeDispatchCompute );
+        LLGL_CASE_TO_STR( GLOpcodeDispatchComputeIndirect );
+        LLGL_CASE_TO_STR( GLOpcodeBindTexture );
+        LLGL_CASE_TO_STR( GLOpcodeBindSampler );
+        LLGL_CASE_TO_STR( GLOpcodeUnbindResources );
+        LLGL_CASE_TO_STR( GLOpcodePushDebugGroup );
+        LLGL_CASE_TO_STR( GLOpcodePopDebugGroup );
+    }
+    return nullptr;
+}
+
+void ExecuteGLCommandStub(const GLOpcode /*opcode*/, const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    // dummy
+}
+
+// Calls the specified function for each command header in the command stream with its offset (in bytes) from the beginning of the stream.
+template <typename TFunc>
+static void ForEachGLCommand(const GLCommandArena& buffer, TFunc func)
+{
+    std::size_t offset = 0;
+    for (auto page = buffer.GetFirstPage(); page != nullptr; page = page->next)
+    {
+        auto pc     = page->GetData();
+        auto pcEnd  = page->GetData() + page->size;
+
+        while (pc < pcEnd)
+        {
+            auto header = reinterpret_cast<const GLCommandHeader*>(pc);
+            func(*header, offset);
+            pc      += header->size;
+            offset  += header->size;
+        }
+    }
+}
+
+void AccumGLCommandStats(const GLCommandArena& buffer, GLCommandStats& stats)
+{
+    ForEachGLCommand(
+        buffer,
+        [&stats](const GLCommandHeader& header, std::size_t /*offset*/)
+        {
+            auto& entry = stats.opcodes[header.opcode];
+            entry.count++;
+            entry.bytes += header.size;
+            stats.numCommands++;
+            stats.numBytes += header.size;
+        }
+    );
+}
+
+// Returns the average number of ticks of an empty measurement with the specified timer.
+static std::uint64_t CalibrateTimerOverhead(Timer& timer)
+{
+    static const std::uint64_t g_numSamples = 1000;
+
+    std::uint64_t ticks = 0;
+    for (std::uint64_t i = 0; i < g_numSamples; ++i)
+    {
+        timer.Start();
+        ticks += timer.Stop();
+    }
+
+    return (ticks / g_numSamples);
+}
+
+void ProfileGLCommands(
+    const GLCommandArena&   buffer,
+    GLStateManager&         stateMngr,
+    GLCommandStats&         stats,
+    std::uint32_t           numIterations,
+    GLCommandExecuteFunc    executeFunc)
+{
+    if (executeFunc == nullptr)
+        executeFunc = ExecuteGLCommand;
+
+    auto timer = Timer::Create();
+    auto timerOverhead = CalibrateTimerOverhead(*timer);
+
+    stats.frequency = timer->GetFrequency();
+
+    for (std::uint32_t i = 0; i < numIterations; ++i)
+    {
+        ForEachGLCommand(
+            buffer,
+            [&](const GLCommandHeader& header, std::size_t /*offset*/)
+            {
+                /* Measure execution time of this command without the overhead of the timer itself */
+                auto opcode = static_cast<GLOpcode>(header.opcode);
+                timer->Start();
+                {
+                    executeFunc(opcode, &header + 1, stateMngr);
+                }
+                auto ticks = timer->Stop();
+                ticks = (ticks > timerOverhead ? ticks - timerOverhead : 0);
+
+                auto& entry = stats.opcodes[opcode];
+                entry.ticks += ticks;
+                stats.ticks += ticks;
+
+                if (i == 0)
+                {
+                    entry.count++;
+                    entry.bytes += header.size;
+                    stats.numCommands++;
+                    stats.numBytes += header.size;
+                }
+            }
+        );
+    }
+}
+
+static void PrintOpcodeName(std::ostream& s, std::uint32_t opcode)
+{
+    if (auto name = GLOpcodeToString(static_cast<GLOpcode>(opcode)))
+        s << name;
+    else
+        s << "<opcode " << opcode << '>';
+}
+
+void PrintGLCommandStats(std::ostream& s, const GLCommandStats& stats, const std::string& title)
+{
+    /* Sort opcodes in descending order of their size */
+    std::vector<std::uint32_t> opcodes;
+    for (std::uint32_t i = 0; i < 256; ++i)
+    {
+        if (stats.opcodes[i].count > 0)
+            opcodes.push_back(i);
+    }
+
+    std::sort(
+        opcodes.begin(),
+        opcodes.end(),
+        [&stats](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (stats.opcodes[lhs].bytes > stats.opcodes[rhs].bytes);
+        }
+    );
+
+    s << "commands:";
+
+    if (!title.empty())
+        s << " \"" << title << '\"';
+
+    s << '\n';
+    s << "  count = " << stats.numCommands << '\n';
+    s << "  bytes = " << stats.numBytes << '\n';
+
+    if (stats.frequency > 0)
+        s << "  time  = " << (static_cast<double>(stats.ticks) * 1000000.0 / stats.frequency) << " us\n";
+
+    if (stats.optimizer.numRemovedCommands > 0)
+        s << "  removed = " << stats.optimizer.numRemovedCommands << " commands, " << stats.optimizer.numRemovedBytes << " bytes\n";
+    if (stats.optimizer.numMergedDrawCommands > 0)
+        s << "  merged  = " << stats.optimizer.numMergedDrawCommands << " draw commands\n";
+
+    for (auto opcode : opcodes)
+    {
+        const auto& entry = stats.opcodes[opcode];
+
+        s << "  ";
+        PrintOpcodeName(s, opcode);
+        s << ": count = " << entry.count << ", bytes = " << entry.bytes;
+
+        if (stats.frequency > 0)
+            s << ", time = " << (static_cast<double>(entry.ticks) * 1000000.0 / stats.frequency) << " us";
+
+        s << '\n';
+    }
+}
+
+static void PrintGLCommandArgs(std::ostream& s, const GLOpcode opcode, const void* pc)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
+            s << "offset=" << cmd->offset << " size=" << cmd->size;
+            break;
+        }
+        case GLOpcodeCopyBufferSubData:
+        {
+            auto cmd = reinterpret_cast<const GLCmdCopyBufferSubData*>(pc);
+            s << "readOffset=" << cmd->readOffset << " writeOffset=" << cmd->writeOffset << " size=" << cmd->size;
+            break;
+        }
+        case GLOpcodeViewport:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
+            s << "x=" << cmd->viewport.x << " y=" << cmd->viewport.y << " width=" << cmd->viewport.width << " height=" << cmd->viewport.height;
+            break;
+        }
+        case GLOpcodeViewportArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+            s << "first=" << cmd->first << " count=" << cmd->count;
+            break;
+        }
+        case GLOpcodeScissor:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
+            s << "x=" << cmd->scissor.x << " y=" << cmd->scissor.y << " width=" << cmd->scissor.width << " height=" << cmd->scissor.height;
+            break;
+        }
+        case GLOpcodeScissorArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+            s << "first=" << cmd->first << " count=" << cmd->count;
+            break;
+        }
+        case GLOpcodeClear:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
+            s << "flags=0x" << std::hex << cmd->flags << std::dec;
+            break;
+        }
+        case GLOpcodeClearBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+            s << "numAttachments=" << cmd->numAttachments;
+            break;
+        }
+        case GLOpcodeBindVertexArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
+            s << "vao=" << cmd->vao;
+            break;
+        }
+        case GLOpcodeBindElementArrayBufferToVAO:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
+            s << "id=" << cmd->id << " indexType16Bits=" << cmd->indexType16Bits;
+            break;
+        }
+        case GLOpcodeBindBufferBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
+            s << "target=" << static_cast<int>(cmd->target) << " index=" << cmd->index << " id=" << cmd->id;
+            break;
+        }
+        case GLOpcodeBindBuffersBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+            s << "target=" << static_cast<int>(cmd->target) << " first=" << cmd->first << " count=" << cmd->count;
+            break;
+        }
+        case GLOpcodeBindResourceHeap:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
+            s << "resourceHeap=" << static_cast<const void*>(cmd->resourceHeap) << " firstSet=" << cmd->firstSet;
+            break;
+        }
+        case GLOpcodeBindPipelineState:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
+            s << "pipelineState=" << static_cast<const void*>(cmd->pipelineState);
+            break;
+        }
+        case GLOpcodeSetStencilRef:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetStencilRef*>(pc);
+            s << "ref=" << cmd->ref << " face=0x" << std::hex << cmd->face << std::dec;
+            break;
+        }
+        case GLOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+            s << "program=" << cmd->program << " location=" << cmd->location << " count=" << cmd->count << " size=" << cmd->size;
+            break;
+        }
+        case GLOpcodeDrawArrays:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << std::dec << " first=" << cmd->first << " count=" << cmd->count;
+            break;
+        }
+        case GLOpcodeDrawArraysInstanced:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << std::dec << " first=" << cmd->first << " count=" << cmd->count;
+            s << " instancecount=" << cmd->instancecount;
+            break;
+        }
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << std::dec << " first=" << cmd->first << " count=" << cmd->count;
+            s << " instancecount=" << cmd->instancecount << " baseinstance=" << cmd->baseinstance;
+            break;
+        }
+        case GLOpcodeDrawElements:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec << " count=" << cmd->count;
+            s << " indices=" << reinterpret_cast<std::uintptr_t>(cmd->indices);
+            break;
+        }
+        case GLOpcodeDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec << " count=" << cmd->count;
+            s << " indices=" << reinterpret_cast<std::uintptr_t>(cmd->indices) << " basevertex=" << cmd->basevertex;
+            break;
+        }
+        case GLOpcodeDrawElementsInstanced:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec << " count=" << cmd->count;
+            s << " indices=" << reinterpret_cast<std::uintptr_t>(cmd->indices) << " instancecount=" << cmd->instancecount;
+            break;
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec << " count=" << cmd->count;
+            s << " indices=" << reinterpret_cast<std::uintptr_t>(cmd->indices) << " instancecount=" << cmd->instancecount;
+            s << " basevertex=" << cmd->basevertex;
+            break;
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+            s << "mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec << " count=" << cmd->count;
+            s << " indices=" << reinterpret_cast<std::uintptr_t>(cmd->indices) << " instancecount=" << cmd->instancecount;
+            s << " basevertex=" << cmd->basevertex << " baseinstance=" << cmd->baseinstance;
+            break;
+        }
+        case GLOpcodeDrawArraysIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
+            s << "id=" << cmd->id << " mode=0x" << std::hex << cmd->mode << std::dec << " indirect=" << cmd->indirect;
+            s << " numCommands=" << cmd->numCommands << " stride=" << cmd->stride;
+            break;
+        }
+        case GLOpcodeDrawElementsIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+            s << "id=" << cmd->id << " mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec;
+            s << " indirect=" << cmd->indirect << " numCommands=" << cmd->numCommands << " stride=" << cmd->stride;
+            break;
+        }
+        case GLOpcodeMultiDrawArraysIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+            s << "id=" << cmd->id << " mode=0x" << std::hex << cmd->mode << std::dec;
+            s << " indirect=" << reinterpret_cast<std::uintptr_t>(cmd->indirect) << " drawcount=" << cmd->drawcount << " stride=" << cmd->stride;
+            break;
+        }
+        case GLOpcodeMultiDrawElementsIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+            s << "id=" << cmd->id << " mode=0x" << std::hex << cmd->mode << " type=0x" << cmd->type << std::dec;
+            s << " indirect=" << reinterpret_cast<std::uintptr_t>(cmd->indirect) << " drawcount=" << cmd->drawcount << " stride=" << cmd->stride;
+            break;
+        }
+        case GLOpcodeUploadIndirectArgs:
+        {
+            auto cmd = reinterpret_cast<const GLCmdUploadIndirectArgs*>(pc);
+            s << "id=" << cmd->id << " size=" << cmd->size;
+            break;
+        }
+        case GLOpcodeDispatchCompute:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+            s << "numgroups=(" << cmd->numgroups[0] << ", " << cmd->numgroups[1] << ", " << cmd->numgroups[2] << ')';
+            break;
+        }
+        case GLOpcodeDispatchComputeIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
+            s << "id=" << cmd->id << " indirect=" << cmd->indirect;
+            break;
+        }
+        case GLOpcodeBindTexture:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
+            s << "slot=" << cmd->slot << " texture=" << static_cast<const void*>(cmd->texture);
+            break;
+        }
+        case GLOpcodeBindSampler:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
+            s << "slot=" << cmd->slot << " sampler=" << cmd->sampler;
+            break;
+        }
+        case GLOpcodeUnbindResources:
+        {
+            auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
+            s << "first=" << cmd->first << " count=" << cmd->count << " resetFlags=0x" << std::hex << static_cast<int>(cmd->resetFlags) << std::dec;
+            break;
+        }
+        case GLOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            s << "name=\"";
+            s.write(reinterpret_cast<const char*>(cmd + 1), cmd->length);
+            s << '\"';
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+void DisassembleGLCommands(std::ostream& s, const GLCommandArena& buffer, const std::string& title)
+{
+    if (!title.empty())
+        s << '\"' << title << "\":\n";
+
+    ForEachGLCommand(
+        buffer,
+        [&s](const GLCommandHeader& header, std::size_t offset)
+        {
+            /* Print offset and size of this command, followed by its opcode name and primary arguments */
+            s << "  0x" << std::hex << std::setfill('0') << std::setw(8) << offset << std::dec << std::setfill(' ');
+            s << " [" << std::setw(4) << header.size << "] ";
+            PrintOpcodeName(s, header.opcode);
+            s << ' ';
+            PrintGLCommandArgs(s, static_cast<GLOpcode>(header.opcode), &header + 1);
+            s << '\n';
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,89 @@
+/*
+ * GLCommandDisassembler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_DISASSEMBLER_H
+#define LLGL_GL_COMMAND_DISASSEMBLER_H
+
+
+#include "GLCommandOpcode.h"
+#include "GLCommandOptimizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+class GLCommandArena;
+class GLStateManager;
+
+// Statistics of all commands with the same opcode.
+struct GLOpcodeStats
+{
+    std::size_t     count   = 0;    // Number of commands.
+    std::size_t     bytes   = 0;    // Size (in bytes) of all commands including their headers.
+    std::uint64_t   ticks   = 0;    // Accumulated execution time (in ticks of 'GLCommandStats::frequency'). Only measured by ProfileGLCommands.
+};
+
+// Histogram of all commands in a command stream, indexed by their opcode.
+struct GLCommandStats
+{
+    GLOpcodeStats   opcodes[256];
+    std::size_t     numCommands = 0;
+    std::size_t     numBytes    = 0;
+    std::uint64_t   ticks       = 0;
+    std::uint64_t   frequency   = 0;    // Ticks per second, or zero if no execution time has been measured.
+    GLCommandOptimizerStats optimizer;  // Commands that have been removed or merged when the command stream was finalized.
+};
+
+// Function interface to execute a single GL command (see ExecuteGLCommand).
+typedef void (*GLCommandExecuteFunc)(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr);
+
+/*
+Stub for GLCommandExecuteFunc that does not execute any command and never calls the GL API.
+This allows ProfileGLCommands to run without a GL context, e.g. to measure the traversal overhead of a command stream in isolation.
+*/
+void ExecuteGLCommandStub(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr);
+
+// Returns the name of the specified opcode (e.g. "GLOpcodeDrawArrays"), or null if the opcode is invalid.
+const char* GLOpcodeToString(const GLOpcode opcode);
+
+// Accumulates the number and size of all commands in the specified command stream.
+void AccumGLCommandStats(const GLCommandArena& buffer, GLCommandStats& stats);
+
+/*
+Executes all commands in the specified command stream 'numIterations' times and accumulates the execution time per opcode
+in addition to the number and size of all commands. The command counters are only accumulated for the first iteration.
+The measured time is only an estimate, since the overhead of the timer is subtracted with a constant that is calibrated before the commands are executed.
+The execution function can be replaced to profile the command stream without a GL context, e.g. with a stubbed state manager.
+*/
+void ProfileGLCommands(
+    const GLCommandArena&   buffer,
+    GLStateManager&         stateMngr,
+    GLCommandStats&         stats,
+    std::uint32_t           numIterations   = 1,
+    GLCommandExecuteFunc    executeFunc     = nullptr
+);
+
+// Prints the histogram of the specified command statistics in descending order of their size.
+void PrintGLCommandStats(std::ostream& s, const GLCommandStats& stats, const std::string& title = "");
+
+// Prints the textual disassembly of all commands in the specified command stream with their offset, size, and primary arguments.
+void DisassembleGLCommands(std::ostream& s, const GLCommandArena& buffer, const std::string& title = "");
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -27,6 +27,7 @@
 
 #include "../Buffer/GLBufferWithVAO.h"
 #include "../Buffer/GLBufferArrayWithVAO.h"
+#include "../Buffer/GLUploadHeap.h"
 
 #include "../RenderState/GLStateManager.h"
 #include "../RenderState/GLPipelineState.h"
@@ -47,75 +48,75 @@ namespace LLGL
 {
 
 
-static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr)
+void ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr)
 {
     switch (opcode)
     {
         case GLOpcodeBufferSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
-            cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
-            return (sizeof(*cmd) + cmd->size);
+            GLUploadHeap::Get().BufferSubData(*(cmd->buffer), cmd->offset, cmd->size, cmd + 1);
+            break;
         }
         case GLOpcodeCopyBufferSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyBufferSubData*>(pc);
             cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClearBufferData:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBufferData*>(pc);
             cmd->buffer->ClearBufferData(cmd->data);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClearBufferSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBufferSubData*>(pc);
             cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeCopyImageSubData:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyImageSubData*>(pc);
             cmd->dstTexture->CopyImageSubData(cmd->dstLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcLevel, cmd->srcOffset, cmd->extent);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeCopyImageToBuffer:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
             cmd->texture->CopyImageToBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeCopyImageFromBuffer:
         {
             auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
             cmd->texture->CopyImageFromBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeGenerateMipmap:
         {
             auto cmd = reinterpret_cast<const GLCmdGenerateMipmap*>(pc);
             GLMipGenerator::Get().GenerateMipsForTexture(stateMngr, *(cmd->texture));
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeGenerateMipmapSubresource:
         {
             auto cmd = reinterpret_cast<const GLCmdGenerateMipmapSubresource*>(pc);
             GLMipGenerator::Get().GenerateMipsRangeForTexture(stateMngr, *(cmd->texture), cmd->baseMipLevel, cmd->numMipLevels, cmd->baseArrayLayer, cmd->numArrayLayers);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeExecute:
         {
             auto cmd = reinterpret_cast<const GLCmdExecute*>(pc);
             ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), stateMngr);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeSetAPIDepState:
         {
             auto cmd = reinterpret_cast<const GLCmdSetAPIDepState*>(pc);
             stateMngr.SetGraphicsAPIDependentState(cmd->desc);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeViewport:
         {
@@ -127,7 +128,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 GLDepthRange depthRange = cmd->depthRange;
                 stateMngr.SetDepthRange(depthRange);
             }
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeViewportArray:
         {
@@ -146,7 +147,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 ::memcpy(depthRanges, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange)*cmd->count);
                 stateMngr.SetDepthRangeArray(cmd->first, cmd->count, depthRanges);
             }
-            return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+            break;
         }
         case GLOpcodeScissor:
         {
@@ -155,7 +156,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 GLScissor scissor = cmd->scissor;
                 stateMngr.SetScissor(scissor);
             }
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeScissorArray:
         {
@@ -166,73 +167,73 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 ::memcpy(scissors, cmdData, sizeof(GLScissor)*cmd->count);
                 stateMngr.SetScissorArray(cmd->first, cmd->count, scissors);
             }
-            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+            break;
         }
         case GLOpcodeClearColor:
         {
             auto cmd = reinterpret_cast<const GLCmdClearColor*>(pc);
             glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClearDepth:
         {
             auto cmd = reinterpret_cast<const GLCmdClearDepth*>(pc);
             GLProfile::ClearDepth(cmd->depth);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClearStencil:
         {
             auto cmd = reinterpret_cast<const GLCmdClearStencil*>(pc);
             glClearStencil(cmd->stencil);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClear:
         {
             auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
             stateMngr.Clear(cmd->flags);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
             stateMngr.ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
             stateMngr.BindVertexArray(cmd->vao);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindGL2XVertexArray:
         {
             auto cmd = reinterpret_cast<const GLCmdBindGL2XVertexArray*>(pc);
             cmd->vertexArrayGL2X->Bind(stateMngr);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindElementArrayBufferToVAO:
         {
             auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
             stateMngr.BindElementArrayBufferToVAO(cmd->id, cmd->indexType16Bits);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindBufferBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
             stateMngr.BindBufferBase(cmd->target, cmd->index, cmd->id);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindBuffersBase:
         {
             auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
             stateMngr.BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
-            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+            break;
         }
         case GLOpcodeBeginTransformFeedback:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedback*>(pc);
             glBeginTransformFeedback(cmd->primitiveMove);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBeginTransformFeedbackNV:
         {
@@ -240,67 +241,67 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef GL_NV_transform_feedback
             glBeginTransformFeedbackNV(cmd->primitiveMove);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeEndTransformFeedback:
         {
             glEndTransformFeedback();
-            return 0;
+            break;
         }
         case GLOpcodeEndTransformFeedbackNV:
         {
             #ifdef GL_NV_transform_feedback
             glEndTransformFeedbackNV();
             #endif
-            return 0;
+            break;
         }
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
             cmd->resourceHeap->Bind(stateMngr, cmd->firstSet);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindRenderPass:
         {
             auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
             stateMngr.BindRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1), cmd->defaultClearValue);
-            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+            break;
         }
         case GLOpcodeBindPipelineState:
         {
             auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
             cmd->pipelineState->Bind(stateMngr);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeSetBlendColor:
         {
             auto cmd = reinterpret_cast<const GLCmdSetBlendColor*>(pc);
             stateMngr.SetBlendColor(cmd->color);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeSetStencilRef:
         {
             auto cmd = reinterpret_cast<const GLCmdSetStencilRef*>(pc);
             stateMngr.SetStencilRef(cmd->ref, cmd->face);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeSetUniforms:
         {
             auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
             GLSetUniformsByLocation(cmd->program, cmd->location, cmd->count, (cmd + 1));
-            return (sizeof(*cmd) + cmd->size);
+            break;
         }
         case GLOpcodeBeginQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
             cmd->queryHeap->Begin(cmd->query);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeEndQuery:
         {
             auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
             cmd->queryHeap->End(cmd->query);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBeginConditionalRender:
         {
@@ -308,26 +309,26 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             glBeginConditionalRender(cmd->id, cmd->mode);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeEndConditionalRender:
         {
             #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             glEndConditionalRender();
             #endif
-            return 0;
+            break;
         }
         case GLOpcodeDrawArrays:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
             glDrawArrays(cmd->mode, cmd->first, cmd->count);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawArraysInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
             glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
@@ -335,7 +336,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_BASE_INSTANCE
             glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawArraysIndirect:
         {
@@ -349,13 +350,13 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 offset += cmd->stride;
             }
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElements:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
             glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElementsBaseVertex:
         {
@@ -363,13 +364,13 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
             glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElementsInstanced:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
             glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
@@ -377,7 +378,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
             glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
         {
@@ -385,7 +386,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_BASE_INSTANCE
             glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDrawElementsIndirect:
         {
@@ -399,7 +400,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 offset += cmd->stride;
             }
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeMultiDrawArraysIndirect:
         {
@@ -408,7 +409,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
@@ -417,7 +418,20 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
             #endif
-            return sizeof(*cmd);
+            break;
+        }
+        case GLOpcodeUploadIndirectArgs:
+        {
+            auto cmd = reinterpret_cast<const GLCmdUploadIndirectArgs*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+            if (cmd->size > 0)
+            {
+                /* Re-specify entire data store to avoid synchronization with previous submissions */
+                stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+                glBufferData(GL_DRAW_INDIRECT_BUFFER, cmd->size, cmd->data, GL_STREAM_DRAW);
+            }
+            #endif
+            break;
         }
         case GLOpcodeDispatchCompute:
         {
@@ -425,7 +439,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_COMPUTE_SHADER
             glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeDispatchComputeIndirect:
         {
@@ -434,20 +448,20 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr.BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
             glDispatchComputeIndirect(cmd->indirect);
             #endif
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
             stateMngr.ActiveTexture(cmd->slot);
             stateMngr.BindGLTexture(*(cmd->texture));
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeBindSampler:
         {
             auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
             stateMngr.BindSampler(cmd->slot, cmd->sampler);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodeUnbindResources:
         {
@@ -464,7 +478,7 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
                 stateMngr.UnbindImageTextures(cmd->first, cmd->count);
             if (cmd->resetSamplers)
                 stateMngr.UnbindSamplers(cmd->first, cmd->count);
-            return sizeof(*cmd);
+            break;
         }
         case GLOpcodePushDebugGroup:
         {
@@ -472,36 +486,35 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #ifdef LLGL_GLEXT_DEBUG
             glPushDebugGroup(cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
             #endif
-            return (sizeof(*cmd) + cmd->length + 1);
+            break;
         }
         case GLOpcodePopDebugGroup:
         {
             #ifdef LLGL_GLEXT_DEBUG
             glPopDebugGroup();
             #endif
-            return 0;
+            break;
         }
         default:
-            return 0;
+            break;
     }
 }
 
-static void ExecuteGLCommandsEmulated(const std::vector<std::uint8_t>& rawBuffer, GLStateManager& stateMngr)
+static void ExecuteGLCommandsEmulated(const GLCommandArena& rawBuffer, GLStateManager& stateMngr)
 {
-    /* Initialize program counter to execute virtual GL commands */
-    auto pc     = rawBuffer.data();
-    auto pcEnd  = rawBuffer.data() + rawBuffer.size();
-
-    GLOpcode opcode;
-
-    while (pc < pcEnd)
+    for (auto page = rawBuffer.GetFirstPage(); page != nullptr; page = page->next)
     {
-        /* Read opcode */
-        opcode = *reinterpret_cast<const GLOpcode*>(pc);
-        pc += sizeof(GLOpcode);
+        /* Initialize program counter to execute virtual GL commands of this page */
+        auto pc     = page->GetData();
+        auto pcEnd  = page->GetData() + page->size;
 
-        /* Execute command and increment program counter */
-        pc += ExecuteGLCommand(opcode, pc, stateMngr);
+        while (pc < pcEnd)
+        {
+            /* Read command header, execute command, and increment program counter by the size from the header */
+            auto header = reinterpret_cast<const GLCommandHeader*>(pc);
+            ExecuteGLCommand(static_cast<GLOpcode>(header->opcode), header + 1, stateMngr);
+            pc += header->size;
+        }
     }
 }
 
@@ -518,7 +531,7 @@ static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& st
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
     #ifdef LLGL_ENABLE_JIT_COMPILER
-    if (auto exec = cmdBuffer.GetExecutable().get())
+    if (auto exec = cmdBuffer.GetExecutable())
     {
         /* Execute GL commands with native executable */
         ExecuteGLCommandsNatively(*exec, stateMngr);
@@ -9,6 +9,9 @@
 #define LLGL_GL_COMMAND_EXECUTOR_H
 
 
+#include "GLCommandOpcode.h"
+
+
 namespace LLGL
 {
 
@@ -17,6 +20,9 @@ class GLStateManager;
 class GLCommandBuffer;
 class GLDeferredCommandBuffer;
 
+// Executes the single GL command with the specified opcode. 'pc' points to the command payload that follows the command header.
+void ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr);
+
 /*
 Executes all GL commands that have been recorded in the specified command buffer.
 GL render states are tracked with the specified state manager.
@@ -9,6 +9,7 @@
 #define LLGL_GL_COMMAND_OPCODE_H
 
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -69,6 +70,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawElementsIndirect,
     GLOpcodeMultiDrawArraysIndirect,
     GLOpcodeMultiDrawElementsIndirect,
+    GLOpcodeUploadIndirectArgs,
     GLOpcodeDispatchCompute,
     GLOpcodeDispatchComputeIndirect,
     GLOpcodeBindTexture,
@@ -78,6 +80,28 @@ enum GLOpcode : std::uint8_t
     GLOpcodePopDebugGroup,
 };
 
+/*
+Header of each command in the command stream. The command structure (i.e. the payload) immediately follows the header and is 8-byte aligned.
+The size is a multiple of 8 and includes the header, so the next header is always located at 'header + size' regardless of the opcode.
+*/
+struct GLCommandHeader
+{
+    std::uint32_t opcode    : 8;
+    std::uint32_t size      : 24;
+};
+
+// Alignment (in bytes) of each command payload in the command stream.
+static const std::size_t    g_glCommandAlignment    = 8;
+
+// Maximum size (in bytes) of a single command including its header.
+static const std::size_t    g_glMaxCommandSize      = ((1u << 24) - g_glCommandAlignment);
+
+// Returns the size of a command with the specified payload size, aligned such that the next header is followed by an aligned payload again.
+inline std::size_t GetAlignedGLCommandSize(std::size_t payloadSize)
+{
+    return ((sizeof(GLCommandHeader) + payloadSize + g_glCommandAlignment - 1) & ~(g_glCommandAlignment - 1));
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,731 @@
+/*
+ * GLCommandOptimizer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommandArena.h"
+
+#include "../Texture/GLTexture.h"
+#include "../RenderState/GLGraphicsPSO.h"
+#include "../RenderState/GLResourceHeap.h"
+
+#include <unordered_map>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Opcode for commands that have been marked for removal (the GLOpcode enumeration starts at 1).
+static const std::uint32_t g_glOpcodeRemoved = 0;
+
+// State categories that are tracked by the command optimizer. Each state is identified by its category and a slot within that category.
+enum GLStateKind : std::uint64_t
+{
+    GLStateKindPipelineState = 0,
+    GLStateKindResourceHeap,
+    GLStateKindVertexArray,
+    GLStateKindViewport,
+    GLStateKindScissor,
+    GLStateKindBlendColor,
+    GLStateKindBufferBase,
+    GLStateKindTexture,
+    GLStateKindSampler,
+};
+
+struct GLStateEntry
+{
+    GLCommandHeader*        pending = nullptr;  // Last binding command that has not been consumed by a draw or dispatch command yet.
+    const GLCommandHeader*  known   = nullptr;  // Last binding command that determines the current state, or null if the state is unknown.
+    const GLCommandHeader*  base    = nullptr;  // Binding command that determined the state before the pending command, or null if the state is unknown.
+};
+
+template <typename T>
+T* GetCommandPayload(GLCommandHeader* header)
+{
+    return reinterpret_cast<T*>(header + 1);
+}
+
+template <typename T>
+const T* GetCommandPayload(const GLCommandHeader* header)
+{
+    return reinterpret_cast<const T*>(header + 1);
+}
+
+// Returns true if both commands have the same opcode and their first 'size' bytes of payload are equal.
+static bool CompareCommandPayload(const GLCommandHeader* lhs, const GLCommandHeader* rhs, std::size_t size)
+{
+    return (lhs->opcode == rhs->opcode && ::memcmp(lhs + 1, rhs + 1, size) == 0);
+}
+
+static std::size_t GetViewportCommandPayloadSize(const GLCommandHeader* header)
+{
+    if (header->opcode == GLOpcodeViewportArray)
+    {
+        auto cmd = GetCommandPayload<GLCmdViewportArray>(header);
+        return (sizeof(GLCmdViewportArray) + static_cast<std::size_t>(cmd->count) * (sizeof(GLViewport) + sizeof(GLDepthRange)));
+    }
+    return sizeof(GLCmdViewport);
+}
+
+static std::size_t GetScissorCommandPayloadSize(const GLCommandHeader* header)
+{
+    if (header->opcode == GLOpcodeScissorArray)
+    {
+        auto cmd = GetCommandPayload<GLCmdScissorArray>(header);
+        return (sizeof(GLCmdScissorArray) + static_cast<std::size_t>(cmd->count) * sizeof(GLScissor));
+    }
+    return sizeof(GLCmdScissor);
+}
+
+// Returns true if the viewport or scissor range of the array command 'lhs' is a subset of the range of 'rhs'.
+template <typename TArrayCmd>
+bool IsArrayRangeCovered(const GLCommandHeader* lhs, const GLCommandHeader* rhs)
+{
+    auto lhsCmd = GetCommandPayload<TArrayCmd>(lhs);
+    auto rhsCmd = GetCommandPayload<TArrayCmd>(rhs);
+    return
+    (
+        lhsCmd->first >= rhsCmd->first &&
+        lhsCmd->first + static_cast<GLuint>(lhsCmd->count) <= rhsCmd->first + static_cast<GLuint>(rhsCmd->count)
+    );
+}
+
+static bool HasResidualStates(const GLPipelineState& pipelineState)
+{
+    return (pipelineState.IsGraphicsPSO() && static_cast<const GLGraphicsPSO&>(pipelineState).HasResidualStates());
+}
+
+/*
+Returns true if binding PSO 'rhs' resets all states that are set by binding PSO 'lhs'.
+A graphics PSO must be followed by another graphics PSO and must not have any residual state (e.g. static viewports).
+*/
+static bool IsPipelineStateOverwritten(const GLPipelineState& lhs, const GLPipelineState& rhs)
+{
+    return (lhs.IsGraphicsPSO() == rhs.IsGraphicsPSO() && !HasResidualStates(lhs));
+}
+
+// Returns true if the specified command consumes the current binding state (e.g. draw commands), but does not modify it.
+static bool IsStateConsumerCommand(std::uint32_t opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        case GLOpcodeClearStencil:
+        case GLOpcodeClear:
+        case GLOpcodeClearBuffers:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeSetUniforms:
+        case GLOpcodeBeginQuery:
+        case GLOpcodeEndQuery:
+        case GLOpcodeBeginConditionalRender:
+        case GLOpcodeEndConditionalRender:
+        case GLOpcodeDrawArrays:
+        case GLOpcodeDrawArraysInstanced:
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        case GLOpcodeDrawArraysIndirect:
+        case GLOpcodeDrawElements:
+        case GLOpcodeDrawElementsBaseVertex:
+        case GLOpcodeDrawElementsInstanced:
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        case GLOpcodeDrawElementsIndirect:
+        case GLOpcodeMultiDrawArraysIndirect:
+        case GLOpcodeMultiDrawElementsIndirect:
+        case GLOpcodeDispatchCompute:
+        case GLOpcodeDispatchComputeIndirect:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+Tracks the binding states of a command stream. Each binding command is either removed immediately if it leaves the state unchanged,
+or it replaces the pending binding command of the same state, which is then removed if it has not been consumed yet.
+Any command that is not known to the optimizer invalidates all states, so the optimization is always conservative.
+*/
+class GLRedundantStateFilter
+{
+
+    public:
+
+        void Filter(GLCommandHeader* header)
+        {
+            switch (header->opcode)
+            {
+                case GLOpcodeBindPipelineState:
+                {
+                    auto cmd = GetCommandPayload<GLCmdBindPipelineState>(header);
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindPipelineState),
+                        header,
+                        [cmd](const GLCommandHeader* known)
+                        {
+                            return (GetCommandPayload<GLCmdBindPipelineState>(known)->pipelineState == cmd->pipelineState);
+                        },
+                        [cmd](const GLCommandHeader* pending)
+                        {
+                            return IsPipelineStateOverwritten(*GetCommandPayload<GLCmdBindPipelineState>(pending)->pipelineState, *cmd->pipelineState);
+                        }
+                    );
+                    if (changed && HasResidualStates(*cmd->pipelineState))
+                    {
+                        /* Graphics PSOs can set static viewports, scissors, and blend color */
+                        InvalidateKnownState(GLStateKindViewport);
+                        InvalidateKnownState(GLStateKindScissor);
+                        InvalidateKnownState(GLStateKindBlendColor);
+                    }
+                }
+                break;
+
+                case GLOpcodeBindResourceHeap:
+                {
+                    auto cmd = GetCommandPayload<GLCmdBindResourceHeap>(header);
+                    auto isSameHeap = [cmd](const GLCommandHeader* other)
+                    {
+                        auto otherCmd = GetCommandPayload<GLCmdBindResourceHeap>(other);
+                        return (otherCmd->resourceHeap == cmd->resourceHeap && otherCmd->firstSet == cmd->firstSet);
+                    };
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindResourceHeap),
+                        header,
+                        [cmd, &isSameHeap](const GLCommandHeader* known)
+                        {
+                            /* Re-binding a resource heap with memory barriers is never redundant */
+                            return (!cmd->resourceHeap->HasBarriers() && isSameHeap(known));
+                        },
+                        isSameHeap
+                    );
+                    if (changed)
+                    {
+                        InvalidateKnownStates(GLStateKindBufferBase);
+                        InvalidateKnownStates(GLStateKindTexture);
+                        InvalidateKnownStates(GLStateKindSampler);
+                    }
+                }
+                break;
+
+                case GLOpcodeBindVertexArray:
+                {
+                    auto cmd = GetCommandPayload<GLCmdBindVertexArray>(header);
+                    FilterState(
+                        GetEntry(GLStateKindVertexArray),
+                        header,
+                        [cmd](const GLCommandHeader* known)
+                        {
+                            return (GetCommandPayload<GLCmdBindVertexArray>(known)->vao == cmd->vao);
+                        },
+                        [](const GLCommandHeader*)
+                        {
+                            return true;
+                        }
+                    );
+                }
+                break;
+
+                case GLOpcodeViewport:
+                case GLOpcodeViewportArray:
+                {
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindViewport),
+                        header,
+                        [header](const GLCommandHeader* known)
+                        {
+                            return CompareCommandPayload(known, header, GetViewportCommandPayloadSize(header));
+                        },
+                        [header](const GLCommandHeader* pending)
+                        {
+                            /* Only replace commands of the same type, since glViewport does not only affect the first viewport */
+                            if (pending->opcode != header->opcode)
+                                return false;
+                            return (header->opcode == GLOpcodeViewport || IsArrayRangeCovered<GLCmdViewportArray>(pending, header));
+                        }
+                    );
+                    if (changed)
+                        InvalidateKnownPipelineStateWithResidualStates();
+                }
+                break;
+
+                case GLOpcodeScissor:
+                case GLOpcodeScissorArray:
+                {
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindScissor),
+                        header,
+                        [header](const GLCommandHeader* known)
+                        {
+                            return CompareCommandPayload(known, header, GetScissorCommandPayloadSize(header));
+                        },
+                        [header](const GLCommandHeader* pending)
+                        {
+                            if (pending->opcode != header->opcode)
+                                return false;
+                            return (header->opcode == GLOpcodeScissor || IsArrayRangeCovered<GLCmdScissorArray>(pending, header));
+                        }
+                    );
+                    if (changed)
+                        InvalidateKnownPipelineStateWithResidualStates();
+                }
+                break;
+
+                case GLOpcodeSetBlendColor:
+                {
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindBlendColor),
+                        header,
+                        [header](const GLCommandHeader* known)
+                        {
+                            return CompareCommandPayload(known, header, sizeof(GLCmdSetBlendColor));
+                        },
+                        [](const GLCommandHeader*)
+                        {
+                            return true;
+                        }
+                    );
+                    if (changed)
+                        InvalidateKnownPipelineStateWithResidualStates();
+                }
+                break;
+
+                case GLOpcodeBindBufferBase:
+                {
+                    auto cmd = GetCommandPayload<GLCmdBindBufferBase>(header);
+                    const auto slot = ((static_cast<std::uint64_t>(cmd->target) << 32) | cmd->index);
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindBufferBase, slot),
+                        header,
+                        [cmd](const GLCommandHeader* known)
+                        {
+                            return (GetCommandPayload<GLCmdBindBufferBase>(known)->id == cmd->id);
+                        },
+                        [](const GLCommandHeader*)
+                        {
+                            return true;
+                        }
+                    );
+                    if (changed)
+                        InvalidateKnownState(GLStateKindResourceHeap);
+                }
+                break;
+
+                case GLOpcodeBindTexture:
+                {
+                    /* Binding a texture also selects the active texture unit, so it is only removed when it is overwritten for the same texture type */
+                    auto cmd = GetCommandPayload<GLCmdBindTexture>(header);
+                    const auto slot = ((static_cast<std::uint64_t>(cmd->texture->GetType()) << 32) | cmd->slot);
+                    FilterState(
+                        GetEntry(GLStateKindTexture, slot),
+                        header,
+                        [](const GLCommandHeader*)
+                        {
+                            return false;
+                        },
+                        [](const GLCommandHeader*)
+                        {
+                            return true;
+                        }
+                    );
+                    InvalidateKnownState(GLStateKindResourceHeap);
+                }
+                break;
+
+                case GLOpcodeBindSampler:
+                {
+                    auto cmd = GetCommandPayload<GLCmdBindSampler>(header);
+                    const bool changed = FilterState(
+                        GetEntry(GLStateKindSampler, cmd->slot),
+                        header,
+                        [cmd](const GLCommandHeader* known)
+                        {
+                            return (GetCommandPayload<GLCmdBindSampler>(known)->sampler == cmd->sampler);
+                        },
+                        [](const GLCommandHeader*)
+                        {
+                            return true;
+                        }
+                    );
+                    if (changed)
+                        InvalidateKnownState(GLStateKindResourceHeap);
+                }
+                break;
+
+                default:
+                {
+                    /* Keep all pending binding commands, and forget about all states if the command is unknown to the optimizer */
+                    CommitPendingStates();
+                    if (!IsStateConsumerCommand(header->opcode))
+                        InvalidateAllKnownStates();
+                }
+                break;
+            }
+        }
+
+    private:
+
+        GLStateEntry& GetEntry(GLStateKind kind, std::uint64_t slot = 0)
+        {
+            return states_[MakeKey(kind, slot)];
+        }
+
+        static std::uint64_t MakeKey(GLStateKind kind, std::uint64_t slot)
+        {
+            return ((static_cast<std::uint64_t>(kind) << 56) | slot);
+        }
+
+        static GLStateKind GetKind(std::uint64_t key)
+        {
+            return static_cast<GLStateKind>(key >> 56);
+        }
+
+        // Filters the specified binding command and returns true if it was not removed, i.e. the state might have changed.
+        template <typename TIsUnchangedFunc, typename TIsOverwrittenFunc>
+        bool FilterState(
+            GLStateEntry&               entry,
+            GLCommandHeader*            header,
+            const TIsUnchangedFunc&     isUnchanged,
+            const TIsOverwrittenFunc&   isOverwritten)
+        {
+            if (entry.known != nullptr && isUnchanged(entry.known))
+            {
+                /* Remove binding command that leaves the state unchanged */
+                header->opcode = g_glOpcodeRemoved;
+                return false;
+            }
+
+            if (entry.pending != nullptr && isOverwritten(entry.pending))
+            {
+                /* Remove previous binding command that has not been consumed yet */
+                entry.pending->opcode = g_glOpcodeRemoved;
+
+                /* Also remove the new binding command if it restores the state from before the removed command */
+                if (entry.base != nullptr && isUnchanged(entry.base))
+                {
+                    header->opcode  = g_glOpcodeRemoved;
+                    entry.pending   = nullptr;
+                    entry.known     = entry.base;
+                    return false;
+                }
+            }
+            else
+            {
+                if (entry.pending == nullptr)
+                    pendingEntries_.push_back(&entry);
+                entry.base = entry.known;
+            }
+
+            entry.pending   = header;
+            entry.known     = header;
+
+            return true;
+        }
+
+        static void InvalidateEntry(GLStateEntry& entry)
+        {
+            entry.known = nullptr;
+            entry.base  = nullptr;
+        }
+
+        void CommitPendingStates()
+        {
+            for (auto entry : pendingEntries_)
+                entry->pending = nullptr;
+            pendingEntries_.clear();
+        }
+
+        void InvalidateKnownState(GLStateKind kind)
+        {
+            auto it = states_.find(MakeKey(kind, 0));
+            if (it != states_.end())
+                InvalidateEntry(it->second);
+        }
+
+        // Invalidates the known PSO if it sets static viewports, scissors, or blend color, since binding it again would reset these states.
+        void InvalidateKnownPipelineStateWithResidualStates()
+        {
+            auto it = states_.find(MakeKey(GLStateKindPipelineState, 0));
+            if (it != states_.end() && it->second.known != nullptr)
+            {
+                if (HasResidualStates(*GetCommandPayload<GLCmdBindPipelineState>(it->second.known)->pipelineState))
+                    InvalidateEntry(it->second);
+            }
+        }
+
+        void InvalidateKnownStates(GLStateKind kind)
+        {
+            for (auto& state : states_)
+            {
+                if (GetKind(state.first) == kind)
+                    InvalidateEntry(state.second);
+            }
+        }
+
+        void InvalidateAllKnownStates()
+        {
+            for (auto& state : states_)
+                InvalidateEntry(state.second);
+        }
+
+    private:
+
+        std::unordered_map<std::uint64_t, GLStateEntry> states_;
+        std::vector<GLStateEntry*>                      pendingEntries_;
+
+};
+
+
+// Removes all commands that have been marked for removal and compacts the pages.
+// The alignment of the remaining commands is retained since all command sizes are a multiple of the alignment.
+static void CompactGLCommands(GLCommandArena& buffer, GLCommandOptimizerStats& stats)
+{
+    for (auto page = buffer.GetFirstPage(); page != nullptr; page = page->next)
+    {
+        auto data = page->GetData();
+        std::size_t dstOffset = 0;
+
+        for (std::size_t srcOffset = 0; srcOffset < page->size;)
+        {
+            auto header = reinterpret_cast<const GLCommandHeader*>(data + srcOffset);
+            const std::size_t size = header->size;
+
+            if (header->opcode == g_glOpcodeRemoved)
+            {
+                stats.numRemovedCommands++;
+                stats.numRemovedBytes += size;
+            }
+            else
+            {
+                if (dstOffset != srcOffset)
+                    ::memmove(data + dstOffset, data + srcOffset, size);
+                dstOffset += size;
+            }
+
+            srcOffset += size;
+        }
+
+        page->size = dstOffset;
+    }
+}
+
+static GLuint GetIndexTypeSize(GLenum type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_BYTE:  return 1;
+        case GL_UNSIGNED_SHORT: return 2;
+        case GL_UNSIGNED_INT:   return 4;
+        default:                return 0;
+    }
+}
+
+template <typename TDrawCmd>
+void GetDrawElementsArgs(const TDrawCmd& cmd, GLenum& mode, GLenum& type, GLintptr& indices, GLDrawElementsIndirectCommand& args)
+{
+    mode            = cmd.mode;
+    type            = cmd.type;
+    indices         = reinterpret_cast<GLintptr>(cmd.indices);
+    args.count      = static_cast<GLuint>(cmd.count);
+}
+
+/*
+Converts the specified indexed draw command into indirect arguments and returns true on success.
+Returns false if the command is not an indexed draw command or its index offset is not a multiple of the index type size.
+*/
+static bool ConvertToDrawElementsIndirect(const GLCommandHeader* header, GLenum& mode, GLenum& type, GLDrawElementsIndirectCommand& args)
+{
+    GLintptr indices = 0;
+
+    args.instanceCount  = 1;
+    args.baseVertex     = 0;
+    args.baseInstance   = 0;
+
+    switch (header->opcode)
+    {
+        case GLOpcodeDrawElements:
+        {
+            auto cmd = GetCommandPayload<GLCmdDrawElements>(header);
+            GetDrawElementsArgs(*cmd, mode, type, indices, args);
+        }
+        break;
+
+        case GLOpcodeDrawElementsBaseVertex:
+        {
+            auto cmd = GetCommandPayload<GLCmdDrawElementsBaseVertex>(header);
+            GetDrawElementsArgs(*cmd, mode, type, indices, args);
+            args.baseVertex     = cmd->basevertex;
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstanced:
+        {
+            auto cmd = GetCommandPayload<GLCmdDrawElementsInstanced>(header);
+            GetDrawElementsArgs(*cmd, mode, type, indices, args);
+            args.instanceCount  = static_cast<GLuint>(cmd->instancecount);
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        {
+            auto cmd = GetCommandPayload<GLCmdDrawElementsInstancedBaseVertex>(header);
+            GetDrawElementsArgs(*cmd, mode, type, indices, args);
+            args.instanceCount  = static_cast<GLuint>(cmd->instancecount);
+            args.baseVertex     = cmd->basevertex;
+        }
+        break;
+
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        {
+            auto cmd = GetCommandPayload<GLCmdDrawElementsInstancedBaseVertexBaseInstance>(header);
+            GetDrawElementsArgs(*cmd, mode, type, indices, args);
+            args.instanceCount  = static_cast<GLuint>(cmd->instancecount);
+            args.baseVertex     = cmd->basevertex;
+            args.baseInstance   = cmd->baseinstance;
+        }
+        break;
+
+        default:
+            return false;
+    }
+
+    /* Indirect draw commands can only specify the first index rather than a byte offset */
+    const auto indexSize = GetIndexTypeSize(type);
+    if (indexSize == 0 || indices % indexSize != 0)
+        return false;
+
+    args.firstIndex = static_cast<GLuint>(indices / indexSize);
+
+    return true;
+}
+
+
+/*
+ * Global functions
+ */
+
+GLCommandOptimizerStats RemoveRedundantGLCommands(GLCommandArena& buffer)
+{
+    GLCommandOptimizerStats stats;
+
+    /* Mark all redundant commands for removal */
+    GLRedundantStateFilter filter;
+
+    for (auto page = buffer.GetFirstPage(); page != nullptr; page = page->next)
+    {
+        for (std::size_t offset = 0; offset < page->size;)
+        {
+            auto header = reinterpret_cast<GLCommandHeader*>(page->GetData() + offset);
+            filter.Filter(header);
+            offset += header->size;
+        }
+    }
+
+    CompactGLCommands(buffer, stats);
+
+    return stats;
+}
+
+GLCommandOptimizerStats MergeGLDrawCommands(GLCommandArena& buffer, GLuint indirectBufferID, std::vector<GLDrawElementsIndirectCommand>& indirectArgs)
+{
+    static const std::size_t multiDrawCmdSize = GetAlignedGLCommandSize(sizeof(GLCmdMultiDrawElementsIndirect));
+
+    GLCommandOptimizerStats stats;
+
+    for (auto page = buffer.GetFirstPage(); page != nullptr; page = page->next)
+    {
+        auto data = page->GetData();
+
+        for (std::size_t offset = 0; offset < page->size;)
+        {
+            auto                            header  = reinterpret_cast<GLCommandHeader*>(data + offset);
+            GLenum                          mode    = 0;
+            GLenum                          type    = 0;
+            GLDrawElementsIndirectCommand   args;
+
+            if (!ConvertToDrawElementsIndirect(header, mode, type, args))
+            {
+                offset += header->size;
+                continue;
+            }
+
+            /* Gather consecutive draw commands with the same primitive and index type; runs never cross page boundaries */
+            const auto  firstArg    = indirectArgs.size();
+            std::size_t runEnd      = offset + header->size;
+
+            indirectArgs.push_back(args);
+
+            while (runEnd < page->size)
+            {
+                auto    nextHeader  = reinterpret_cast<const GLCommandHeader*>(data + runEnd);
+                GLenum  nextMode    = 0;
+                GLenum  nextType    = 0;
+
+                if (!ConvertToDrawElementsIndirect(nextHeader, nextMode, nextType, args) || nextMode != mode || nextType != type)
+                    break;
+
+                indirectArgs.push_back(args);
+                runEnd += nextHeader->size;
+            }
+
+            const auto numDraws = indirectArgs.size() - firstArg;
+            if (numDraws >= 2)
+            {
+                /*
+                Replace the run by a single multi-draw command followed by a gap that is removed during compaction.
+                Each draw command has a size of at least 32 bytes, so two of them always leave room for the gap header.
+                */
+                header->opcode  = GLOpcodeMultiDrawElementsIndirect;
+                header->size    = static_cast<std::uint32_t>(multiDrawCmdSize);
+
+                auto cmd = GetCommandPayload<GLCmdMultiDrawElementsIndirect>(header);
+                {
+                    cmd->id         = indirectBufferID;
+                    cmd->mode       = mode;
+                    cmd->type       = type;
+                    cmd->indirect   = reinterpret_cast<const GLvoid*>(firstArg * sizeof(GLDrawElementsIndirectCommand));
+                    cmd->drawcount  = static_cast<GLsizei>(numDraws);
+                    cmd->stride     = static_cast<GLsizei>(sizeof(GLDrawElementsIndirectCommand));
+                }
+
+                auto gap = reinterpret_cast<GLCommandHeader*>(data + offset + multiDrawCmdSize);
+                {
+                    gap->opcode = g_glOpcodeRemoved;
+                    gap->size   = static_cast<std::uint32_t>(runEnd - offset - multiDrawCmdSize);
+                }
+
+                stats.numMergedDrawCommands += numDraws;
+            }
+            else
+                indirectArgs.resize(firstArg);
+
+            offset = runEnd;
+        }
+    }
+
+    /* Remove the gaps; each gap counts as one removed command, but replaces all except one of the merged draw commands */
+    GLCommandOptimizerStats compactStats;
+    CompactGLCommands(buffer, compactStats);
+
+    stats.numRemovedCommands    = stats.numMergedDrawCommands - compactStats.numRemovedCommands;
+    stats.numRemovedBytes       = compactStats.numRemovedBytes;
+
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,53 @@
+/*
+ * GLCommandOptimizer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include "GLCommand.h"
+#include <cstddef>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLCommandArena;
+
+// Statistics of the commands that have been removed or merged by the command optimizer.
+struct GLCommandOptimizerStats
+{
+    std::size_t numRemovedCommands      = 0;
+    std::size_t numRemovedBytes         = 0;
+    std::size_t numMergedDrawCommands   = 0;
+};
+
+/*
+Removes all binding commands from the specified command stream whose state is either overwritten
+or left unchanged before it is consumed by the next draw or dispatch command.
+The remaining commands are compacted within their pages, i.e. no memory is allocated or released.
+*/
+GLCommandOptimizerStats RemoveRedundantGLCommands(GLCommandArena& buffer);
+
+/*
+Merges runs of consecutive indexed draw commands with the same primitive and index type into single multi-draw commands.
+The indirect arguments of all merged draw commands are appended to 'indirectArgs' and must be uploaded into the indirect buffer 'indirectBufferID'
+before the command stream is executed. Returns the number of merged draw commands, and the number and size of the commands that have been removed by merging.
+*/
+GLCommandOptimizerStats MergeGLDrawCommands(GLCommandArena& buffer, GLuint indirectBufferID, std::vector<GLDrawElementsIndirectCommand>& indirectArgs);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
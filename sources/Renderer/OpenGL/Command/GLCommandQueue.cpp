@@ -10,6 +10,7 @@
 #include "GLCommandExecutor.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLFence.h"
+#include "../Buffer/GLPersistentMapping.h"
 #include "../RenderState/GLQueryHeap.h"
 #include "../RenderState/GLStateManager.h"
 #include "../../CheckedCast.h"
@@ -40,6 +41,9 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
         auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
         ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, *stateMngr_);
     }
+
+    /* Guard all persistently mapped ranges that have been written for the commands submitted so far */
+    GLPersistentMapping::SubmitPendingFence();
 }
 
 /* ----- Queries ----- */
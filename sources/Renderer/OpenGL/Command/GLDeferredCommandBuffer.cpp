@@ -7,6 +7,7 @@
 
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommand.h"
+#include "GLCommandDisassembler.h"
 #include <LLGL/StaticLimits.h>
 
 #include "../../TextureUtils.h"
@@ -46,37 +47,120 @@ namespace LLGL
 {
 
 
+static void AccumOptimizerStats(GLCommandOptimizerStats& dst, const GLCommandOptimizerStats& src)
+{
+    dst.numRemovedCommands      += src.numRemovedCommands;
+    dst.numRemovedBytes         += src.numRemovedBytes;
+    dst.numMergedDrawCommands   += src.numMergedDrawCommands;
+}
+
 GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t reservedSize) :
     flags_ { flags }
 {
-    buffer_.reserve(reservedSize);
+    buffer_.Reserve(reservedSize);
+
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    /* Create indirect argument buffer for batched draw commands */
+    if ((flags & CommandBufferFlags::BatchDrawCommands) != 0 && HasExtension(GLExt::ARB_multi_draw_indirect))
+        glGenBuffers(1, &drawBatchBufferID_);
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+}
+
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    #ifdef LLGL_ENABLE_JIT_COMPILER
+    WaitForBackgroundCompile();
+    #endif // /LLGL_ENABLE_JIT_COMPILER
+
+    if (drawBatchBufferID_ != 0)
+    {
+        glDeleteBuffers(1, &drawBatchBufferID_);
+        GLStateManager::Get().NotifyBufferRelease(drawBatchBufferID_, GLBufferTarget::DRAW_INDIRECT_BUFFER);
+    }
 }
 
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
-    /* Reset internal command buffer */
-    buffer_.clear();
-    boundShaderProgram_ = 0;
-
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
+    /* Wait for background compilation of previous encoding before its commands and indirect arguments are discarded */
+    WaitForBackgroundCompile();
+
     /* Reset states relevant to the GL command assembler */
     executable_.reset();
     maxNumViewports_ = 0;
     maxNumScissors_  = 0;
 
     #endif // /LLGL_ENABLE_JIT_COMPILER
+
+    /* Reset internal command buffer, but keep its pages for reuse */
+    buffer_.Clear();
+    boundShaderProgram_ = 0;
+    optimizerStats_     = {};
+
+    if (drawBatchBufferID_ != 0)
+    {
+        /* Reserve the first command to upload the indirect arguments of all batched draw commands once per submission */
+        drawBatchArgs_.clear();
+        drawBatchUploadCmd_ = AllocCommand<GLCmdUploadIndirectArgs>(GLOpcodeUploadIndirectArgs);
+        {
+            drawBatchUploadCmd_->id     = drawBatchBufferID_;
+            drawBatchUploadCmd_->size   = 0;
+            drawBatchUploadCmd_->data   = nullptr;
+        }
+    }
 }
 
 void GLDeferredCommandBuffer::End()
 {
+    /* Remove redundant state changes only if command buffer will be submitted multiple times */
+    const long optimizeFlags = (CommandBufferFlags::MultiSubmit | CommandBufferFlags::OptimizeStateChanges);
+    if ((GetFlags() & optimizeFlags) == optimizeFlags)
+        optimizerStats_ = RemoveRedundantGLCommands(buffer_);
+
+    if (drawBatchUploadCmd_ != nullptr)
+    {
+        /* Merge consecutive indexed draw commands; the upload command remains at the beginning since commands are only moved towards the front */
+        AccumOptimizerStats(optimizerStats_, MergeGLDrawCommands(buffer_, drawBatchBufferID_, drawBatchArgs_));
+        {
+            drawBatchUploadCmd_->size   = static_cast<GLsizeiptr>(drawBatchArgs_.size() * sizeof(GLDrawElementsIndirectCommand));
+            drawBatchUploadCmd_->data   = drawBatchArgs_.data();
+        }
+        drawBatchUploadCmd_ = nullptr;
+    }
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Generate native assembly only if command buffer will be submitted multiple times */
     if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
-        executable_ = AssembleGLDeferredCommandBuffer(*this);
+    {
+        if ((GetFlags() & CommandBufferFlags::BackgroundCompile) != 0)
+        {
+            /*
+            Assemble on a worker thread; the commands are not modified until the next call to Begin,
+            so they can be read by the assembler and interpreted by the command queue at the same time
+            */
+            pendingExecutable_ = std::async(
+                std::launch::async,
+                [this]() -> std::unique_ptr<JITProgram>
+                {
+                    try
+                    {
+                        return AssembleGLDeferredCommandBuffer(*this);
+                    }
+                    catch (const std::exception&)
+                    {
+                        /* Keep interpreting this command buffer if it cannot be compiled */
+                        return nullptr;
+                    }
+                }
+            );
+        }
+        else
+            executable_ = AssembleGLDeferredCommandBuffer(*this);
+    }
 
     #endif // /LLGL_ENABLE_JIT_COMPILER
 }
@@ -108,6 +192,10 @@ void GLDeferredCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    /*
+    Store payload inline, since this command buffer might be encoded on a worker thread and submitted multiple times.
+    The payload is only streamed through the GLUploadHeap when the command buffer is executed on the GL thread.
+    */
     auto cmd = AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, dataSize);
     {
         cmd->buffer = LLGL_CAST(GLBuffer*, &dstBuffer);
@@ -959,8 +1047,8 @@ void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
     #ifdef GL_KHR_debug
     if (HasExtension(GLExt::KHR_debug))
     {
-        /* Push debug group name into command stream with default ID no. */
-        const GLint         maxLength       = GLStateManager::Get().GetLimits().maxDebugNameLength;
+        /* Push debug group name into command stream with default ID no. (use common limits, since the active state manager is owned by the render thread) */
+        const GLint         maxLength       = GLStateManager::GetCommonLimits().maxDebugNameLength;
         const GLuint        id              = 0;
         const std::size_t   actualLength    = std::strlen(name);
         const std::size_t   croppedLength   = std::min(actualLength, static_cast<std::size_t>(maxLength));
@@ -1007,11 +1095,54 @@ bool GLDeferredCommandBuffer::IsPrimary() const
     return ((GetFlags() & CommandBufferFlags::DeferredSubmit) == 0);
 }
 
+void GLDeferredCommandBuffer::QueryCommandStats(GLCommandStats& stats) const
+{
+    AccumGLCommandStats(buffer_, stats);
+    AccumOptimizerStats(stats.optimizer, optimizerStats_);
+}
+
+void GLDeferredCommandBuffer::ProfileCommands(
+    GLStateManager&         stateMngr,
+    GLCommandStats&         stats,
+    std::uint32_t           numIterations,
+    GLCommandExecuteFunc    executeFunc) const
+{
+    ProfileGLCommands(buffer_, stateMngr, stats, numIterations, executeFunc);
+    AccumOptimizerStats(stats.optimizer, optimizerStats_);
+}
+
+void GLDeferredCommandBuffer::Disassemble(std::ostream& s, const std::string& title) const
+{
+    DisassembleGLCommands(s, buffer_, title);
+}
+
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+const JITProgram* GLDeferredCommandBuffer::GetExecutable() const
+{
+    /* Take over the native program as soon as the background compilation has finished without blocking the submission */
+    if (pendingExecutable_.valid() && pendingExecutable_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        executable_ = pendingExecutable_.get();
+    return executable_.get();
+}
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
 
 /*
  * ======= Private: =======
  */
 
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+void GLDeferredCommandBuffer::WaitForBackgroundCompile()
+{
+    if (pendingExecutable_.valid())
+        pendingExecutable_.get();
+}
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
 void GLDeferredCommandBuffer::BindBufferBase(const GLBufferTarget bufferTarget, GLBuffer& bufferGL, std::uint32_t slot)
 {
     auto cmd = AllocCommand<GLCmdBindBufferBase>(GLOpcodeBindBufferBase);
@@ -1066,24 +1197,32 @@ void GLDeferredCommandBuffer::BindSampler(GLSampler& samplerGL, std::uint32_t sl
     }
 }
 
+void* GLDeferredCommandBuffer::AllocCommandHeader(const GLOpcode opcode, std::size_t payloadSize)
+{
+    /* Allocate header and payload within the same page; the size is aligned so that the payload of the next command is aligned, too */
+    const auto size = GetAlignedGLCommandSize(payloadSize);
+    LLGL_ASSERT_RANGE(size, g_glMaxCommandSize);
+
+    auto header = reinterpret_cast<GLCommandHeader*>(buffer_.Alloc(size));
+    {
+        header->opcode  = opcode;
+        header->size    = static_cast<std::uint32_t>(size);
+    }
+    return (header + 1);
+}
+
 void GLDeferredCommandBuffer::AllocOpCode(const GLOpcode opcode)
 {
-    buffer_.push_back(opcode);
+    AllocCommandHeader(opcode, 0);
 }
 
 template <typename T>
 T* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t extraSize)
 {
-    /* Resize internal buffer for opcode, command structure, and extra size */
-    auto offset = buffer_.size();
-    {
-        buffer_.resize(offset + sizeof(opcode) + sizeof(T) + extraSize);
-        buffer_[offset] = opcode;
-    }
-    return reinterpret_cast<T*>(&(buffer_[offset + sizeof(opcode)]));
+    static_assert(alignof(T) <= g_glCommandAlignment, "GL command structure exceeds alignment of command stream");
+    return reinterpret_cast<T*>(AllocCommandHeader(opcode, sizeof(T) + extraSize));
 }
 
-
 } // /namespace LLGL
 
 
@@ -11,6 +11,9 @@
 
 #include "GLCommandBuffer.h"
 #include "GLCommandOpcode.h"
+#include "GLCommandArena.h"
+#include "GLCommandOptimizer.h"
+#include "GLCommandDisassembler.h"
 #include "../RenderState/GLState.h"
 #include "../OpenGL.h"
 #include <memory>
@@ -18,6 +21,7 @@
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
 #   include "../../../JIT/JITProgram.h"
+#   include <future>
 #endif
 
 
@@ -34,12 +38,19 @@ class GLRenderContext;
 class GLStateManager;
 class GLRenderPass;
 
+/*
+Command buffer that encodes all commands into its own command arena to be executed later by the GL command queue.
+Encoding does neither call the GL API nor modify any state that is shared between command buffers (such as GLStatePool or GLTextureViewPool),
+so different instances can be encoded simultaneously on multiple worker threads. Only the construction, destruction, and submission
+of a command buffer must be done on the thread of the GL context.
+*/
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
 
     public:
 
         GLDeferredCommandBuffer(long flags, std::size_t reservedSize = 0);
+        ~GLDeferredCommandBuffer();
 
         /* ----- Encoding ----- */
 
@@ -231,8 +242,8 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         // Returns true if this is a primary command buffer.
         bool IsPrimary() const;
 
-        // Returns the internal command buffer as raw byte buffer.
-        inline const std::vector<std::uint8_t>& GetRawBuffer() const
+        // Returns the internal command buffer as raw list of pages.
+        inline const GLCommandArena& GetRawBuffer() const
         {
             return buffer_;
         }
@@ -243,14 +254,37 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             return flags_;
         }
 
-        #ifdef LLGL_ENABLE_JIT_COMPILER
-
-        // Returns the just-in-time compiled command buffer that can be executed natively, or null if not available.
-        inline const std::unique_ptr<JITProgram>& GetExecutable() const
+        // Returns the statistics of the commands that have been removed or merged at the end of the last encoding (see CommandBufferFlags::OptimizeStateChanges and BatchDrawCommands).
+        inline const GLCommandOptimizerStats& GetOptimizerStats() const
         {
-            return executable_;
+            return optimizerStats_;
         }
 
+        // Accumulates the number and size of all commands per opcode and the statistics of the command optimizer of the last encoding.
+        void QueryCommandStats(GLCommandStats& stats) const;
+
+        /*
+        Executes all commands 'numIterations' times and accumulates their execution time per opcode in addition to the statistics of QueryCommandStats.
+        Use ExecuteGLCommandStub as execution function to profile the command buffer without a GL context (see ProfileGLCommands).
+        */
+        void ProfileCommands(
+            GLStateManager&         stateMngr,
+            GLCommandStats&         stats,
+            std::uint32_t           numIterations   = 1,
+            GLCommandExecuteFunc    executeFunc     = nullptr
+        ) const;
+
+        // Prints the textual disassembly of all commands in this command buffer (see DisassembleGLCommands).
+        void Disassemble(std::ostream& s, const std::string& title = "") const;
+
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+
+        /*
+        Returns the just-in-time compiled command buffer that can be executed natively, or null if not available.
+        This is also null while the command buffer is still compiled in the background (see CommandBufferFlags::BackgroundCompile).
+        */
+        const JITProgram* GetExecutable() const;
+
         // Returns the maximum number of viewports that are set in this command buffer.
         inline std::uint32_t GetMaxNumViewports() const
         {
@@ -272,6 +306,9 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindTexture(GLTexture& textureGL, std::uint32_t slot);
         void BindSampler(GLSampler& samplerGL, std::uint32_t slot);
 
+        /* Allocates the command header with the specified opcode and returns the pointer to the aligned payload */
+        void* AllocCommandHeader(const GLOpcode opcode, std::size_t payloadSize);
+
         /* Allocates only an opcode for empty commands */
         void AllocOpCode(const GLOpcode opcode);
 
@@ -279,6 +316,11 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         template <typename T>
         T* AllocCommand(const GLOpcode opcode, std::size_t extraSize = 0);
 
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+        /* Waits until the background compilation has finished and discards its result */
+        void WaitForBackgroundCompile();
+        #endif // /LLGL_ENABLE_JIT_COMPILER
+
     private:
 
         GLRenderState               renderState_;
@@ -286,12 +328,18 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         GLuint                      boundShaderProgram_ = 0;
 
         long                        flags_              = 0;
-        std::vector<std::uint8_t>   buffer_;
+        GLCommandArena              buffer_;
+        GLCommandOptimizerStats     optimizerStats_;
+
+        GLuint                                      drawBatchBufferID_  = 0;
+        GLCmdUploadIndirectArgs*                    drawBatchUploadCmd_ = nullptr;
+        std::vector<GLDrawElementsIndirectCommand>  drawBatchArgs_;
 
         #ifdef LLGL_ENABLE_JIT_COMPILER
-        std::unique_ptr<JITProgram> executable_;
-        std::uint32_t               maxNumViewports_    = 0;
-        std::uint32_t               maxNumScissors_     = 0;
+        mutable std::unique_ptr<JITProgram>                 executable_;
+        mutable std::future<std::unique_ptr<JITProgram>>    pendingExecutable_;
+        std::uint32_t                                       maxNumViewports_    = 0;
+        std::uint32_t                                       maxNumScissors_     = 0;
         #endif // /LLGL_ENABLE_JIT_COMPILER
 
 };
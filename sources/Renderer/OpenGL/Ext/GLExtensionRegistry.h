@@ -40,6 +40,7 @@ enum class GLExt
     ARB_instanced_arrays,               // GL 2.1
     ARB_internalformat_query,
     ARB_internalformat_query2,
+    ARB_map_buffer_range,               // GL 3.0
     ARB_multitexture,
     ARB_multi_bind,                     // GL 4.3
     ARB_multi_draw_indirect,
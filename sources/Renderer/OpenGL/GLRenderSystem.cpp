@@ -17,11 +17,14 @@
 #include "GLCore.h"
 #include "Buffer/GLBufferWithVAO.h"
 #include "Buffer/GLBufferArrayWithVAO.h"
+#include "Buffer/GLUploadHeap.h"
+#include "Buffer/GLPersistentMapping.h"
 #include "../CheckedCast.h"
 #include "../TextureUtils.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 #include "GLRenderingCaps.h"
+#include "GLSerialization.h"
 #include "Command/GLImmediateCommandBuffer.h"
 #include "Command/GLDeferredCommandBuffer.h"
 #include "RenderState/GLGraphicsPSO.h"
@@ -52,6 +55,7 @@ GLRenderSystem::~GLRenderSystem()
     GLTextureViewPool::Get().Clear();
     GLMipGenerator::Get().Clear();
     GLStatePool::Get().Clear();
+    GLUploadHeap::Get().Clear();
 }
 
 /* ----- Render Context ----- */
@@ -86,7 +90,14 @@ CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
     /* Get state manager from shared render context */
     if (auto sharedContext = GetSharedRenderContext())
     {
-        if ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit)) != 0)
+        const long deferredFlags =
+        (
+            CommandBufferFlags::DeferredSubmit      |
+            CommandBufferFlags::MultiSubmit         |
+            CommandBufferFlags::BatchDrawCommands   |
+            CommandBufferFlags::ParallelEncoding
+        );
+        if ((desc.flags & deferredFlags) != 0)
         {
             /* Create deferred command buffer */
             return TakeOwnership(
@@ -114,7 +125,7 @@ void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 
 /* ----- Buffers ------ */
 
-static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
+static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags, long miscFlags)
 {
     #ifdef GL_ARB_buffer_storage
 
@@ -128,6 +139,19 @@ static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
     if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
         flagsGL |= GL_MAP_WRITE_BIT;
 
+    #ifdef LLGL_GLEXT_BUFFER_STORAGE
+    if ((miscFlags & MiscFlags::PersistentMap) != 0 && (cpuAccessFlags & CPUAccessFlags::ReadWrite) != 0)
+    {
+        if (HasExtension(GLExt::ARB_buffer_storage) && HasExtension(GLExt::ARB_map_buffer_range))
+        {
+            /* Keep buffer mapped for its entire lifetime; storage with read access must be coherent to see GPU writes after a fence */
+            flagsGL |= GL_MAP_PERSISTENT_BIT;
+            if ((cpuAccessFlags & CPUAccessFlags::Read) != 0)
+                flagsGL |= GL_MAP_COHERENT_BIT;
+        }
+    }
+    #endif // /LLGL_GLEXT_BUFFER_STORAGE
+
     return flagsGL;
 
     #else
@@ -144,12 +168,11 @@ static GLenum GetGLBufferUsage(long miscFlags)
 
 static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
 {
-    bufferGL.BufferStorage(
-        static_cast<GLsizeiptr>(desc.size),
-        initialData,
-        GetGLBufferStorageFlags(desc.cpuAccessFlags),
-        GetGLBufferUsage(desc.miscFlags)
-    );
+    const auto size         = static_cast<GLsizeiptr>(desc.size);
+    const auto storageFlags = GetGLBufferStorageFlags(desc.cpuAccessFlags, desc.miscFlags);
+
+    bufferGL.BufferStorage(size, initialData, storageFlags, GetGLBufferUsage(desc.miscFlags));
+    bufferGL.CreatePersistentMapping(size, storageFlags);
 }
 
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
@@ -219,19 +242,75 @@ void GLRenderSystem::Release(BufferArray& bufferArray)
 void GLRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
-    dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
+    GLUploadHeap::Get().BufferSubData(dstBufferGL, static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
+}
+
+static bool HasCPUReadAccess(const CPUAccess access)
+{
+    return (access == CPUAccess::ReadOnly || access == CPUAccess::ReadWrite);
+}
+
+static bool HasCPUWriteAccess(const CPUAccess access)
+{
+    return (access != CPUAccess::ReadOnly);
 }
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    /* Hand out pointer into persistently mapped memory */
+    if (auto persistentMapping = bufferGL.GetPersistentMapping())
+        return persistentMapping->Map(0, persistentMapping->GetSize(), HasCPUReadAccess(access), HasCPUWriteAccess(access));
+
     return bufferGL.MapBuffer(GLTypes::Map(access));
 }
 
+void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
+{
+    auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
+
+    /* Hand out pointer into persistently mapped memory, which only waits for the GPU if the range is still in use */
+    if (auto persistentMapping = bufferGL.GetPersistentMapping())
+    {
+        return persistentMapping->Map(
+            static_cast<GLintptr>(offset),
+            static_cast<GLsizeiptr>(length),
+            HasCPUReadAccess(access),
+            HasCPUWriteAccess(access)
+        );
+    }
+
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        /* Map only the specified range */
+        GLbitfield flags = 0;
+        {
+            if (HasCPUReadAccess(access))
+                flags |= GL_MAP_READ_BIT;
+            if (HasCPUWriteAccess(access))
+                flags |= GL_MAP_WRITE_BIT;
+            if (access == CPUAccess::WriteDiscard)
+                flags |= GL_MAP_INVALIDATE_RANGE_BIT;
+        }
+        return bufferGL.MapBufferRange(static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(length), flags);
+    }
+    #endif // /GL_ARB_map_buffer_range
+
+    /* Fall back to mapping the entire buffer */
+    return RenderSystem::MapBuffer(buffer, access, offset, length);
+}
+
 void GLRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
-    bufferGL.UnmapBuffer();
+
+    /* Only flush written range for persistently mapped buffers; they stay mapped */
+    if (auto persistentMapping = bufferGL.GetPersistentMapping())
+        persistentMapping->Unmap();
+    else
+        bufferGL.UnmapBuffer();
 }
 
 /* ----- Textures ----- */
@@ -284,6 +363,10 @@ Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     /* Initialize either renderbuffer or texture image storage */
     texture->BindAndAllocStorage(textureDesc, imageDesc);
 
+    /* Write remaining MIP-maps if the initial image data contains the entire MIP-map chain */
+    if (imageDesc != nullptr && MustWritePrebuiltMipsOnCreate(textureDesc))
+        WritePrebuiltMips(*texture, textureDesc, *imageDesc);
+
     return TakeOwnership(textures_, std::move(texture));
 }
 
@@ -448,19 +531,105 @@ void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 /* ----- Pipeline States ----- */
 
-PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    Serialization::Deserializer reader{ serializedCache };
+
+    /* Read type of PSO */
+    auto seg = reader.ReadSegment();
+    if (seg.ident != Serialization::GLIdent_GraphicsPSOIdent && seg.ident != Serialization::GLIdent_ComputePSOIdent)
+        throw std::runtime_error("serialized cache does not denote a GL graphics or compute PSO");
+
+    /* Reject cache if it was created with another driver, so the PSO must be created from its descriptor again */
+    if (!Serialization::GLReadSegmentDriverInfo(reader, GetRendererInfo()))
+        return nullptr;
+
+    /* Restore shader program from its binary instead of compiling and linking all shaders */
+    auto shaderProgram = Serialization::GLReadSegmentProgramBinary(reader);
+    if (!shaderProgram)
+        return nullptr;
+
+    /* Restore pipeline layout, which is only required to create the shader binding layout */
+    PipelineLayoutDescriptor pipelineLayoutDesc;
+    Serialization::GLReadSegmentPipelineLayout(reader, pipelineLayoutDesc);
+    GLPipelineLayout pipelineLayout{ pipelineLayoutDesc };
+
+    if (seg.ident == Serialization::GLIdent_GraphicsPSOIdent)
+    {
+        /* Restore graphics pipeline with a render pass that has the same number of color attachments */
+        GraphicsPipelineDescriptor pipelineDesc;
+        std::uint32_t numColorAttachments = 0;
+        Serialization::GLReadSegmentGraphicsDesc(reader, pipelineDesc, numColorAttachments);
+
+        RenderPassDescriptor renderPassDesc;
+        renderPassDesc.colorAttachments.resize(numColorAttachments);
+        GLRenderPass renderPass{ renderPassDesc };
+
+        pipelineDesc.pipelineLayout = &pipelineLayout;
+        pipelineDesc.shaderProgram  = shaderProgram.get();
+        pipelineDesc.renderPass     = &renderPass;
+
+        auto pipelineStateGL = MakeUnique<GLGraphicsPSO>(pipelineDesc, GetRenderingCaps().limits);
+        pipelineStateGL->SetCachedShaderProgram(std::move(shaderProgram));
+        return TakeOwnership(pipelineStates_, std::move(pipelineStateGL));
+    }
+    else
+    {
+        /* Restore compute pipeline */
+        ComputePipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.pipelineLayout = &pipelineLayout;
+            pipelineDesc.shaderProgram  = shaderProgram.get();
+        }
+        auto pipelineStateGL = MakeUnique<GLComputePSO>(pipelineDesc);
+        pipelineStateGL->SetCachedShaderProgram(std::move(shaderProgram));
+        return TakeOwnership(pipelineStates_, std::move(pipelineStateGL));
+    }
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(desc, GetRenderingCaps().limits));
+    auto pipelineStateGL = MakeUnique<GLGraphicsPSO>(desc, GetRenderingCaps().limits);
+
+    if (serializedCache != nullptr)
+    {
+        /* Serialize program binary together with all states to restore the graphics PSO */
+        Serialization::Serializer writer;
+
+        writer.Begin(Serialization::GLIdent_GraphicsPSOIdent);
+        writer.End();
+
+        Serialization::GLWriteSegmentDriverInfo(writer, GetRendererInfo());
+        Serialization::GLWriteSegmentProgramBinary(writer, *(pipelineStateGL->GetShaderProgram()));
+        Serialization::GLWriteSegmentPipelineLayout(writer, desc.pipelineLayout);
+        Serialization::GLWriteSegmentGraphicsDesc(writer, desc);
+
+        *serializedCache = writer.Finalize();
+    }
+
+    return TakeOwnership(pipelineStates_, std::move(pipelineStateGL));
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(desc));
+    auto pipelineStateGL = MakeUnique<GLComputePSO>(desc);
+
+    if (serializedCache != nullptr)
+    {
+        /* Serialize program binary to restore the compute PSO */
+        Serialization::Serializer writer;
+
+        writer.Begin(Serialization::GLIdent_ComputePSOIdent);
+        writer.End();
+
+        Serialization::GLWriteSegmentDriverInfo(writer, GetRendererInfo());
+        Serialization::GLWriteSegmentProgramBinary(writer, *(pipelineStateGL->GetShaderProgram()));
+        Serialization::GLWriteSegmentPipelineLayout(writer, desc.pipelineLayout);
+
+        *serializedCache = writer.Finalize();
+    }
+
+    return TakeOwnership(pipelineStates_, std::move(pipelineStateGL));
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
@@ -0,0 +1,229 @@
+/*
+ * GLSerialization.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLSerialization.h"
+#include "Shader/GLShaderProgram.h"
+#include "RenderState/GLPipelineLayout.h"
+#include "RenderState/GLRenderPass.h"
+#include "Ext/GLExtensions.h"
+#include "Ext/GLExtensionRegistry.h"
+#include "../CheckedCast.h"
+#include "../../Core/Helper.h"
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+void GLWriteSegmentDriverInfo(Serializer& writer, const RendererInfo& info)
+{
+    writer.Begin(GLIdent_DriverInfo);
+    {
+        writer.WriteCString(info.rendererName.c_str());
+        writer.WriteCString(info.deviceName.c_str());
+        writer.WriteCString(info.vendorName.c_str());
+    }
+    writer.End();
+}
+
+void GLWriteSegmentProgramBinary(Serializer& writer, const GLShaderProgram& shaderProgram)
+{
+    GLenum              binaryFormat = 0;
+    std::vector<char>   binary;
+
+    #ifdef GL_ARB_get_program_binary
+    if (HasExtension(GLExt::ARB_get_program_binary))
+    {
+        /* Retrieve program binary; this is empty if the driver does not support any binary formats */
+        GLint binaryLength = 0;
+        glGetProgramiv(shaderProgram.GetID(), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+        if (binaryLength > 0)
+        {
+            binary.resize(static_cast<std::size_t>(binaryLength));
+            glGetProgramBinary(shaderProgram.GetID(), binaryLength, &binaryLength, &binaryFormat, binary.data());
+            binary.resize(static_cast<std::size_t>(binaryLength));
+        }
+    }
+    #endif // /GL_ARB_get_program_binary
+
+    writer.Begin(GLIdent_ProgramBinary, sizeof(binaryFormat) + binary.size());
+    {
+        writer.WriteTyped(binaryFormat);
+        if (!binary.empty())
+            writer.Write(binary.data(), binary.size());
+    }
+    writer.End();
+}
+
+void GLWriteSegmentPipelineLayout(Serializer& writer, const PipelineLayout* pipelineLayout)
+{
+    writer.Begin(GLIdent_PipelineLayout);
+    {
+        if (pipelineLayout != nullptr)
+        {
+            auto pipelineLayoutGL = LLGL_CAST(const GLPipelineLayout*, pipelineLayout);
+            const auto& bindings = pipelineLayoutGL->GetBindings();
+
+            writer.WriteTyped(static_cast<std::uint32_t>(bindings.size()));
+            for (const auto& binding : bindings)
+            {
+                writer.WriteTyped(binding.type);
+                writer.WriteTyped(binding.bindFlags);
+                writer.WriteTyped(binding.stageFlags);
+                writer.WriteTyped(binding.slot);
+                writer.WriteTyped(binding.arraySize);
+                writer.WriteCString(binding.name.c_str());
+            }
+        }
+        else
+            writer.WriteTyped(std::uint32_t(0));
+    }
+    writer.End();
+}
+
+void GLWriteSegmentGraphicsDesc(Serializer& writer, const GraphicsPipelineDescriptor& desc)
+{
+    /* Write render states */
+    std::uint32_t numColorAttachments = 1;
+    if (auto renderPass = desc.renderPass)
+    {
+        auto renderPassGL = LLGL_CAST(const GLRenderPass*, renderPass);
+        numColorAttachments = renderPassGL->GetNumColorAttachments();
+    }
+
+    writer.Begin(GLIdent_GraphicsDesc);
+    {
+        writer.WriteTyped(desc.primitiveTopology);
+        writer.WriteTyped(desc.depth);
+        writer.WriteTyped(desc.stencil);
+        writer.WriteTyped(desc.rasterizer);
+        writer.WriteTyped(desc.blend);
+        writer.WriteTyped(numColorAttachments);
+    }
+    writer.End();
+
+    /* Write static viewports and scissors */
+    writer.Begin(GLIdent_StaticState);
+    {
+        writer.WriteTyped(static_cast<std::uint32_t>(desc.viewports.size()));
+        if (!desc.viewports.empty())
+            writer.Write(desc.viewports.data(), desc.viewports.size() * sizeof(Viewport));
+
+        writer.WriteTyped(static_cast<std::uint32_t>(desc.scissors.size()));
+        if (!desc.scissors.empty())
+            writer.Write(desc.scissors.data(), desc.scissors.size() * sizeof(Scissor));
+    }
+    writer.End();
+}
+
+bool GLReadSegmentDriverInfo(Deserializer& reader, const RendererInfo& info)
+{
+    reader.Begin(GLIdent_DriverInfo);
+
+    const bool driverMatch =
+    (
+        ::strcmp(reader.ReadCString(), info.rendererName.c_str()) == 0 &&
+        ::strcmp(reader.ReadCString(), info.deviceName.c_str())   == 0 &&
+        ::strcmp(reader.ReadCString(), info.vendorName.c_str())   == 0
+    );
+
+    reader.End();
+
+    return driverMatch;
+}
+
+std::unique_ptr<GLShaderProgram> GLReadSegmentProgramBinary(Deserializer& reader)
+{
+    auto seg = reader.Begin(GLIdent_ProgramBinary);
+
+    GLenum binaryFormat = 0;
+    reader.ReadTyped(binaryFormat);
+
+    reader.End();
+
+    /* Reject empty binaries, i.e. the driver that created the cache did not support program binaries */
+    if (seg.size <= sizeof(binaryFormat))
+        return nullptr;
+
+    auto binary         = seg.data + sizeof(binaryFormat);
+    auto binaryLength   = static_cast<GLsizei>(seg.size - sizeof(binaryFormat));
+
+    /* Restore shader program; the driver may still reject the binary, e.g. after a driver update */
+    auto shaderProgram = MakeUnique<GLShaderProgram>(binaryFormat, binary, binaryLength);
+    if (shaderProgram->HasErrors())
+        return nullptr;
+
+    return shaderProgram;
+}
+
+void GLReadSegmentPipelineLayout(Deserializer& reader, PipelineLayoutDescriptor& desc)
+{
+    reader.Begin(GLIdent_PipelineLayout);
+    {
+        std::uint32_t numBindings = 0;
+        reader.ReadTyped(numBindings);
+
+        desc.bindings.resize(numBindings);
+        for (auto& binding : desc.bindings)
+        {
+            reader.ReadTyped(binding.type);
+            reader.ReadTyped(binding.bindFlags);
+            reader.ReadTyped(binding.stageFlags);
+            reader.ReadTyped(binding.slot);
+            reader.ReadTyped(binding.arraySize);
+            binding.name = reader.ReadCString();
+        }
+    }
+    reader.End();
+}
+
+void GLReadSegmentGraphicsDesc(Deserializer& reader, GraphicsPipelineDescriptor& desc, std::uint32_t& numColorAttachments)
+{
+    /* Read render states */
+    reader.Begin(GLIdent_GraphicsDesc);
+    {
+        reader.ReadTyped(desc.primitiveTopology);
+        reader.ReadTyped(desc.depth);
+        reader.ReadTyped(desc.stencil);
+        reader.ReadTyped(desc.rasterizer);
+        reader.ReadTyped(desc.blend);
+        reader.ReadTyped(numColorAttachments);
+    }
+    reader.End();
+
+    /* Read static viewports and scissors */
+    reader.Begin(GLIdent_StaticState);
+    {
+        std::uint32_t numViewports = 0;
+        reader.ReadTyped(numViewports);
+        desc.viewports.resize(numViewports);
+        if (numViewports > 0)
+            reader.Read(desc.viewports.data(), numViewports * sizeof(Viewport));
+
+        std::uint32_t numScissors = 0;
+        reader.ReadTyped(numScissors);
+        desc.scissors.resize(numScissors);
+        if (numScissors > 0)
+            reader.Read(desc.scissors.data(), numScissors * sizeof(Scissor));
+    }
+    reader.End();
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,82 @@
+/*
+ * GLSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SERIALIZATION_H
+#define LLGL_GL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include "OpenGL.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <memory>
+
+
+namespace LLGL
+{
+
+class PipelineLayout;
+class GLShaderProgram;
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for GL serialization.
+enum GLIdent : IdentType
+{
+    GLIdent_ReservedGL = (RendererID::OpenGL << 8),
+    GLIdent_GraphicsPSOIdent,
+    GLIdent_ComputePSOIdent,
+    GLIdent_DriverInfo,         // LPCSTR rendererName; LPCSTR deviceName; LPCSTR vendorName
+    GLIdent_ProgramBinary,      // GLenum binaryFormat; GLubyte[n]
+    GLIdent_PipelineLayout,     // std::uint32_t n; { ResourceType; long; long; std::uint32_t; std::uint32_t; LPCSTR }[n]
+    GLIdent_GraphicsDesc,       // PrimitiveTopology; DepthDescriptor; StencilDescriptor; RasterizerDescriptor; BlendDescriptor; std::uint32_t
+    GLIdent_StaticState,        // std::uint32_t n; Viewport[n]; std::uint32_t m; Scissor[m]
+};
+
+
+/* ----- Functions ----- */
+
+// Writes the renderer, device, and vendor names of the specified driver as a serialized segment.
+void GLWriteSegmentDriverInfo(Serializer& writer, const RendererInfo& info);
+
+// Writes the binary of the specified shader program as a serialized segment. The binary is empty if program binaries are not supported.
+void GLWriteSegmentProgramBinary(Serializer& writer, const GLShaderProgram& shaderProgram);
+
+// Writes the bindings of the specified pipeline layout as a serialized segment.
+void GLWriteSegmentPipelineLayout(Serializer& writer, const PipelineLayout* pipelineLayout);
+
+// Writes the render states and static viewports and scissors of the specified graphics pipeline as serialized segments.
+void GLWriteSegmentGraphicsDesc(Serializer& writer, const GraphicsPipelineDescriptor& desc);
+
+// Reads the driver information from the next deserialized segment and returns true if it matches the specified driver.
+bool GLReadSegmentDriverInfo(Deserializer& reader, const RendererInfo& info);
+
+// Reads a shader program binary from the next deserialized segment. Returns null if the binary was rejected by the driver.
+std::unique_ptr<GLShaderProgram> GLReadSegmentProgramBinary(Deserializer& reader);
+
+// Reads the bindings of a pipeline layout from the next deserialized segment.
+void GLReadSegmentPipelineLayout(Deserializer& reader, PipelineLayoutDescriptor& desc);
+
+// Reads the render states and static viewports and scissors of a graphics pipeline from the next deserialized segments.
+void GLReadSegmentGraphicsDesc(Deserializer& reader, GraphicsPipelineDescriptor& desc, std::uint32_t& numColorAttachments);
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
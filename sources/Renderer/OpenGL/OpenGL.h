@@ -32,6 +32,10 @@
 #   define LLGL_GLEXT_MULTI_DRAW_INDIRECT
 #endif
 
+#if defined GL_ARB_buffer_storage && defined GL_ARB_map_buffer_range
+#   define LLGL_GLEXT_BUFFER_STORAGE
+#endif
+
 #if defined GL_ARB_compute_shader || defined GL_ES_VERSION_3_1
 #   define LLGL_GLEXT_COMPUTE_SHADER
 #endif
@@ -13,6 +13,7 @@
 #include "../GLProfile.h"
 #include "../../PipelineStateUtils.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/HashUtils.h"
 #include "../Texture/GLRenderTarget.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
@@ -63,6 +64,8 @@ GLBlendState::GLBlendState(const BlendDescriptor& desc, std::uint32_t numColorAt
     if (multiSampleEnabled_)
         stateMngr.SetSampleMask(sampleMask_);
     #endif
+
+    hash_ = CalcHash();
 }
 
 void GLBlendState::Bind(GLStateManager& stateMngr)
@@ -269,6 +272,38 @@ void GLBlendState::GLDrawBufferState::Convert(GLDrawBufferState& dst, const Blen
     dst.colorMask[3]    = GLBoolean(src.colorMask.a);
 }
 
+std::size_t GLBlendState::CalcHash() const
+{
+    /* Only include the members that are also considered by CompareSWO */
+    std::size_t seed = 0;
+
+    for (auto c : blendColor_)
+        Utils::HashCombine(seed, c);
+
+    Utils::HashCombine(seed, sampleAlphaToCoverage_);
+    #ifdef LLGL_OPENGL
+    Utils::HashCombine(seed, logicOpEnabled_);
+    Utils::HashCombine(seed, logicOp_);
+    #endif
+    Utils::HashCombine(seed, numDrawBuffers_);
+
+    for (decltype(numDrawBuffers_) i = 0; i < numDrawBuffers_; ++i)
+    {
+        const auto& drawBuffer = drawBuffers_[i];
+        Utils::HashCombine(seed, drawBuffer.blendEnabled);
+        Utils::HashCombine(seed, drawBuffer.srcColor);
+        Utils::HashCombine(seed, drawBuffer.dstColor);
+        Utils::HashCombine(seed, drawBuffer.funcColor);
+        Utils::HashCombine(seed, drawBuffer.srcAlpha);
+        Utils::HashCombine(seed, drawBuffer.dstAlpha);
+        Utils::HashCombine(seed, drawBuffer.funcAlpha);
+        for (auto mask : drawBuffer.colorMask)
+            Utils::HashCombine(seed, mask);
+    }
+
+    return seed;
+}
+
 int GLBlendState::GLDrawBufferState::CompareSWO(const GLDrawBufferState& lhs, const GLDrawBufferState& rhs)
 {
     LLGL_COMPARE_BOOL_MEMBER_SWO( blendEnabled );
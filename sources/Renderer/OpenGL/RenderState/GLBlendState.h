@@ -13,6 +13,7 @@
 #include <LLGL/StaticLimits.h>
 #include "../OpenGL.h"
 #include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -44,6 +45,18 @@ class GLBlendState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         int CompareSWO(const GLBlendState& rhs) const;
 
+        // Returns the hash value of this state. States that are equal with respect to CompareSWO have the same hash value.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
+        // Returns true if this blend state sets a static blend color when it is bound.
+        inline bool IsBlendColorEnabled() const
+        {
+            return blendColorEnabled_;
+        }
+
     private:
 
         struct GLDrawBufferState
@@ -72,6 +85,8 @@ class GLBlendState
         void BindDrawBufferColorMask(const GLDrawBufferState& state);
         void BindIndexedDrawBufferColorMask(const GLDrawBufferState& state, GLuint index);
 
+        std::size_t CalcHash() const;
+
     private:
 
         bool                blendColorDynamic_                              = false;
@@ -86,6 +101,8 @@ class GLBlendState
         GLuint              numDrawBuffers_                                 = 0;
         GLDrawBufferState   drawBuffers_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]    = {};
 
+        std::size_t         hash_                                           = 0;
+
 };
 
 
@@ -11,6 +11,7 @@
 #include "../GLCore.h"
 #include "../GLTypes.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/HashUtils.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
 
@@ -34,6 +35,8 @@ GLDepthStencilState::GLDepthStencilState(const DepthDescriptor& depthDesc, const
     GLStencilFaceState::Convert(stencilBack_, stencilDesc.back, stencilDesc.referenceDynamic);
 
     independentStencilFaces_ = (GLStencilFaceState::CompareSWO(stencilFront_, stencilBack_) != 0);
+
+    hash_ = CalcHash();
 }
 
 void GLDepthStencilState::Bind(GLStateManager& stateMngr)
@@ -170,6 +173,34 @@ void GLDepthStencilState::GLStencilFaceState::Convert(GLStencilFaceState& dst, c
     dst.writeMask    = src.writeMask;
 }
 
+std::size_t GLDepthStencilState::CalcHash() const
+{
+    /* Only include the members that are also considered by CompareSWO */
+    std::size_t seed = 0;
+
+    Utils::HashCombine(seed, depthTestEnabled_);
+    if (depthTestEnabled_)
+    {
+        Utils::HashCombine(seed, depthMask_);
+        Utils::HashCombine(seed, depthFunc_);
+    }
+
+    Utils::HashCombine(seed, stencilTestEnabled_);
+    if (stencilTestEnabled_)
+    {
+        Utils::HashCombine(seed, independentStencilFaces_);
+        Utils::HashCombine(seed, stencilFront_.sfail);
+        Utils::HashCombine(seed, stencilFront_.dpfail);
+        Utils::HashCombine(seed, stencilFront_.dppass);
+        Utils::HashCombine(seed, stencilFront_.func);
+        Utils::HashCombine(seed, stencilFront_.ref);
+        Utils::HashCombine(seed, stencilFront_.mask);
+        Utils::HashCombine(seed, stencilFront_.writeMask);
+    }
+
+    return seed;
+}
+
 int GLDepthStencilState::GLStencilFaceState::CompareSWO(const GLStencilFaceState& lhs, const GLStencilFaceState& rhs)
 {
     LLGL_COMPARE_MEMBER_SWO( sfail     );
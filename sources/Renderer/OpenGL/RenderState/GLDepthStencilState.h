@@ -45,6 +45,12 @@ class GLDepthStencilState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         int CompareSWO(const GLDepthStencilState& rhs) const;
 
+        // Returns the hash value of this state. States that are equal with respect to CompareSWO have the same hash value.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
     private:
 
         struct GLStencilFaceState
@@ -66,6 +72,8 @@ class GLDepthStencilState
         void BindStencilFaceState(const GLStencilFaceState& state, GLenum face);
         void BindStencilState(const GLStencilFaceState& state);
 
+        std::size_t CalcHash() const;
+
     private:
 
         // Depth states
@@ -80,6 +88,8 @@ class GLDepthStencilState
         GLStencilFaceState  stencilFront_;
         GLStencilFaceState  stencilBack_;
 
+        std::size_t         hash_                       = 0;
+
 };
 
 
@@ -99,6 +99,17 @@ void GLGraphicsPSO::Bind(GLStateManager& stateMngr)
     }
 }
 
+bool GLGraphicsPSO::HasResidualStates() const
+{
+    return
+    (
+        patchVertices_ > 0          ||
+        numStaticViewports_ > 0     ||
+        numStaticScissors_ > 0      ||
+        (blendState_ && blendState_->IsBlendColorEnabled())
+    );
+}
+
 
 /*
  * ======= Private: =======
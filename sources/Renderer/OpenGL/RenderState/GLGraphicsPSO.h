@@ -48,6 +48,9 @@ class GLGraphicsPSO final : public GLPipelineState
             return primitiveMode_;
         }
 
+        // Returns true if binding this PSO sets states that are not reset by binding another graphics PSO, i.e. static viewports, scissors, blend color, or patch vertices.
+        bool HasResidualStates() const;
+
     private:
 
         void BuildStaticStateBuffer(const GraphicsPipelineDescriptor& desc);
@@ -58,6 +58,11 @@ GLPipelineState::~GLPipelineState()
     GLStatePool::Get().ReleaseShaderBindingLayout(std::move(shaderBindingLayout_));
 }
 
+void GLPipelineState::SetCachedShaderProgram(std::unique_ptr<GLShaderProgram>&& shaderProgram)
+{
+    cachedShaderProgram_ = std::move(shaderProgram);
+}
+
 void GLPipelineState::Bind(GLStateManager& stateMngr)
 {
     /* Bind shader program and discard rasterizer if there is no fragment shader */
@@ -46,6 +46,9 @@ class GLPipelineState : public PipelineState
             return isGraphicsPSO_;
         }
 
+        // Takes ownership of the shader program that was restored from a pipeline state cache. It must be the same program this PSO was created with.
+        void SetCachedShaderProgram(std::unique_ptr<GLShaderProgram>&& shaderProgram);
+
         // Returns the shader program used for this graphics pipeline.
         inline const GLShaderProgram* GetShaderProgram() const
         {
@@ -57,6 +60,7 @@ class GLPipelineState : public PipelineState
         const bool                  isGraphicsPSO_          = false;
         const GLShaderProgram*      shaderProgram_          = nullptr;
         GLShaderBindingLayoutSPtr   shaderBindingLayout_;
+        std::unique_ptr<GLShaderProgram> cachedShaderProgram_;
 
 };
 
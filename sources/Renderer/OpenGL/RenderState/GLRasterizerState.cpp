@@ -11,6 +11,7 @@
 #include "../GLCore.h"
 #include "../GLTypes.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/HashUtils.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
 
@@ -64,6 +65,8 @@ GLRasterizerState::GLRasterizerState(const RasterizerDescriptor& desc)
     #ifdef LLGL_GL_ENABLE_VENDOR_EXT
     conservativeRaster_     = desc.conservativeRasterization;
     #endif
+
+    hash_ = CalcHash();
 }
 
 void GLRasterizerState::Bind(GLStateManager& stateMngr)
@@ -131,6 +134,40 @@ int GLRasterizerState::CompareSWO(const GLRasterizerState& rhs) const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+std::size_t GLRasterizerState::CalcHash() const
+{
+    /* Only include the members that are also considered by CompareSWO */
+    std::size_t seed = 0;
+
+    #ifdef LLGL_OPENGL
+    Utils::HashCombine(seed, polygonMode_);
+    Utils::HashCombine(seed, depthClampEnabled_);
+    #endif
+
+    Utils::HashCombine(seed, cullFace_);
+    Utils::HashCombine(seed, frontFace_);
+    Utils::HashCombine(seed, scissorTestEnabled_);
+    Utils::HashCombine(seed, multiSampleEnabled_);
+    Utils::HashCombine(seed, lineSmoothEnabled_);
+    Utils::HashCombine(seed, lineWidth_);
+    Utils::HashCombine(seed, polygonOffsetEnabled_);
+    Utils::HashCombine(seed, static_cast<int>(polygonOffsetMode_));
+    Utils::HashCombine(seed, polygonOffsetFactor_);
+    Utils::HashCombine(seed, polygonOffsetUnits_);
+    Utils::HashCombine(seed, polygonOffsetClamp_);
+
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    Utils::HashCombine(seed, conservativeRaster_);
+    #endif
+
+    return seed;
+}
+
+
 } // /namespace LLGL
 
 
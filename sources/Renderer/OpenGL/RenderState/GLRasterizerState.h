@@ -42,6 +42,16 @@ class GLRasterizerState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         int CompareSWO(const GLRasterizerState& rhs) const;
 
+        // Returns the hash value of this state. States that are equal with respect to CompareSWO have the same hash value.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
+    private:
+
+        std::size_t CalcHash() const;
+
     private:
 
         #ifdef LLGL_OPENGL
@@ -66,6 +76,8 @@ class GLRasterizerState
         bool        conservativeRaster_     = false;    // glEnable(GL_CONSERVATIVE_RASTERIZATION_NV/INTEL)
         #endif
 
+        std::size_t hash_                   = 0;
+
 };
 
 
@@ -44,6 +44,12 @@ class GLResourceHeap final : public ResourceHeap
         // Binds this resource heap with the specified GL state manager.
         void Bind(GLStateManager& stateMngr, std::uint32_t firstSet);
 
+        // Returns true if binding this resource heap also issues a memory barrier (see glMemoryBarrier).
+        inline bool HasBarriers() const
+        {
+            return (barriers_ != 0);
+        }
+
     private:
 
         using GLResourceBindingIter = std::vector<GLResourceBinding>::const_iterator;
@@ -7,7 +7,6 @@
 
 #include "GLStatePool.h"
 #include "GLStateManager.h"
-#include "../../../Core/ContainerUtils.h"
 #include <functional>
 
 
@@ -19,47 +18,44 @@ namespace LLGL
  * Internal templates
  */
 
-// Searches a compatible state object with complexity O(log n)
+// Searches a compatible state object with average complexity O(1)
 template <typename T>
-std::shared_ptr<T> FindCompatibleStateObject(
-    std::vector<std::shared_ptr<T>>&    container,
-    const T&                            compareObject,
-    std::size_t&                        index)
+typename std::unordered_multimap<std::size_t, std::shared_ptr<T>>::iterator FindCompatibleStateObject(
+    std::unordered_multimap<std::size_t, std::shared_ptr<T>>&   container,
+    const T&                                                    compareObject)
 {
-    auto* entry = Utils::FindInSortedArray<std::shared_ptr<T>>(
-        container.data(),
-        container.size(),
-        [&compareObject](const std::shared_ptr<T>& rhs)
-        {
-            return compareObject.CompareSWO(*rhs.get());
-        },
-        &index
-    );
-    return (entry != nullptr ? *entry : nullptr);
+    /* Only compare the objects with the same hash value */
+    auto range = container.equal_range(compareObject.GetHash());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (compareObject.CompareSWO(*(it->second)) == 0)
+            return it;
+    }
+    return container.end();
 }
 
 template <typename T, typename... Args>
-std::shared_ptr<T> CreateRenderStateObject(std::vector<std::shared_ptr<T>>& container, Args&&... args)
+std::shared_ptr<T> CreateRenderStateObject(std::unordered_multimap<std::size_t, std::shared_ptr<T>>& container, Args&&... args)
 {
     /* Try to find render state object with same parameter */
     T stateToCompare{ std::forward<Args>(args)... };
 
-    std::size_t insertionIndex = 0;
-    if (auto sharedState = FindCompatibleStateObject(container, stateToCompare, insertionIndex))
-        return sharedState;
+    auto it = FindCompatibleStateObject(container, stateToCompare);
+    if (it != container.end())
+        return it->second;
 
-    /* Allocate new render state object with insertion sort */
+    /* Allocate new render state object and insert it with its hash value */
     auto newState = std::make_shared<T>(stateToCompare);
-    container.insert(container.begin() + insertionIndex, newState);
+    container.insert({ newState->GetHash(), newState });
 
     return newState;
 }
 
 template <typename T>
 void ReleaseRenderStateObject(
-    std::vector<std::shared_ptr<T>>&    container,
-    const std::function<void(T*)>&      callback,
-    std::shared_ptr<T>&&                renderState)
+    std::unordered_multimap<std::size_t, std::shared_ptr<T>>&   container,
+    const std::function<void(T*)>&                              callback,
+    std::shared_ptr<T>&&                                        renderState)
 {
     if (renderState && renderState.use_count() == 2)
     {
@@ -67,14 +63,18 @@ void ReleaseRenderStateObject(
         auto objectRef = renderState.get();
         renderState.reset();
 
-        /* Retrieve entry index in container to remove entry */
-        std::size_t entryIndex = 0;
-        if (FindCompatibleStateObject(container, *objectRef, entryIndex) != nullptr)
+        /* Retrieve entry with the same object in container to remove entry */
+        auto range = container.equal_range(objectRef->GetHash());
+        for (auto it = range.first; it != range.second; ++it)
         {
-            /* Notify via callback and erase from container */
-            if (callback)
-                callback(objectRef);
-            container.erase(container.begin() + entryIndex);
+            if (it->second.get() == objectRef)
+            {
+                /* Notify via callback and erase from container */
+                if (callback)
+                    callback(objectRef);
+                container.erase(it);
+                break;
+            }
         }
     }
 }
@@ -98,6 +98,18 @@ void GLStatePool::Clear()
     shaderBindingLayouts_.clear();
 }
 
+GLStatePoolStatistics GLStatePool::GetStatistics() const
+{
+    GLStatePoolStatistics stats;
+    {
+        stats.numDepthStencilStates     = depthStencilStates_.size();
+        stats.numRasterizerStates       = rasterizerStates_.size();
+        stats.numBlendStates            = blendStates_.size();
+        stats.numShaderBindingLayouts   = shaderBindingLayouts_.size();
+    }
+    return stats;
+}
+
 GLDepthStencilStateSPtr GLStatePool::CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
     return CreateRenderStateObject(depthStencilStates_, depthDesc, stencilDesc);
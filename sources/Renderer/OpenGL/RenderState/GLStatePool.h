@@ -15,13 +15,22 @@
 #include "GLBlendState.h"
 #include "GLPipelineLayout.h"
 #include "../Shader/GLShaderBindingLayout.h"
-#include <vector>
+#include <unordered_map>
 
 
 namespace LLGL
 {
 
 
+// Number of shared state objects that currently live in the GL state pool.
+struct GLStatePoolStatistics
+{
+    std::size_t numDepthStencilStates   = 0;
+    std::size_t numRasterizerStates     = 0;
+    std::size_t numBlendStates          = 0;
+    std::size_t numShaderBindingLayouts = 0;
+};
+
 /*
 Singleton pool for OpenGL depth-stencil-, rasterizer-, and blend states.
 These states are separated from the GLStateManager, because they don't need to exist for every GL context.
@@ -40,6 +49,9 @@ class GLStatePool
         // Clear all resource containers of this pool (used by GLRenderSystem).
         void Clear();
 
+        // Returns the number of shared state objects in this pool.
+        GLStatePoolStatistics GetStatistics() const;
+
         /* ----- Depth-stencil states ----- */
 
         GLDepthStencilStateSPtr CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
@@ -60,16 +72,22 @@ class GLStatePool
         GLShaderBindingLayoutSPtr CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout);
         void ReleaseShaderBindingLayout(GLShaderBindingLayoutSPtr&& shaderBindingLayout);
 
+    private:
+
+        // Hash map of shared state objects with their hash value as key (see GetHash). Objects with colliding hash values share the same key.
+        template <typename T>
+        using HashMap = std::unordered_multimap<std::size_t, std::shared_ptr<T>>;
+
     private:
 
         GLStatePool() = default;
 
     private:
 
-        std::vector<GLDepthStencilStateSPtr>    depthStencilStates_;
-        std::vector<GLRasterizerStateSPtr>      rasterizerStates_;
-        std::vector<GLBlendStateSPtr>           blendStates_;
-        std::vector<GLShaderBindingLayoutSPtr>  shaderBindingLayouts_;
+        HashMap<GLDepthStencilState>    depthStencilStates_;
+        HashMap<GLRasterizerState>      rasterizerStates_;
+        HashMap<GLBlendState>           blendStates_;
+        HashMap<GLShaderBindingLayout>  shaderBindingLayouts_;
 
 };
 
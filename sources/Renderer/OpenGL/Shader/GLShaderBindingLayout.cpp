@@ -9,6 +9,7 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/HashUtils.h"
 
 
 namespace LLGL
@@ -55,6 +56,8 @@ GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLay
             }
         }
     }
+
+    hash_ = CalcHash();
 }
 
 void GLShaderBindingLayout::BindResourceSlots(GLuint program) const
@@ -113,6 +116,27 @@ bool GLShaderBindingLayout::HasBindings() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+std::size_t GLShaderBindingLayout::CalcHash() const
+{
+    /* Only include the members that are also considered by CompareSWO */
+    std::size_t seed = 0;
+
+    Utils::HashCombine(seed, bindings_.size());
+
+    for (const auto& binding : bindings_)
+    {
+        Utils::HashCombine(seed, binding.slot);
+        Utils::HashCombine(seed, binding.name);
+    }
+
+    return seed;
+}
+
+
 } // /namespace LLGL
 
 
@@ -43,6 +43,12 @@ class GLShaderBindingLayout
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         int CompareSWO(const GLShaderBindingLayout& rhs) const;
 
+        // Returns the hash value of this layout. Layouts that are equal with respect to CompareSWO have the same hash value.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
         // Returns true if this layout has at least one binding slot.
         bool HasBindings() const;
 
@@ -54,12 +60,17 @@ class GLShaderBindingLayout
             std::uint32_t   slot;
         };
 
+    private:
+
+        std::size_t CalcHash() const;
+
     private:
 
         std::uint8_t                    numUniformBindings_         = 0;
         std::uint8_t                    numUniformBlockBindings_    = 0;
         std::uint8_t                    numShaderStorageBindings_   = 0;
         std::vector<ResourceBinding>    bindings_;
+        std::size_t                     hash_                       = 0;
 
 };
 
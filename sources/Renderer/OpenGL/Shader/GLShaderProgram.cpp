@@ -74,6 +74,19 @@ GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
         LinkProgram(0, nullptr);
 }
 
+GLShaderProgram::GLShaderProgram(GLenum binaryFormat, const void* binary, GLsizei length) :
+    id_ { glCreateProgram() }
+{
+    #ifdef GL_ARB_get_program_binary
+    if (HasExtension(GLExt::ARB_get_program_binary))
+    {
+        /* Load program binary, which sets the link status (keep binary retrievable to serialize it again) */
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glProgramBinary(id_, binaryFormat, binary, length);
+    }
+    #endif // /GL_ARB_get_program_binary
+}
+
 GLShaderProgram::~GLShaderProgram()
 {
     glDeleteProgram(id_);
@@ -189,6 +202,12 @@ void GLShaderProgram::BindFragDataLocations(std::size_t numFragmentAttribs, cons
 
 void GLShaderProgram::LinkProgram(std::size_t numVaryings, const char* const* varyings)
 {
+    #ifdef GL_ARB_get_program_binary
+    /* Allow the program binary to be retrieved for pipeline state caches */
+    if (HasExtension(GLExt::ARB_get_program_binary))
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    #endif // /GL_ARB_get_program_binary
+
     /* Check if transform-feedback varyings must be specified (before or after shader linking) */
     if (numVaryings > 0 && varyings != nullptr)
     {
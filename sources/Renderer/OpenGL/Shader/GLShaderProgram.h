@@ -37,6 +37,9 @@ class GLShaderProgram final : public ShaderProgram
     public:
 
         GLShaderProgram(const ShaderProgramDescriptor& desc);
+
+        // Restores the shader program from a binary (see GL_ARB_get_program_binary). Use HasErrors to determine if the driver rejected the binary.
+        GLShaderProgram(GLenum binaryFormat, const void* binary, GLsizei length);
         ~GLShaderProgram();
 
         /*
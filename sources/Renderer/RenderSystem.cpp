@@ -7,6 +7,7 @@
 
 #include "../Platform/Module.h"
 #include "../Core/Helper.h"
+#include "../Core/ThreadPool.h"
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Format.h>
 #include <LLGL/ImageFlags.h>
@@ -238,6 +239,21 @@ void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
 void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
 {
     config_ = config;
+
+    /* Configure number of worker threads in the global thread pool (the calling thread always participates) */
+    if (config.threadCount >= Constants::maxThreadCount)
+        GetGlobalThreadPool().SetNumWorkers(std::max(1u, std::thread::hardware_concurrency()) - 1u);
+    else
+        GetGlobalThreadPool().SetNumWorkers(config.threadCount > 0 ? config.threadCount - 1 : 0);
+}
+
+void* RenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t /*length*/)
+{
+    /* Map entire buffer by default */
+    if (auto data = reinterpret_cast<char*>(MapBuffer(buffer, access)))
+        return (data + offset);
+    else
+        return nullptr;
 }
 
 
@@ -436,6 +452,44 @@ static void CopyRowAlignedData(void* dstData, const void* srcData, std::size_t d
         ::memcpy(dst, src, dstStride);
 }
 
+void RenderSystem::WritePrebuiltMips(Texture& texture, const TextureDescriptor& textureDesc, const SrcImageDescriptor& imageDesc)
+{
+    const auto subresources = GetMipChainSubresources(textureDesc, imageDesc.format, imageDesc.dataType);
+
+    if (!subresources.empty())
+    {
+        const auto& lastLevel = subresources.back();
+        AssertImageDataSize(imageDesc.dataSize, lastLevel.offset + lastLevel.dataSize, "prebuilt MIP-map chain");
+    }
+
+    /* Write each array layer of each MIP-map level separately (some backends only write a single cube face at a time); the first level was already written by the backend */
+    for (std::uint32_t mipLevel = 1; mipLevel < subresources.size(); ++mipLevel)
+    {
+        const auto& subresource = subresources[mipLevel];
+        const auto  layerSize   = subresource.dataSize / subresource.numArrayLayers;
+
+        for (std::uint32_t arrayLayer = 0; arrayLayer < subresource.numArrayLayers; ++arrayLayer)
+        {
+            const TextureRegion region
+            {
+                TextureSubresource{ arrayLayer, 1, mipLevel, 1 },
+                Offset3D{ 0, 0, 0 },
+                subresource.extent
+            };
+
+            const SrcImageDescriptor layerImageDesc
+            {
+                imageDesc.format,
+                imageDesc.dataType,
+                reinterpret_cast<const char*>(imageDesc.data) + subresource.offset + layerSize * arrayLayer,
+                layerSize
+            };
+
+            WriteTexture(texture, region, layerImageDesc);
+        }
+    }
+}
+
 void RenderSystem::CopyTextureImageData(
     const DstImageDescriptor&   dstImageDesc,
     const Extent3D&             extent,
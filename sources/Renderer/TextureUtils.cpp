@@ -84,7 +84,16 @@ LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc)
     return
     (
         NumMipLevels(textureDesc) > 1 &&
-        (textureDesc.miscFlags & (MiscFlags::GenerateMips | MiscFlags::NoInitialData)) == MiscFlags::GenerateMips
+        (textureDesc.miscFlags & (MiscFlags::GenerateMips | MiscFlags::NoInitialData | MiscFlags::PrebuiltMips)) == MiscFlags::GenerateMips
+    );
+}
+
+LLGL_EXPORT bool MustWritePrebuiltMipsOnCreate(const TextureDescriptor& textureDesc)
+{
+    return
+    (
+        NumMipLevels(textureDesc) > 1 &&
+        (textureDesc.miscFlags & (MiscFlags::PrebuiltMips | MiscFlags::NoInitialData)) == MiscFlags::PrebuiltMips
     );
 }
 
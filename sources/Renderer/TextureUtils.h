@@ -61,6 +61,9 @@ LLGL_EXPORT SubresourceLayout CalcSubresourceLayout(const Format format, const E
 // Returns true if the specified flags for texture creation require MIP-map generation at creation time.
 LLGL_EXPORT bool MustGenerateMipsOnCreate(const TextureDescriptor& textureDesc);
 
+// Returns true if the specified flags for texture creation require the remaining MIP-maps to be written from the initial image data (see MiscFlags::PrebuiltMips).
+LLGL_EXPORT bool MustWritePrebuiltMipsOnCreate(const TextureDescriptor& textureDesc);
+
 // Returns the samples clamped to the range [1, LLGL_MAX_NUM_SAMPLES].
 LLGL_EXPORT std::uint32_t GetClampedSamples(std::uint32_t samples);
 
@@ -8,17 +8,103 @@
 #include "VKDeviceMemory.h"
 #include "../VKCore.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
+#include <iterator>
+
+#if defined _MSC_VER && defined _M_X64
+#   include <intrin.h>
+#endif
 
 
 namespace LLGL
 {
 
 
-VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
-    deviceMemory_    { device, vkFreeMemory },
-    size_            { size                 },
-    memoryTypeIndex_ { memoryTypeIndex      },
-    maxNewBlockSize_ { size                 }
+/* ----- Internal functions ----- */
+
+// Returns the index of the least significant bit that is set in the specified non-zero bitmask.
+static std::uint32_t FindLSB(std::uint64_t bits)
+{
+    #if defined _MSC_VER && defined _M_X64
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(__builtin_ctzll(bits));
+    #else
+    std::uint32_t index = 0;
+    while ((bits & 0x1) == 0)
+    {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+// Returns the index of the most significant bit that is set in the specified non-zero bitmask.
+static std::uint32_t FindMSB(std::uint64_t bits)
+{
+    #if defined _MSC_VER && defined _M_X64
+    unsigned long index = 0;
+    _BitScanReverse64(&index, bits);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__ || defined __clang__
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(bits));
+    #else
+    std::uint32_t index = 0;
+    while (bits >>= 1)
+        ++index;
+    return index;
+    #endif
+}
+
+/*
+Maps the specified size to its TLSF size class: sizes below 16 are mapped linearly into the first class,
+all other sizes are mapped into the class of their most significant bit and then subdivided linearly into 16 second-level classes.
+If 'roundUp' is true, the size is rounded up to the next size class, so each block of the resulting class is large enough.
+*/
+static void MapSizeClass(VkDeviceSize size, std::uint32_t secondLevelCountLog2, bool roundUp, std::uint32_t& fl, std::uint32_t& sl)
+{
+    const VkDeviceSize secondLevelCount = (VkDeviceSize(1) << secondLevelCountLog2);
+    if (size < secondLevelCount)
+    {
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size);
+    }
+    else
+    {
+        if (roundUp)
+        {
+            const auto roundUpSize = (VkDeviceSize(1) << (FindMSB(size) - secondLevelCountLog2)) - 1;
+            size += roundUpSize;
+        }
+        const auto msb = FindMSB(size);
+        fl = msb - secondLevelCountLog2 + 1;
+        sl = static_cast<std::uint32_t>((size >> (msb - secondLevelCountLog2)) - secondLevelCount);
+    }
+}
+
+// Returns true if the last byte of the lower resource and the first byte of the upper resource share the same page.
+static bool IsOnSamePage(VkDeviceSize lowerOffsetEnd, VkDeviceSize upperOffset, VkDeviceSize pageSize)
+{
+    const auto pageMask = ~(pageSize - 1);
+    return (((lowerOffsetEnd - 1) & pageMask) == (upperOffset & pageMask));
+}
+
+
+/* ----- VKDeviceMemory class ----- */
+
+VKDeviceMemory::VKDeviceMemory(
+    const VKPtr<VkDevice>&  device,
+    VkDeviceSize            size,
+    std::uint32_t           memoryTypeIndex,
+    VkDeviceSize            bufferImageGranularity)
+:
+    deviceMemory_           { device, vkFreeMemory                              },
+    size_                   { size                                              },
+    memoryTypeIndex_        { memoryTypeIndex                                   },
+    bufferImageGranularity_ { std::max(bufferImageGranularity, VkDeviceSize(1)) }
 {
     /* Allocate device memory */
     VkMemoryAllocateInfo allocInfo;
@@ -35,6 +121,17 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
         std::string info = "failed to allocate Vulkan device memory of " + std::to_string(size) + " bytes";
         VKThrowIfFailed(result, info.c_str());
     }
+
+    /* Initialize TLSF with a single free block that covers the entire chunk */
+    std::fill(std::begin(secondLevelBitmaps_), std::end(secondLevelBitmaps_), 0u);
+    for (auto& freeList : freeLists_)
+        std::fill(std::begin(freeList), std::end(freeList), nullptr);
+
+    if (size > 0)
+    {
+        firstBlock_ = MakeBlock(size, 0);
+        InsertFreeBlock(firstBlock_);
+    }
 }
 
 void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
@@ -52,78 +149,111 @@ void VKDeviceMemory::Unmap(VkDevice device)
     vkUnmapMemory(device, deviceMemory_);
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
+VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, VKMemoryLayout layout, bool reduceFragmentation)
 {
-    if (size > 0 && alignment > 0)
-    {
-        /* Adjust size and offset by alignment */
-        auto alignedSize    = GetAlignedSize(size, alignment);
-        auto alignedOffset  = GetAlignedSize(GetNextOffset(), alignment);
+    if (size == 0 || alignment == 0)
+        return nullptr;
 
-        if (reduceFragmentation)
-        {
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
+    const auto alignedSize = GetAlignedSize(size, alignment);
+    if (alignedSize > GetSize())
+        return nullptr;
 
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
-        }
-        else
-        {
-            /* Allocate block with aligned size and offset */
-            if (alignedSize + alignedOffset <= GetSize())
-                return AllocAndAppendBlock(alignedSize, alignedOffset);
+    /* Try the first block of the exact size class, which might be smaller than the requested size (good-fit) */
+    if (reduceFragmentation)
+    {
+        if (auto region = AllocFreeBlock(FindFreeBlock(alignedSize, false), alignedSize, alignment, layout))
+            return region;
+    }
 
-            /* Reuse fragmented block */
-            if (alignedSize <= maxFragmentedBlockSize_)
-                return FindReusableBlock(alignedSize, alignment);
-        }
+    /* Try the first block that is large enough for the requested size including the worst-case padding for its alignment */
+    if (auto region = AllocFreeBlock(FindFreeBlock(alignedSize + alignment - 1, true), alignedSize, alignment, layout))
+        return region;
+
+    /* Try the first block that is also large enough for the worst-case padding to separate linear and non-linear resources */
+    if (bufferImageGranularity_ > 1)
+    {
+        const auto maxAlignment = std::max(alignment, bufferImageGranularity_);
+        const auto maxSize      = alignedSize + maxAlignment - 1 + bufferImageGranularity_ - 1;
+        if (auto region = AllocFreeBlock(FindFreeBlock(maxSize, true), alignedSize, alignment, layout))
+            return region;
     }
+
+    /* Try the first block of the exact size class as last resort, e.g. if the requested size fills the entire chunk */
+    if (!reduceFragmentation)
+        return AllocFreeBlock(FindFreeBlock(alignedSize, false), alignedSize, alignment, layout);
+
     return nullptr;
 }
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
-    {
-        /* Increase maximal size of fragmented blocks */
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
+    if (region == nullptr || region->GetParentChunk() != this || region->IsFree())
+        return;
 
-        auto it = std::find_if(
-            blocks_.begin(), blocks_.end(),
-            [region](const std::unique_ptr<VKDeviceMemoryRegion>& entry)
-            {
-                return (entry.get() == region);
-            }
-        );
+    --numAllocatedBlocks_;
 
-        if (it != blocks_.end())
-        {
-            InsertBlockToFragmentsSorted(std::move(*it));
-            blocks_.erase(it);
-        }
+    /* Merge with lower neighbor: [LOWER][BLOCK] --> [+++LOWER++++] */
+    auto prevBlock = region->prevPhysical_;
+    if (prevBlock != nullptr && prevBlock->IsFree())
+    {
+        RemoveFreeBlock(prevBlock);
+        prevBlock->MergeWith(*region);
+        DiscardBlock(region);
+        region = prevBlock;
+    }
+
+    /* Merge with upper neighbor: [BLOCK][UPPER] --> [+++BLOCK++++] */
+    auto nextBlock = region->nextPhysical_;
+    if (nextBlock != nullptr && nextBlock->IsFree())
+    {
+        RemoveFreeBlock(nextBlock);
+        region->MergeWith(*nextBlock);
+        DiscardBlock(nextBlock);
     }
+
+    InsertFreeBlock(region);
 }
 
 bool VKDeviceMemory::IsEmpty() const
 {
-    return blocks_.empty();
+    return (numAllocatedBlocks_ == 0);
 }
 
 VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
 {
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+    if (firstLevelBitmap_ == 0)
+        return 0;
+
+    /* Find largest block in the free list of the largest size class */
+    const auto fl = FindMSB(firstLevelBitmap_);
+    const auto sl = FindMSB(secondLevelBitmaps_[fl]);
+
+    VkDeviceSize maxSize = 0;
+    for (auto block = freeLists_[fl][sl]; block != nullptr; block = block->nextFree_)
+        maxSize = std::max(maxSize, block->GetSize());
+
+    return maxSize;
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
-    details.numChunks               += 1;
-    details.numBlocks               += blocks_.size();
-    details.numFragments            += fragmentedBlocks_.size();
-    details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
-    details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    details.numChunks       += 1;
+    details.numBlocks       += numAllocatedBlocks_;
+
+    /* The free block at the end of the chunk denotes the remaining new block, all other free blocks are fragments */
+    for (auto block = firstBlock_; block != nullptr; block = block->nextPhysical_)
+    {
+        if (block->IsFree())
+        {
+            if (block->nextPhysical_ == nullptr)
+                details.maxNewBlockSize = std::max(details.maxNewBlockSize, block->GetSize());
+            else
+            {
+                details.numFragments++;
+                details.maxFragmentedBlockSize = std::max(details.maxFragmentedBlockSize, block->GetSize());
+            }
+        }
+    }
 }
 
 #ifdef LLGL_DEBUG
@@ -179,20 +309,26 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : blocks_)
+    for (auto block = firstBlock_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (!block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
     VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : fragmentedBlocks_)
+    for (auto block = firstBlock_; block != nullptr; block = block->nextPhysical_)
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        if (block->IsFree())
+        {
+            PrintDeviceMemoryRegion(s, *block, prevBlock);
+            prevBlock = block;
+        }
     }
 }
 
@@ -203,238 +339,197 @@ void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
  * ======= Private: =======
  */
 
-VkDeviceSize VKDeviceMemory::GetNextOffset() const
+VKDeviceMemoryRegion* VKDeviceMemory::FindFreeBlock(VkDeviceSize size, bool roundUp) const
 {
-    if (blocks_.empty())
-        return 0;
-    else
-        return blocks_.back()->GetOffsetWithSize();
-}
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeClass(size, secondLevelCountLog2, roundUp, fl, sl);
 
-std::unique_ptr<VKDeviceMemoryRegion> VKDeviceMemory::MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
-{
-    return MakeUnique<VKDeviceMemoryRegion>(this, alignedSize, alignedOffset, memoryTypeIndex_);
-}
+    if (fl >= firstLevelCount)
+        return nullptr;
 
-VKDeviceMemoryRegion* VKDeviceMemory::AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
-{
-    /* Update maximal free block size */
-    maxNewBlockSize_ = GetSize() - (alignedSize + alignedOffset);
-
-    /* Check if the aligned offset results in a new fragment */
-    const auto nextOffset = GetNextOffset();
-
-    if (nextOffset < alignedOffset)
+    /* Search for non-empty free list in the same first-level class */
+    auto slBitmap = (secondLevelBitmaps_[fl] & (~0u << sl));
+    if (slBitmap == 0)
     {
-        /*
-        Check if new fragment can be immediately merged with previous fragment:
-        Before: blocks:    [++]........[++++]
-                fragments: ....[++++]
-        After:  blocks:    [++]........[++++]
-                fragments: ....[++++++]
-        */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Resize last fragmented block */
-            fragmentedBlocks_.back()->MoveAt(alignedOffset - nextOffset, nextOffset);
-        }
-        else
-        {
-            /* Append new fragmented block at the end */
-            fragmentedBlocks_.push_back(MakeUniqueBlock(alignedOffset - nextOffset, nextOffset));
-        }
-    }
-    else
-    {
-        /* Check if last fragmented block can be replaced by new block */
-        if (!fragmentedBlocks_.empty() && fragmentedBlocks_.back()->GetOffset() == nextOffset)
-        {
-            /* Move fragmented block into main blocks and resize it */
-            auto block = TakeOwnership(blocks_, std::move(fragmentedBlocks_.back()));
-            block->MoveAt(alignedSize, alignedOffset);
-            fragmentedBlocks_.pop_back();
-            return block;
-        }
+        /* Search for non-empty free list in the next larger first-level classes */
+        const auto flBitmap = (fl + 1 < 64 ? (firstLevelBitmap_ & (~std::uint64_t(0) << (fl + 1))) : 0);
+        if (flBitmap == 0)
+            return nullptr;
+
+        fl          = FindLSB(flBitmap);
+        slBitmap    = secondLevelBitmaps_[fl];
     }
 
-    /* Allocate new block */
-    return TakeOwnership(blocks_, MakeUniqueBlock(alignedSize, alignedOffset));
+    return freeLists_[fl][FindLSB(slBitmap)];
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+VKDeviceMemoryRegion* VKDeviceMemory::AllocFreeBlock(
+    VKDeviceMemoryRegion*   block,
+    VkDeviceSize            alignedSize,
+    VkDeviceSize            alignment,
+    VKMemoryLayout          layout)
 {
-    auto regionRef = region.get();
-
-    /* Add block by insertion sort */
-    if (!blocks_.empty())
-    {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
-        {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
-        }
-    }
+    VkDeviceSize alignedOffset = 0;
+    if (block != nullptr && FitFreeBlock(*block, alignedSize, alignment, layout, alignedOffset))
+        return TakeFreeBlock(block, alignedSize, alignedOffset, layout);
     else
-        blocks_.emplace_back(std::move(region));
-
-    return regionRef;
+        return nullptr;
 }
 
-VKDeviceMemoryRegion* VKDeviceMemory::FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment)
+bool VKDeviceMemory::FitFreeBlock(
+    const VKDeviceMemoryRegion& block,
+    VkDeviceSize                alignedSize,
+    VkDeviceSize                alignment,
+    VKMemoryLayout              layout,
+    VkDeviceSize&               outOffset) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    VKDeviceMemoryRegion* nextBlock = nullptr;
+    auto offset = GetAlignedSize(block.GetOffset(), alignment);
 
-    /* Search for fragmented block that fits the requirement */
-    for (auto it = fragmentedBlocks_.begin(); it != fragmentedBlocks_.end(); ++it)
+    /* Move offset to the next page if the lower neighbor has a different layout and shares the same page */
+    if (bufferImageGranularity_ > 1)
     {
-        auto block = it->get();
+        auto prevBlock = block.prevPhysical_;
+        if (prevBlock != nullptr && prevBlock->GetLayout() != layout && IsOnSamePage(prevBlock->GetOffsetWithSize(), offset, bufferImageGranularity_))
+            offset = GetAlignedSize(offset, bufferImageGranularity_);
+    }
 
-        /* Check if required size plus the additional aligned offset fits into the current block */
-        const auto alignedOffset = GetAlignedSize(block->GetOffset(), alignment);
-        if (alignedSize + alignedOffset - block->GetOffset() <= block->GetSize())
-        {
-            /* If this block has the maximum fragmented block size, this value must be updated */
-            const bool mustUpdateMaxSize = (block->GetSize() == maxFragmentedBlockSize_);
+    const auto offsetEnd = offset + alignedSize;
+    if (offsetEnd > block.GetOffsetWithSize())
+        return false;
 
-            /* If block can be reused with its entire size, it can be removed from the fragmented blocks */
-            InsertBlock(std::move(*it));
+    /* Reject block if the upper neighbor has a different layout and shares the same page */
+    if (bufferImageGranularity_ > 1)
+    {
+        auto nextBlock = block.nextPhysical_;
+        if (nextBlock != nullptr && nextBlock->GetLayout() != layout && IsOnSamePage(offsetEnd, nextBlock->GetOffset(), bufferImageGranularity_))
+            return false;
+    }
 
-            it = fragmentedBlocks_.erase(it);
-            if (it != fragmentedBlocks_.end())
-                nextBlock = it->get();
+    outOffset = offset;
+    return true;
+}
 
-            /* Check if block must be split up at the lower part */
-            if (block->GetOffset() < alignedOffset)
-            {
-                /* Allocate fragmented lower block (left to the current block) */
-                auto blockLower = MakeUniqueBlock(alignedOffset - block->GetOffset(), block->GetOffset());
-
-                if (!prevBlock || !MergeFragmentedBlockWith(*prevBlock, *blockLower))
-                {
-                    it = fragmentedBlocks_.insert(it, std::move(blockLower));
-                    ++it;
-                }
-            }
+VKDeviceMemoryRegion* VKDeviceMemory::TakeFreeBlock(VKDeviceMemoryRegion* block, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, VKMemoryLayout layout)
+{
+    RemoveFreeBlock(block);
 
-            /* Check if block must be split up at the upper part */
-            auto alignedSizeWithOffset = alignedSize + alignedOffset - block->GetOffset();
-            if (alignedSizeWithOffset < block->GetSize())
-            {
-                /* Allocate fragmented upper block (right to the current block) */
-                auto blockUpperSize = block->GetSize() - alignedSizeWithOffset;
-                auto blockUpper     = MakeUniqueBlock(blockUpperSize, block->GetOffsetWithSize() - blockUpperSize);
+    /* Split off lower part as new free block: [+++BLOCK++++] --> [LOWER][BLOCK] */
+    if (block->GetOffset() < alignedOffset)
+    {
+        auto lowerBlock = MakeBlock(alignedOffset - block->GetOffset(), block->GetOffset());
+        LinkBlockBefore(lowerBlock, block);
+        InsertFreeBlock(lowerBlock);
+    }
 
-                if (!nextBlock || !MergeFragmentedBlockWith(*blockUpper, *nextBlock))
-                    fragmentedBlocks_.insert(it, std::move(blockUpper));
-            }
+    /* Split off upper part as new free block: [+++BLOCK++++] --> [BLOCK][UPPER] */
+    const auto offsetEnd = alignedOffset + alignedSize;
+    if (offsetEnd < block->GetOffsetWithSize())
+    {
+        auto upperBlock = MakeBlock(block->GetOffsetWithSize() - offsetEnd, offsetEnd);
+        LinkBlockAfter(upperBlock, block);
+        InsertFreeBlock(upperBlock);
+    }
 
-            /* Move reused block to new offset and size */
-            block->MoveAt(alignedSize, alignedOffset);
+    block->MoveAt(alignedSize, alignedOffset);
+    block->layout_ = layout;
+    ++numAllocatedBlocks_;
 
-            if (mustUpdateMaxSize)
-                UpdateMaxFragmentedBlockSize();
+    return block;
+}
 
-            /* Reuse current block */
-            return block;
-        }
+void VKDeviceMemory::InsertFreeBlock(VKDeviceMemoryRegion* block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeClass(block->GetSize(), secondLevelCountLog2, false, fl, sl);
 
-        prevBlock = block;
-    }
+    /* Insert block at the front of its free list */
+    auto& head = freeLists_[fl][sl];
+    block->prevFree_ = nullptr;
+    block->nextFree_ = head;
+    if (head != nullptr)
+        head->prevFree_ = block;
+    head = block;
 
-    /* No reusable block found */
-    return nullptr;
-}
+    firstLevelBitmap_       |= (std::uint64_t(1) << fl);
+    secondLevelBitmaps_[fl] |= (1u << sl);
 
-void VKDeviceMemory::UpdateMaxFragmentedBlockSize()
-{
-    maxFragmentedBlockSize_ = 0;
-    for (const auto& block : fragmentedBlocks_)
-        maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, block->GetSize());
+    block->free_ = true;
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region)
+void VKDeviceMemory::RemoveFreeBlock(VKDeviceMemoryRegion* block)
 {
-    auto offset = region->GetOffset();
-    auto count  = fragmentedBlocks_.size();
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeClass(block->GetSize(), secondLevelCountLog2, false, fl, sl);
 
-    /* Start serach in half-open range [begin, end) */
-    decltype(count) begin = 0, end = count;
+    /* Unlink block from its free list */
+    if (block->prevFree_ != nullptr)
+        block->prevFree_->nextFree_ = block->nextFree_;
+    else
+        freeLists_[fl][sl] = block->nextFree_;
 
-    while (begin + 2 < end)
-    {
-        /* Check if region's offset is before or after the middle's element */
-        auto center = (begin + end) / 2;
+    if (block->nextFree_ != nullptr)
+        block->nextFree_->prevFree_ = block->prevFree_;
 
-        if (offset < fragmentedBlocks_[center]->GetOffset())
-        {
-            /* Restrict search to lower half */
-            end = center + 1;
-        }
-        else
-        {
-            /* Restrict search to upper half */
-            begin = center;
-        }
-    }
+    block->prevFree_ = nullptr;
+    block->nextFree_ = nullptr;
 
-    /* Insert region by insertion-sort of the remaining half-open range [begin, begin + 2) */
-    if (begin < count && offset < fragmentedBlocks_[begin]->GetOffset())
-        InsertBlockToFragmentsAt(std::move(region), begin);
-    else if (begin + 1 < count)
+    /* Clear bits of empty free list */
+    if (freeLists_[fl][sl] == nullptr)
     {
-        if (offset < fragmentedBlocks_[begin + 1]->GetOffset())
-            InsertBlockToFragmentsAt(std::move(region), begin + 1);
-        else
-            InsertBlockToFragmentsAt(std::move(region), begin + 2);
+        secondLevelBitmaps_[fl] &= ~(1u << sl);
+        if (secondLevelBitmaps_[fl] == 0)
+            firstLevelBitmap_ &= ~(std::uint64_t(1) << fl);
     }
-    else
-        InsertBlockToFragmentsAt(std::move(region), count);
+
+    block->free_ = false;
 }
 
-void VKDeviceMemory::InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position)
+VKDeviceMemoryRegion* VKDeviceMemory::MakeBlock(VkDeviceSize size, VkDeviceSize offset)
 {
-    auto count = fragmentedBlocks_.size();
-
-    /* Try to merge region into lower part: [LOWER][BLOCK] --> [+++LOWER++++] */
-    if (position > 0 && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *region))
-    {
-        /* Try to merge upper part into lower part: [+++LOWER++++][UPPER] --> [+++++++LOWER+++++++] */
-        if (position < count && MergeFragmentedBlockWith(*fragmentedBlocks_[position - 1], *fragmentedBlocks_[position]))
-        {
-            /* Remove previous upper part after two-phase-merge */
-            fragmentedBlocks_.erase(fragmentedBlocks_.begin() + position);
-        }
-    }
-    /* Try to merge region into upper part: [BLOCK][UPPER] --> [+++UPPER++++] */
-    else if (position >= count || !MergeFragmentedBlockWith(*fragmentedBlocks_[position], *region))
+    if (!unusedBlocks_.empty())
     {
-        /* Insert new fragmented block: [LOWER]..[BLOCK]..[UPPER] */
-        fragmentedBlocks_.insert(fragmentedBlocks_.begin() + position, std::move(region));
+        /* Reuse discarded block node */
+        auto block = unusedBlocks_.back();
+        unusedBlocks_.pop_back();
+        block->MoveAt(size, offset);
+        return block;
     }
+    return TakeOwnership(blocks_, MakeUnique<VKDeviceMemoryRegion>(this, size, offset, memoryTypeIndex_));
 }
 
-bool VKDeviceMemory::MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion)
+void VKDeviceMemory::DiscardBlock(VKDeviceMemoryRegion* block)
 {
-    if (region.MergeWith(appendixRegion))
-    {
-        IncMaxFragmentedBlockSize(region.GetSize());
-        return true;
-    }
-    return false;
+    /* Discarded blocks are never the first block, since they are always merged into their lower neighbor */
+    if (block->prevPhysical_ != nullptr)
+        block->prevPhysical_->nextPhysical_ = block->nextPhysical_;
+    if (block->nextPhysical_ != nullptr)
+        block->nextPhysical_->prevPhysical_ = block->prevPhysical_;
+
+    block->prevPhysical_    = nullptr;
+    block->nextPhysical_    = nullptr;
+    block->layout_          = VKMemoryLayout::Linear;
+
+    unusedBlocks_.push_back(block);
 }
 
-VkDeviceSize VKDeviceMemory::GetFragmentBlockOffsetEnd(std::size_t position) const
+void VKDeviceMemory::LinkBlockAfter(VKDeviceMemoryRegion* block, VKDeviceMemoryRegion* prevBlock)
 {
-    return fragmentedBlocks_[position]->GetOffsetWithSize();
+    block->prevPhysical_ = prevBlock;
+    block->nextPhysical_ = prevBlock->nextPhysical_;
+    if (prevBlock->nextPhysical_ != nullptr)
+        prevBlock->nextPhysical_->prevPhysical_ = block;
+    prevBlock->nextPhysical_ = block;
 }
 
-void VKDeviceMemory::IncMaxFragmentedBlockSize(VkDeviceSize size)
+void VKDeviceMemory::LinkBlockBefore(VKDeviceMemoryRegion* block, VKDeviceMemoryRegion* nextBlock)
 {
-    maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, size);
+    block->nextPhysical_ = nextBlock;
+    block->prevPhysical_ = nextBlock->prevPhysical_;
+    if (nextBlock->prevPhysical_ != nullptr)
+        nextBlock->prevPhysical_->nextPhysical_ = block;
+    else
+        firstBlock_ = block;
+    nextBlock->prevPhysical_ = block;
 }
 
 
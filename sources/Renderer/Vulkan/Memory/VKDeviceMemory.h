@@ -35,13 +35,23 @@ struct VKDeviceMemoryDetails
     VkDeviceSize    maxFragmentedBlockSize  = 0;
 };
 
-// An instance of this class holds a single VkDeviceMemory allocation chunk.
+/*
+An instance of this class holds a single VkDeviceMemory allocation chunk.
+Blocks within a chunk are managed by a two-level segregated fit (TLSF) allocator:
+free blocks are stored in segregated lists of size classes, which are found by two levels of bitmaps,
+so allocating and releasing a block takes constant time regardless of the number of blocks in the chunk.
+*/
 class VKDeviceMemory
 {
 
     public:
 
-        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory(
+            const VKPtr<VkDevice>&  device,
+            VkDeviceSize            size,
+            std::uint32_t           memoryTypeIndex,
+            VkDeviceSize            bufferImageGranularity = 1
+        );
 
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
@@ -52,10 +62,19 @@ class VKDeviceMemory
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
-        // Tries to allocate a new block within this device memory chunk, and returns null of failure.
-        VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation = false);
-
-        // Releases the specified block within this device memory chunk.
+        /*
+        Tries to allocate a new block within this device memory chunk, and returns null of failure.
+        If 'reduceFragmentation' is true, the free blocks of the exact size class are tried first (good-fit),
+        before the allocator resorts to the next larger size class that is guaranteed to fit.
+        */
+        VKDeviceMemoryRegion* Allocate(
+            VkDeviceSize    size,
+            VkDeviceSize    alignment,
+            VKMemoryLayout  layout              = VKMemoryLayout::Linear,
+            bool            reduceFragmentation = false
+        );
+
+        // Releases the specified block within this device memory chunk and merges it with its free neighbors.
         void Release(VKDeviceMemoryRegion* region);
 
         // Returns true if this device memory has no more blocks.
@@ -94,48 +113,69 @@ class VKDeviceMemory
 
     private:
 
-        // Returns the next offset after the last block.
-        VkDeviceSize GetNextOffset() const;
+        // Number of second-level size classes per first-level size class (as power of two).
+        static const std::uint32_t secondLevelCountLog2 = 4;
+        static const std::uint32_t secondLevelCount     = (1u << secondLevelCountLog2);
+
+        // Number of first-level size classes: one for all sizes below 'secondLevelCount' and one for each power of two above.
+        static const std::uint32_t firstLevelCount      = (64 - secondLevelCountLog2 + 1);
+
+    private:
 
-        // Makes a new device memory block.
-        std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Returns the head of the first non-empty free list whose size class is not smaller than the specified size.
+        VKDeviceMemoryRegion* FindFreeBlock(VkDeviceSize size, bool roundUp) const;
 
-        // Allocates a new block.
-        VKDeviceMemoryRegion* AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Allocates the requested range within the specified free block, or returns null if the block is null or does not fit.
+        VKDeviceMemoryRegion* AllocFreeBlock(
+            VKDeviceMemoryRegion*   block,
+            VkDeviceSize            alignedSize,
+            VkDeviceSize            alignment,
+            VKMemoryLayout          layout
+        );
 
-        // Inserts the specified region into the main block list by insertion-sort.
-        VKDeviceMemoryRegion* InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Returns true if the specified free block can hold the requested size, and returns the aligned offset within this block.
+        bool FitFreeBlock(
+            const VKDeviceMemoryRegion& block,
+            VkDeviceSize                alignedSize,
+            VkDeviceSize                alignment,
+            VKMemoryLayout              layout,
+            VkDeviceSize&               outOffset
+        ) const;
 
-        // Tries to find a fragmented block that can be reused.
-        VKDeviceMemoryRegion* FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment);
+        // Takes the specified free block and splits off the unused space before and after the allocated range.
+        VKDeviceMemoryRegion* TakeFreeBlock(VKDeviceMemoryRegion* block, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, VKMemoryLayout layout);
 
-        // Updates the maximal size of fragmanted blocks.
-        void UpdateMaxFragmentedBlockSize();
+        // Inserts the specified block into the free list of its size class.
+        void InsertFreeBlock(VKDeviceMemoryRegion* block);
 
-        // Inserts the specified region into the fragmented block list by insertion-sort.
-        void InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region);
+        // Removes the specified block from the free list of its size class.
+        void RemoveFreeBlock(VKDeviceMemoryRegion* block);
 
-        // Inserts the specified region into the fragmented block list at the specified position and merges it with surrounding blocks if possible.
-        void InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position);
+        // Makes a new block node or reuses one that has been discarded.
+        VKDeviceMemoryRegion* MakeBlock(VkDeviceSize size, VkDeviceSize offset);
 
-        // Merges the two fragmented blocks and records the maximal fragmented block size.
-        bool MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion);
+        // Removes the specified block from the physical block list and stores its node for reuse.
+        void DiscardBlock(VKDeviceMemoryRegion* block);
 
-        // Returns the offset after the specified fragmented block.
-        VkDeviceSize GetFragmentBlockOffsetEnd(std::size_t position) const;
+        // Inserts the specified new block into the physical block list after the other block.
+        void LinkBlockAfter(VKDeviceMemoryRegion* block, VKDeviceMemoryRegion* prevBlock);
 
-        // Increases the maximal fragmented block size.
-        void IncMaxFragmentedBlockSize(VkDeviceSize size);
+        // Inserts the specified new block into the physical block list before the other block.
+        void LinkBlockBefore(VKDeviceMemoryRegion* block, VKDeviceMemoryRegion* nextBlock);
 
         VKPtr<VkDeviceMemory>                               deviceMemory_;
         VkDeviceSize                                        size_                   = 0;
         std::uint32_t                                       memoryTypeIndex_        = 0;
+        VkDeviceSize                                        bufferImageGranularity_ = 1;
 
-        VkDeviceSize                                        maxNewBlockSize_        = 0;
         std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blocks_;
+        std::vector<VKDeviceMemoryRegion*>                  unusedBlocks_;
+        VKDeviceMemoryRegion*                               firstBlock_             = nullptr;
+        std::size_t                                         numAllocatedBlocks_     = 0;
 
-        VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
+        std::uint64_t                                       firstLevelBitmap_       = 0;
+        std::uint32_t                                       secondLevelBitmaps_[firstLevelCount];
+        VKDeviceMemoryRegion*                               freeLists_[firstLevelCount][secondLevelCount];
 
 };
 
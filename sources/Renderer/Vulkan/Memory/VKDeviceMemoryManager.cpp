@@ -18,12 +18,14 @@ VKDeviceMemoryManager::VKDeviceMemoryManager(
     const VKPtr<VkDevice>&                  device,
     const VkPhysicalDeviceMemoryProperties& memoryProperties,
     VkDeviceSize                            minAllocationSize,
-    bool                                    reduceFragmentation)
+    bool                                    reduceFragmentation,
+    VkDeviceSize                            bufferImageGranularity)
 :
-    device_              { device              },
-    memoryProperties_    { memoryProperties    },
-    minAllocationSize_   { minAllocationSize   },
-    reduceFragmentation_ { reduceFragmentation }
+    device_                 { device                 },
+    memoryProperties_       { memoryProperties       },
+    minAllocationSize_      { minAllocationSize      },
+    reduceFragmentation_    { reduceFragmentation    },
+    bufferImageGranularity_ { bufferImageGranularity }
 {
 }
 
@@ -31,27 +33,37 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     VkDeviceSize            size,
     VkDeviceSize            alignment,
     std::uint32_t           memoryTypeBits,
-    VkMemoryPropertyFlags   properties)
+    VkMemoryPropertyFlags   properties,
+    VKMemoryLayout          layout)
 {
-    const auto alignedSize      = GetAlignedSize(size, alignment);
-    const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
-    const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
-
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    const auto memoryTypeIndex = FindMemoryType(memoryTypeBits, properties);
+
+    /* Try to allocate block in one of the chunks with the same memory type (each attempt takes constant time) */
+    for (const auto& chunk : chunks_)
+    {
+        if (chunk->GetMemoryTypeIndex() == memoryTypeIndex)
+        {
+            if (auto region = chunk->Allocate(size, alignment, layout, reduceFragmentation_))
+                return region;
+        }
+    }
+
+    /* Allocate new chunk */
+    const auto allocationSize = std::max(minAllocationSize_, GetAlignedSize(size, alignment));
+    return AllocChunk(allocationSize, memoryTypeIndex)->Allocate(size, alignment, layout, reduceFragmentation_);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     const VkMemoryRequirements& requirements,
-    VkMemoryPropertyFlags       properties)
+    VkMemoryPropertyFlags       properties,
+    VKMemoryLayout              layout)
 {
     return Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        properties
+        properties,
+        layout
     );
 }
 
@@ -129,20 +141,7 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
 
 VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
-}
-
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
-{
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
-    {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
-    }
-
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex, bufferImageGranularity_));
 }
 
 
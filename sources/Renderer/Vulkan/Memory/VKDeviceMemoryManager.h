@@ -37,7 +37,8 @@ class VKDeviceMemoryManager
             const VKPtr<VkDevice>&                  device,
             const VkPhysicalDeviceMemoryProperties& memoryProperties,
             VkDeviceSize                            minAllocationSize,
-            bool                                    reduceFragmentation
+            bool                                    reduceFragmentation,
+            VkDeviceSize                            bufferImageGranularity  = 1
         );
 
         VKDeviceMemoryManager(const VKDeviceMemoryManager&) = delete;
@@ -48,13 +49,15 @@ class VKDeviceMemoryManager
             VkDeviceSize            size,
             VkDeviceSize            alignment,
             std::uint32_t           memoryTypeBits,
-            VkMemoryPropertyFlags   properties
+            VkMemoryPropertyFlags   properties,
+            VKMemoryLayout          layout      = VKMemoryLayout::Linear
         );
 
         // Allocates a new device memory block with the specified memory requirements.
         VKDeviceMemoryRegion* Allocate(
             const VkMemoryRequirements& requirements,
-            VkMemoryPropertyFlags       properties
+            VkMemoryPropertyFlags       properties,
+            VKMemoryLayout              layout      = VKMemoryLayout::Linear
         );
 
         // Releases the specified device memory block.
@@ -83,9 +86,6 @@ class VKDeviceMemoryManager
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
-
     private:
 
         const VKPtr<VkDevice>&                          device_;
@@ -93,6 +93,7 @@ class VKDeviceMemoryManager
 
         VkDeviceSize                                    minAllocationSize_      = 1024*1024;
         bool                                            reduceFragmentation_    = false;
+        VkDeviceSize                                    bufferImageGranularity_ = 1;
 
         std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
 
@@ -19,7 +19,21 @@ namespace LLGL
 
 class VKDeviceMemory;
 
-// An instance of this class represents an atomic region within a VkDeviceMemory allocation.
+/*
+Resource layout of a device memory region. Linear and non-linear resources that are placed next to each other
+must not share a page of the size 'bufferImageGranularity' (see VkPhysicalDeviceLimits).
+*/
+enum class VKMemoryLayout
+{
+    Linear,     // Buffers and images with linear tiling.
+    NonLinear,  // Images with optimal tiling.
+};
+
+/*
+An instance of this class represents an atomic region within a VkDeviceMemory allocation.
+Each region is also a block node of the TLSF allocator of its parent chunk (see VKDeviceMemory),
+i.e. it is linked to its physical neighbors and, while it is free, to the other free blocks of the same size class.
+*/
 class VKDeviceMemoryRegion
 {
 
@@ -63,6 +77,18 @@ class VKDeviceMemoryRegion
             return memoryTypeIndex_;
         }
 
+        // Returns the resource layout this region was allocated for.
+        inline VKMemoryLayout GetLayout() const
+        {
+            return layout_;
+        }
+
+        // Returns true if this region is a free block of its parent chunk.
+        inline bool IsFree() const
+        {
+            return free_;
+        }
+
     protected:
 
         friend class VKDeviceMemory;
@@ -75,10 +101,17 @@ class VKDeviceMemoryRegion
 
     private:
 
-        VKDeviceMemory* deviceMemory_       = nullptr;
-        VkDeviceSize    size_               = 0;
-        VkDeviceSize    offset_             = 0;
-        std::uint32_t   memoryTypeIndex_    = 0;
+        VKDeviceMemory*         deviceMemory_       = nullptr;
+        VkDeviceSize            size_               = 0;
+        VkDeviceSize            offset_             = 0;
+        std::uint32_t           memoryTypeIndex_    = 0;
+        VKMemoryLayout          layout_             = VKMemoryLayout::Linear;
+        bool                    free_               = false;
+
+        VKDeviceMemoryRegion*   prevPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   nextPhysical_       = nullptr;
+        VKDeviceMemoryRegion*   prevFree_           = nullptr;
+        VKDeviceMemoryRegion*   nextFree_           = nullptr;
 
 };
 
@@ -28,12 +28,13 @@ void VKDeviceImage::AllocateMemoryRegion(VKDeviceMemoryManager& deviceMemoryMngr
     VkMemoryRequirements requirements;
     vkGetImageMemoryRequirements(device, image_, &requirements);
 
-    /* Allocate device memory */
+    /* Allocate device memory (images are always created with optimal tiling) */
     memoryRegion_ = deviceMemoryMngr.Allocate(
         requirements.size,
         requirements.alignment,
         requirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        VKMemoryLayout::NonLinear
     );
 
     /* Bind image to device memory region */
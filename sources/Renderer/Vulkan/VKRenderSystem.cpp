@@ -82,7 +82,8 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
         device_,
         physicalDevice_.GetMemoryProperties(),
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
-        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
+        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false),
+        physicalDevice_.GetProperties().limits.bufferImageGranularity
     );
 }
 
@@ -379,6 +380,10 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
 
+    /* Write remaining MIP-maps if the initial image data contains the entire MIP-map chain */
+    if (imageDesc != nullptr && MustWritePrebuiltMipsOnCreate(textureDesc))
+        WritePrebuiltMips(*textureVK, textureDesc, *imageDesc);
+
     return TakeOwnership(textures_, std::move(textureVK));
 }
 
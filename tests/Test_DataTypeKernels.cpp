@@ -0,0 +1,221 @@
+/*
+ * Test_DataTypeKernels.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Core/DataTypeKernels.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+
+
+// SIMD level that is forced by clearing all other CPU features.
+struct KernelLevel
+{
+    const char*         name;
+    LLGL::CPUFeatures   features;
+};
+
+static std::vector<KernelLevel> GetAvailableKernelLevels()
+{
+    const auto& host = LLGL::GetCPUFeatures();
+
+    std::vector<KernelLevel> levels;
+
+    if (host.sse2)
+    {
+        LLGL::CPUFeatures features;
+        features.sse2 = true;
+        levels.push_back({ "SSE2", features });
+    }
+    if (host.sse2 && host.avx2)
+    {
+        LLGL::CPUFeatures features;
+        features.sse2   = true;
+        features.avx    = true;
+        features.avx2   = true;
+        levels.push_back({ "AVX2", features });
+    }
+    if (host.neon)
+    {
+        LLGL::CPUFeatures features;
+        features.neon = true;
+        levels.push_back({ "NEON", features });
+    }
+
+    return levels;
+}
+
+static const char* DataTypeName(LLGL::DataType dataType)
+{
+    switch (dataType)
+    {
+        case LLGL::DataType::UInt8:     return "UInt8";
+        case LLGL::DataType::UInt16:    return "UInt16";
+        case LLGL::DataType::Float32:   return "Float32";
+        default:                        return "<unknown>";
+    }
+}
+
+// Integer inputs: all values of the type (which include 0 and the maximum) followed by an odd tail.
+template <typename T>
+static std::vector<T> GenerateIntegerInputs()
+{
+    std::vector<T> inputs;
+
+    const auto maxValue = static_cast<std::uint32_t>(std::numeric_limits<T>::max());
+    for (std::uint32_t i = 0; i <= maxValue; ++i)
+        inputs.push_back(static_cast<T>(i));
+
+    for (std::uint32_t i = 0; i < 13; ++i)
+        inputs.push_back(static_cast<T>(maxValue - i * 7));
+
+    return inputs;
+}
+
+/*
+Float inputs: 0, -0, 1, denormals, NaN, and the neighbors of every quantization step k/255 and k/65535 in single precision,
+followed by an odd tail. Values outside [0, 1] are excluded, because they are undefined for the generic conversion.
+*/
+static std::vector<float> GenerateFloatInputs()
+{
+    std::vector<float> inputs =
+    {
+        0.0f,
+        -0.0f,
+        1.0f,
+        std::numeric_limits<float>::denorm_min(),
+        std::numeric_limits<float>::min() * 0.5f,
+        std::numeric_limits<float>::min(),
+        std::numeric_limits<float>::quiet_NaN(),
+        0.5f,
+        0.99999994f,
+    };
+
+    for (double maxValue : { 255.0, 65535.0 })
+    {
+        for (int k = 0; k <= static_cast<int>(maxValue); ++k)
+        {
+            const auto value = static_cast<float>(k / maxValue);
+            inputs.push_back(value);
+            if (k > 0)
+                inputs.push_back(std::nextafter(value, 0.0f));
+            if (k < static_cast<int>(maxValue))
+                inputs.push_back(std::nextafter(value, 1.0f));
+        }
+    }
+
+    for (int i = 0; i < 13; ++i)
+        inputs.push_back(static_cast<float>(i) / 13.0f);
+
+    return inputs;
+}
+
+// Converts the inputs with the SIMD kernel of each level and compares the results bitwise against the generic kernel.
+template <typename TSrc, typename TDst>
+static std::size_t TestKernelEquivalence(
+    LLGL::DataType                  srcDataType,
+    LLGL::DataType                  dstDataType,
+    const std::vector<TSrc>&        inputs,
+    const std::vector<KernelLevel>& levels)
+{
+    std::size_t numErrors = 0;
+
+    const auto n = inputs.size();
+
+    /* Convert inputs with the generic kernel, which is selected when no CPU features are available */
+    auto genericKernel = LLGL::GetDataTypeKernel(srcDataType, dstDataType, LLGL::CPUFeatures{});
+
+    std::vector<TDst> expected(n);
+    genericKernel(inputs.data(), expected.data(), 0, n);
+
+    for (const auto& level : levels)
+    {
+        auto kernel = LLGL::GetDataTypeKernel(srcDataType, dstDataType, level.features);
+        if (kernel == genericKernel)
+        {
+            std::cerr << level.name << ": no SIMD kernel for " << DataTypeName(srcDataType) << " -> " << DataTypeName(dstDataType) << std::endl;
+            ++numErrors;
+            continue;
+        }
+
+        /* Convert with unaligned begin and odd lengths, so both the vector loop and the scalar tail are covered */
+        for (std::size_t idxBegin = 0; idxBegin < 4; ++idxBegin)
+        {
+            std::vector<TDst> results(n);
+            kernel(inputs.data(), results.data(), idxBegin, n);
+
+            for (std::size_t i = idxBegin; i < n; ++i)
+            {
+                if (std::memcmp(&results[i], &expected[i], sizeof(TDst)) != 0)
+                {
+                    std::cerr
+                        << level.name << ": " << DataTypeName(srcDataType) << " -> " << DataTypeName(dstDataType)
+                        << " mismatch at index " << i << " for input " << +inputs[i] << ": "
+                        << +results[i] << " (expected " << +expected[i] << ")" << std::endl;
+                    ++numErrors;
+                }
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+static bool Test_DataTypeKernels()
+{
+    const auto levels = GetAvailableKernelLevels();
+    if (levels.empty())
+    {
+        std::cout << "DataType kernel test: skipped (no SIMD kernels on this platform)" << std::endl;
+        return true;
+    }
+
+    const auto uint8Inputs  = GenerateIntegerInputs<std::uint8_t>();
+    const auto uint16Inputs = GenerateIntegerInputs<std::uint16_t>();
+    const auto floatInputs  = GenerateFloatInputs();
+
+    std::size_t numErrors = 0;
+
+    numErrors += TestKernelEquivalence<std::uint8_t, float>(LLGL::DataType::UInt8, LLGL::DataType::Float32, uint8Inputs, levels);
+    numErrors += TestKernelEquivalence<std::uint16_t, float>(LLGL::DataType::UInt16, LLGL::DataType::Float32, uint16Inputs, levels);
+    numErrors += TestKernelEquivalence<float, std::uint8_t>(LLGL::DataType::Float32, LLGL::DataType::UInt8, floatInputs, levels);
+    numErrors += TestKernelEquivalence<float, std::uint16_t>(LLGL::DataType::Float32, LLGL::DataType::UInt16, floatInputs, levels);
+
+    std::string levelNames;
+    for (const auto& level : levels)
+        levelNames += std::string(levelNames.empty() ? "" : ", ") + level.name;
+
+    if (numErrors == 0)
+        std::cout << "DataType kernel test (" << levelNames << "): passed" << std::endl;
+    else
+        std::cout << "DataType kernel test (" << levelNames << "): " << numErrors << " errors" << std::endl;
+
+    return (numErrors == 0);
+}
+
+int main()
+{
+    try
+    {
+        if (!Test_DataTypeKernels())
+            return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,238 @@
+/*
+ * Test_Float16.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Timer.h>
+#include "Core/Float16Compressor.h"
+#include "Core/CPUFeatures.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+
+static std::uint32_t FloatBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static bool IsFloat16NaN(std::uint16_t value)
+{
+    return ((value & 0x7C00) == 0x7C00 && (value & 0x03FF) != 0);
+}
+
+// Code path of the array conversion that is forced by clearing all other CPU features.
+struct Float16Path
+{
+    const char*         name;
+    LLGL::CPUFeatures   features;
+};
+
+static std::vector<Float16Path> GetAvailableFloat16Paths()
+{
+    const auto& host = LLGL::GetCPUFeatures();
+
+    std::vector<Float16Path> paths;
+
+    paths.push_back({ "scalar", LLGL::CPUFeatures{} });
+
+    if (host.sse2)
+    {
+        LLGL::CPUFeatures features;
+        features.sse2 = true;
+        paths.push_back({ "SSE2", features });
+    }
+    if (host.sse2 && host.avx && host.f16c)
+    {
+        LLGL::CPUFeatures features;
+        features.sse2   = true;
+        features.avx    = true;
+        features.f16c   = true;
+        paths.push_back({ "F16C", features });
+    }
+    if (host.sse2 && host.avx512f)
+    {
+        LLGL::CPUFeatures features;
+        features.sse2       = true;
+        features.avx512f    = true;
+        paths.push_back({ "AVX-512", features });
+    }
+    if (host.neon)
+    {
+        LLGL::CPUFeatures features;
+        features.neon = true;
+        paths.push_back({ "NEON", features });
+    }
+
+    return paths;
+}
+
+// Tests all 65536 16-bit floats, and the rounding of the midpoints between all pairs of adjacent 16-bit floats.
+static bool Test_Float16Exhaustive(const Float16Path& path)
+{
+    const std::size_t n = 65536;
+
+    std::vector<std::uint16_t> halves(n);
+    for (std::size_t i = 0; i < n; ++i)
+        halves[i] = static_cast<std::uint16_t>(i);
+
+    /* Decompress all values and compare against single value conversion */
+    std::vector<float> floats(n);
+    LLGL::DecompressFloat16Array(halves.data(), floats.data(), n, path.features);
+
+    std::size_t numErrors = 0;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (FloatBits(floats[i]) != FloatBits(LLGL::DecompressFloat16(halves[i])))
+        {
+            std::cerr << path.name << ": DecompressFloat16Array mismatch for 0x" << std::hex << i << std::dec << std::endl;
+            ++numErrors;
+        }
+    }
+
+    /* Compress all values again, which must be lossless except for NaN values that are converted to quiet NaN values */
+    std::vector<std::uint16_t> results(n);
+    LLGL::CompressFloat16Array(floats.data(), results.data(), n, path.features);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto expected = (IsFloat16NaN(halves[i]) ? static_cast<std::uint16_t>(halves[i] | 0x0200) : halves[i]);
+        if (results[i] != expected || LLGL::CompressFloat16(floats[i]) != expected)
+        {
+            std::cerr << path.name << ": CompressFloat16Array mismatch for 0x" << std::hex << i << ": 0x" << results[i] << std::dec << std::endl;
+            ++numErrors;
+        }
+    }
+
+    /* Midpoints must round to the even neighbor, and the next float below and above must round to the nearest neighbor */
+    std::vector<float> inputs;
+    std::vector<std::uint16_t> expected;
+
+    for (std::uint32_t sign = 0; sign <= 0x8000; sign += 0x8000)
+    {
+        for (std::uint32_t i = 0; i < 0x7C00; ++i)
+        {
+            const auto lo = static_cast<std::uint16_t>(sign | i);
+            const auto hi = static_cast<std::uint16_t>(sign | (i + 1));
+
+            const float loValue = LLGL::DecompressFloat16(lo);
+            const float hiValue = (i + 1 == 0x7C00 ? (sign != 0 ? -65536.0f : 65536.0f) : LLGL::DecompressFloat16(hi));
+            const float midValue = (loValue + hiValue) * 0.5f;
+
+            inputs.push_back(midValue);
+            expected.push_back((i & 1) == 0 ? lo : hi);
+
+            inputs.push_back(std::nextafter(midValue, loValue));
+            expected.push_back(lo);
+
+            inputs.push_back(std::nextafter(midValue, hiValue));
+            expected.push_back(hi);
+        }
+    }
+
+    results.resize(inputs.size());
+    LLGL::CompressFloat16Array(inputs.data(), results.data(), inputs.size(), path.features);
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (results[i] != expected[i] || LLGL::CompressFloat16(inputs[i]) != expected[i])
+        {
+            std::cerr << path.name << ": Rounding mismatch for " << inputs[i] << ": 0x" << std::hex << results[i] << " (expected 0x" << expected[i] << ")" << std::dec << std::endl;
+            ++numErrors;
+        }
+    }
+
+    if (numErrors == 0)
+        std::cout << "Float16 exhaustive test (" << path.name << "): passed" << std::endl;
+    else
+        std::cout << "Float16 exhaustive test (" << path.name << "): " << numErrors << " errors" << std::endl;
+
+    return (numErrors == 0);
+}
+
+static void Test_Float16Benchmark()
+{
+    const std::size_t n = (1 << 24);
+    const int numIterations = 8;
+
+    std::vector<float> floats(n);
+    std::vector<std::uint16_t> halves(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+        floats[i] = static_cast<float>(i % 4096) * 0.0123f - 20.0f;
+
+    auto timer = LLGL::Timer::Create();
+
+    auto PrintThroughput = [&](const char* name)
+    {
+        auto elapsed = static_cast<double>(timer->Stop()) / static_cast<double>(timer->GetFrequency());
+        auto mvalsPerSec = (static_cast<double>(n) * numIterations) / (elapsed * 1.0e6);
+        std::cout << std::left << std::setw(24) << name << ": " << mvalsPerSec << " MValues/s" << std::endl;
+    };
+
+    timer->Start();
+    {
+        for (int j = 0; j < numIterations; ++j)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                halves[i] = LLGL::CompressFloat16(floats[i]);
+        }
+    }
+    PrintThroughput("CompressFloat16");
+
+    timer->Start();
+    {
+        for (int j = 0; j < numIterations; ++j)
+            LLGL::CompressFloat16Array(floats.data(), halves.data(), n);
+    }
+    PrintThroughput("CompressFloat16Array");
+
+    timer->Start();
+    {
+        for (int j = 0; j < numIterations; ++j)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                floats[i] = LLGL::DecompressFloat16(halves[i]);
+        }
+    }
+    PrintThroughput("DecompressFloat16");
+
+    timer->Start();
+    {
+        for (int j = 0; j < numIterations; ++j)
+            LLGL::DecompressFloat16Array(halves.data(), floats.data(), n);
+    }
+    PrintThroughput("DecompressFloat16Array");
+}
+
+int main()
+{
+    try
+    {
+        bool passed = true;
+        for (const auto& path : GetAvailableFloat16Paths())
+            passed &= Test_Float16Exhaustive(path);
+        if (!passed)
+            return 1;
+        Test_Float16Benchmark();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,1038 @@
+/*
+ * Test_GLCommandBenchmark.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "Renderer/OpenGL/Command/GLDeferredCommandBuffer.h"
+#include "Renderer/OpenGL/Command/GLCommandExecutor.h"
+#include "Renderer/OpenGL/Command/GLCommandAssembler.h"
+#include "Renderer/OpenGL/Command/GLCommandDisassembler.h"
+#include "Renderer/OpenGL/Command/GLCommandArena.h"
+#include "Renderer/OpenGL/Command/GLCommand.h"
+#include "Renderer/OpenGL/RenderState/GLStateManager.h"
+#include "Renderer/OpenGL/Buffer/GLBufferWithVAO.h"
+#include "Renderer/OpenGL/Buffer/GLUploadHeap.h"
+#include "Renderer/OpenGL/Ext/GLExtensions.h"
+#include "Renderer/OpenGL/Ext/GLExtensionRegistry.h"
+#include "JIT/JITProgram.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+Benchmark for the replay of GL deferred command buffers with the command interpreter (ExecuteGLCommand) and the JIT compiler.
+All GL entry points that are used by the synthesized command streams are replaced by counting stubs, so no GL context is required.
+Extension functions are replaced by assigning the global function pointers of the GL renderer;
+GL 1.1 functions are linked from the GL library and are replaced by the definitions in this executable instead (see ENABLE_EXPORTS).
+Before the benchmark runs, the command optimizer and the background compilation are verified with small command streams and the program fails if any check does not pass.
+The program also fails if the interpreter and the JIT compiled program differ in the number, order, or arguments of their GL calls.
+Usage: Test_GLCommandBenchmark [NUM_COMMANDS] [NUM_REPLAYS]
+*/
+
+
+/* ----- GL stubs ----- */
+
+/*
+Number of GL calls and checksum over the entry points and arguments of all GL calls in their order,
+to verify that the interpreter and the JIT compiled program issue exactly the same GL calls.
+*/
+static std::uint64_t    g_numGLCalls        = 0;
+static std::uint64_t    g_glCallChecksum    = 0;
+static bool             g_checksumEnabled   = false;
+static GLuint           g_nextObjectID      = 1;
+
+// First object ID for objects that are created during a replay, so their IDs are the same for the interpreter and the JIT.
+static const GLuint     g_replayObjectID    = 0x10000;
+
+// Accumulates the raw bytes of the specified value into the checksum (FNV-1a).
+template <typename T>
+static void AccumChecksum(const T& value)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (auto byte : bytes)
+    {
+        g_glCallChecksum ^= byte;
+        g_glCallChecksum *= 0x100000001b3ull;
+    }
+}
+
+static void AccumChecksumArgs()
+{
+    // dummy
+}
+
+template <typename TArg0, typename... TArgs>
+static void AccumChecksumArgs(const TArg0& arg0, const TArgs&... args)
+{
+    AccumChecksum(arg0);
+    AccumChecksumArgs(args...);
+}
+
+// Records a GL call to the specified entry point with its arguments.
+template <typename TFunc, typename... TArgs>
+static void RecordGLCall(TFunc func, const TArgs&... args)
+{
+    ++g_numGLCalls;
+    if (g_checksumEnabled)
+    {
+        AccumChecksum(reinterpret_cast<std::uintptr_t>(func));
+        AccumChecksumArgs(args...);
+    }
+}
+
+void APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)                         { RecordGLCall(glDrawArrays, mode, first, count); }
+void APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) { RecordGLCall(glDrawElements, mode, count, type, indices); }
+void APIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height)                   { RecordGLCall(glViewport, x, y, width, height); }
+void APIENTRY glDepthRange(GLclampd zNear, GLclampd zFar)                                   { RecordGLCall(glDepthRange, zNear, zFar); }
+void APIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height)                    { RecordGLCall(glScissor, x, y, width, height); }
+void APIENTRY glEnable(GLenum cap)                                                          { RecordGLCall(glEnable, cap); }
+void APIENTRY glDisable(GLenum cap)                                                         { RecordGLCall(glDisable, cap); }
+void APIENTRY glBindTexture(GLenum target, GLuint texture)                                  { RecordGLCall(glBindTexture, target, texture); }
+
+static void APIENTRY Stub_GenObjects(GLsizei n, GLuint* ids)
+{
+    for (GLsizei i = 0; i < n; ++i)
+        ids[i] = g_nextObjectID++;
+}
+
+static void APIENTRY Stub_DeleteObjects(GLsizei, const GLuint*)                                     {}
+static void APIENTRY Stub_BindBuffer(GLenum target, GLuint buffer)
+{
+    RecordGLCall(Stub_BindBuffer, target, buffer);
+}
+
+static void APIENTRY Stub_BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    RecordGLCall(Stub_BindBufferBase, target, index, buffer);
+}
+
+static void APIENTRY Stub_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    RecordGLCall(Stub_BufferSubData, target, offset, size, data);
+}
+
+static void APIENTRY Stub_BindVertexArray(GLuint array)
+{
+    RecordGLCall(Stub_BindVertexArray, array);
+}
+
+static void APIENTRY Stub_PrimitiveRestartIndex(GLuint index)
+{
+    RecordGLCall(Stub_PrimitiveRestartIndex, index);
+}
+
+static void APIENTRY Stub_DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+    RecordGLCall(Stub_DrawArraysInstanced, mode, first, count, instancecount);
+}
+
+static void APIENTRY Stub_DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
+{
+    RecordGLCall(Stub_DrawElementsInstanced, mode, count, type, indices, instancecount);
+}
+
+static void APIENTRY Stub_DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+    RecordGLCall(Stub_DrawElementsBaseVertex, mode, count, type, indices, basevertex);
+}
+
+// Draw counts of all multi-draw calls and the size of the last indirect buffer upload, to verify batched draw commands.
+static std::vector<GLsizei> g_multiDrawCounts;
+static GLsizeiptr           g_indirectUploadSize = 0;
+
+static void APIENTRY Stub_BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    RecordGLCall(Stub_BufferData, target, size, data, usage);
+    g_indirectUploadSize = size;
+}
+
+static void APIENTRY Stub_MultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+    RecordGLCall(Stub_MultiDrawElementsIndirect, mode, type, indirect, drawcount, stride);
+    g_multiDrawCounts.push_back(drawcount);
+}
+
+// Persistently mapped memory of the upload ring buffer (see GLUploadHeap) and the number of bytes that have been copied out of it.
+static std::vector<std::uint8_t>    g_mappedBufferData;
+static GLsizeiptr                   g_numCopiedBytes = 0;
+
+static void APIENTRY Stub_BufferStorage(GLenum, GLsizeiptr size, const void*, GLbitfield)
+{
+    g_mappedBufferData.resize(static_cast<std::size_t>(size));
+}
+
+static void* APIENTRY Stub_MapBufferRange(GLenum, GLintptr offset, GLsizeiptr, GLbitfield)
+{
+    return g_mappedBufferData.data() + offset;
+}
+
+static GLboolean APIENTRY Stub_UnmapBuffer(GLenum)
+{
+    return GL_TRUE;
+}
+
+static void APIENTRY Stub_CopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    RecordGLCall(Stub_CopyBufferSubData, readTarget, writeTarget, readOffset, writeOffset, size);
+    g_numCopiedBytes += size;
+}
+
+static GLsync APIENTRY Stub_FenceSync(GLenum condition, GLbitfield flags)
+{
+    RecordGLCall(Stub_FenceSync, condition, flags);
+    return reinterpret_cast<GLsync>(1);
+}
+
+static GLenum APIENTRY Stub_ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    RecordGLCall(Stub_ClientWaitSync, sync, flags, timeout);
+    return GL_ALREADY_SIGNALED;
+}
+
+static void APIENTRY Stub_DeleteSync(GLsync)
+{
+}
+
+static void InstallGLStubs()
+{
+    using namespace LLGL;
+
+    /* Enable the extensions for the code paths that are used by the command streams */
+    RegisterExtension(GLExt::ARB_vertex_buffer_object);
+    RegisterExtension(GLExt::ARB_vertex_array_object);
+    RegisterExtension(GLExt::ARB_uniform_buffer_object);
+    RegisterExtension(GLExt::ARB_draw_instanced);
+    RegisterExtension(GLExt::ARB_draw_elements_base_vertex);
+    RegisterExtension(GLExt::ARB_multi_draw_indirect);
+
+    /* Enable the extensions for the persistently mapped upload ring buffer, which is used for buffer updates of at least GLUploadHeap::g_minUploadSize */
+    RegisterExtension(GLExt::ARB_buffer_storage);
+    RegisterExtension(GLExt::ARB_map_buffer_range);
+    RegisterExtension(GLExt::ARB_copy_buffer);
+    RegisterExtension(GLExt::ARB_sync);
+
+    /* Replace extension functions with counting stubs; the JIT compiler reads these pointers, so they must be set before assembling */
+    glGenBuffers                = Stub_GenObjects;
+    glDeleteBuffers             = Stub_DeleteObjects;
+    glGenVertexArrays           = Stub_GenObjects;
+    glDeleteVertexArrays        = Stub_DeleteObjects;
+    glBindBuffer                = Stub_BindBuffer;
+    glBindBufferBase            = Stub_BindBufferBase;
+    glBufferSubData             = Stub_BufferSubData;
+    glBindVertexArray           = Stub_BindVertexArray;
+    glPrimitiveRestartIndex     = Stub_PrimitiveRestartIndex;
+    glDrawArraysInstanced       = Stub_DrawArraysInstanced;
+    glDrawElementsInstanced     = Stub_DrawElementsInstanced;
+    glDrawElementsBaseVertex    = Stub_DrawElementsBaseVertex;
+    glBufferData                = Stub_BufferData;
+    glMultiDrawElementsIndirect = Stub_MultiDrawElementsIndirect;
+    glBufferStorage             = Stub_BufferStorage;
+    glMapBufferRange            = Stub_MapBufferRange;
+    glUnmapBuffer               = Stub_UnmapBuffer;
+    glCopyBufferSubData         = Stub_CopyBufferSubData;
+    glFenceSync                 = Stub_FenceSync;
+    glClientWaitSync            = Stub_ClientWaitSync;
+    glDeleteSync                = Stub_DeleteSync;
+}
+
+
+/* ----- Performance counters ----- */
+
+// Hardware performance counter of the calling thread, which is unavailable if the kernel does not permit access (see perf_event_paranoid).
+class PerfCounter
+{
+
+    public:
+
+        PerfCounter(std::uint32_t type, std::uint64_t config)
+        {
+            perf_event_attr attr = {};
+            {
+                attr.size           = sizeof(attr);
+                attr.type           = type;
+                attr.config         = config;
+                attr.disabled       = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+            }
+            fd_ = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        ~PerfCounter()
+        {
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        bool IsValid() const
+        {
+            return (fd_ >= 0);
+        }
+
+        void Start()
+        {
+            if (fd_ >= 0)
+            {
+                ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        std::uint64_t Stop()
+        {
+            std::uint64_t value = 0;
+            if (fd_ >= 0)
+            {
+                ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+                if (::read(fd_, &value, sizeof(value)) != sizeof(value))
+                    value = 0;
+            }
+            return value;
+        }
+
+    private:
+
+        int fd_ = -1;
+
+};
+
+
+/* ----- Command streams ----- */
+
+// Resources that are referenced by the synthesized command streams.
+struct StreamResources
+{
+    std::vector<std::unique_ptr<LLGL::GLBufferWithVAO>> vertexBuffers;
+    std::vector<std::unique_ptr<LLGL::GLBuffer>>        indexBuffers;
+    std::vector<std::unique_ptr<LLGL::GLBuffer>>        constantBuffers;
+};
+
+static const std::uint32_t g_numResources = 16;
+
+static void CreateStreamResources(StreamResources& res)
+{
+    for (std::uint32_t i = 0; i < g_numResources; ++i)
+    {
+        res.vertexBuffers.emplace_back(new LLGL::GLBufferWithVAO(LLGL::BindFlags::VertexBuffer));
+        res.indexBuffers.emplace_back(new LLGL::GLBuffer(LLGL::BindFlags::IndexBuffer));
+        res.constantBuffers.emplace_back(new LLGL::GLBuffer(LLGL::BindFlags::ConstantBuffer));
+    }
+}
+
+// Mostly draw commands with a vertex buffer change every 64 draws.
+static void EncodeDrawHeavyStream(LLGL::CommandBuffer& cmdBuffer, const StreamResources& res, std::uint32_t numCommands)
+{
+    cmdBuffer.SetIndexBuffer(*res.indexBuffers[0], LLGL::Format::R32UInt, 0);
+
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+    {
+        if (i % 64 == 0)
+            cmdBuffer.SetVertexBuffer(*res.vertexBuffers[(i / 64) % g_numResources]);
+
+        switch (i % 4)
+        {
+            case 0:
+                cmdBuffer.Draw(3 * (i % 64 + 1), 0);
+                break;
+            case 1:
+                cmdBuffer.DrawIndexed(36, i % 128);
+                break;
+            case 2:
+                cmdBuffer.DrawIndexed(36, 0, static_cast<std::int32_t>(i % 16));
+                break;
+            case 3:
+                cmdBuffer.DrawInstanced(4, 0, 16);
+                break;
+        }
+    }
+}
+
+// Mostly binding commands with a single draw command after every eight bindings.
+static void EncodeBindHeavyStream(LLGL::CommandBuffer& cmdBuffer, const StreamResources& res, std::uint32_t numCommands)
+{
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+    {
+        switch (i % 8)
+        {
+            case 0:
+                cmdBuffer.SetVertexBuffer(*res.vertexBuffers[i % g_numResources]);
+                break;
+            case 1:
+                cmdBuffer.SetIndexBuffer(*res.indexBuffers[i % g_numResources], LLGL::Format::R16UInt, 0);
+                break;
+            case 2:
+                cmdBuffer.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(640 + i % 2), 480.0f });
+                break;
+            case 3:
+                cmdBuffer.SetScissor(LLGL::Scissor{ 0, 0, static_cast<std::int32_t>(640 + i % 2), 480 });
+                break;
+            case 7:
+                cmdBuffer.DrawIndexed(36, 0);
+                break;
+            default:
+                cmdBuffer.SetResource(*res.constantBuffers[i % g_numResources], i % 4, LLGL::BindFlags::ConstantBuffer);
+                break;
+        }
+    }
+}
+
+/*
+Mostly buffer updates with a draw command after every fourth update. Updates alternate between 256 bytes, which are passed to glBufferSubData directly,
+and 4 KB, which are streamed through the persistently mapped upload ring buffer (see GLUploadHeap).
+*/
+static void EncodeUploadHeavyStream(LLGL::CommandBuffer& cmdBuffer, const StreamResources& res, std::uint32_t numCommands)
+{
+    const std::uint16_t smallSize   = 256;
+    const std::uint16_t largeSize   = 4096;
+
+    std::uint8_t data[largeSize];
+    for (std::size_t i = 0; i < sizeof(data); ++i)
+        data[i] = static_cast<std::uint8_t>(i);
+
+    cmdBuffer.SetVertexBuffer(*res.vertexBuffers[0]);
+
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+    {
+        if (i % 5 == 4)
+            cmdBuffer.Draw(3, 0);
+        else if (i % 2 == 0)
+            cmdBuffer.UpdateBuffer(*res.constantBuffers[i % g_numResources], (i % 16) * smallSize, data, smallSize);
+        else
+            cmdBuffer.UpdateBuffer(*res.constantBuffers[i % g_numResources], 0, data, largeSize);
+    }
+}
+
+
+/* ----- Command optimizer tests ----- */
+
+// Returns the opcodes of all commands in the specified command buffer.
+static std::vector<std::uint32_t> GetOpcodes(const LLGL::GLDeferredCommandBuffer& cmdBuffer)
+{
+    std::vector<std::uint32_t> opcodes;
+    for (auto page = cmdBuffer.GetRawBuffer().GetFirstPage(); page != nullptr; page = page->next)
+    {
+        for (std::size_t offset = 0; offset < page->size;)
+        {
+            auto header = reinterpret_cast<const LLGL::GLCommandHeader*>(page->GetData() + offset);
+            opcodes.push_back(header->opcode);
+            offset += header->size;
+        }
+    }
+    return opcodes;
+}
+
+// Returns the payload of the n-th command with the specified opcode, or null if there is no such command.
+template <typename T>
+const T* FindCommand(const LLGL::GLDeferredCommandBuffer& cmdBuffer, LLGL::GLOpcode opcode, std::size_t n = 0)
+{
+    for (auto page = cmdBuffer.GetRawBuffer().GetFirstPage(); page != nullptr; page = page->next)
+    {
+        for (std::size_t offset = 0; offset < page->size;)
+        {
+            auto header = reinterpret_cast<const LLGL::GLCommandHeader*>(page->GetData() + offset);
+            if (header->opcode == opcode && n-- == 0)
+                return reinterpret_cast<const T*>(header + 1);
+            offset += header->size;
+        }
+    }
+    return nullptr;
+}
+
+static bool CheckOpcodes(const LLGL::GLDeferredCommandBuffer& cmdBuffer, const std::vector<std::uint32_t>& expected, const char* name)
+{
+    if (GetOpcodes(cmdBuffer) != expected)
+    {
+        std::cerr << name << ": unexpected command stream" << std::endl;
+        LLGL::DisassembleGLCommands(std::cerr, cmdBuffer.GetRawBuffer(), name);
+        return false;
+    }
+    return true;
+}
+
+static bool Check(bool condition, const char* name, const char* what)
+{
+    if (!condition)
+        std::cerr << name << ": check failed: " << what << std::endl;
+    return condition;
+}
+
+// Encodes binding commands that are either overwritten or leave the state unchanged, and checks which of them survive.
+static bool TestRedundantStateRemoval(const StreamResources& res)
+{
+    using namespace LLGL;
+
+    const char* name = "redundant state removal";
+
+    const LLGL::Viewport viewport0{ 0.0f, 0.0f, 640.0f, 480.0f };
+    const LLGL::Viewport viewport1{ 0.0f, 0.0f, 800.0f, 600.0f };
+
+    auto encodeStream = [&](CommandBuffer& cmdBuffer)
+    {
+        cmdBuffer.SetViewport(viewport0);                                                       // overwritten
+        cmdBuffer.SetViewport(viewport1);
+        cmdBuffer.SetVertexBuffer(*res.vertexBuffers[0]);
+        cmdBuffer.SetResource(*res.constantBuffers[0], 0, BindFlags::ConstantBuffer);           // overwritten
+        cmdBuffer.SetResource(*res.constantBuffers[1], 0, BindFlags::ConstantBuffer);
+        cmdBuffer.SetResource(*res.constantBuffers[2], 1, BindFlags::ConstantBuffer);
+        cmdBuffer.Draw(3, 0);
+        cmdBuffer.SetViewport(viewport1);                                                       // unchanged
+        cmdBuffer.SetVertexBuffer(*res.vertexBuffers[0]);                                       // unchanged
+        cmdBuffer.SetResource(*res.constantBuffers[1], 0, BindFlags::ConstantBuffer);           // unchanged
+        cmdBuffer.SetScissor(LLGL::Scissor{ 0, 0, 320, 240 });
+        cmdBuffer.SetVertexBuffer(*res.vertexBuffers[1]);                                       // overwritten
+        cmdBuffer.SetVertexBuffer(*res.vertexBuffers[2]);
+        cmdBuffer.Draw(3, 0);
+    };
+
+    /* Encode the same stream with and without optimization */
+    GLDeferredCommandBuffer unoptimized{ CommandBufferFlags::MultiSubmit };
+    unoptimized.Begin();
+    encodeStream(unoptimized);
+    unoptimized.End();
+
+    GLDeferredCommandBuffer optimized{ CommandBufferFlags::MultiSubmit | CommandBufferFlags::OptimizeStateChanges };
+    optimized.Begin();
+    encodeStream(optimized);
+    optimized.End();
+
+    bool passed = CheckOpcodes(
+        optimized,
+        {
+            GLOpcodeViewport,
+            GLOpcodeBindVertexArray,
+            GLOpcodeBindBufferBase,
+            GLOpcodeBindBufferBase,
+            GLOpcodeDrawArrays,
+            GLOpcodeScissor,
+            GLOpcodeBindVertexArray,
+            GLOpcodeDrawArrays,
+        },
+        name
+    );
+
+    /* Surviving binding commands must be the ones that determine the state */
+    if (passed)
+    {
+        auto viewportCmd = FindCommand<GLCmdViewport>(optimized, GLOpcodeViewport);
+        passed &= Check(viewportCmd->viewport.width == viewport1.width, name, "last viewport survives");
+
+        auto bufferCmd = FindCommand<GLCmdBindBufferBase>(optimized, GLOpcodeBindBufferBase);
+        passed &= Check(bufferCmd->index == 0 && bufferCmd->id == res.constantBuffers[1]->GetID(), name, "last constant buffer survives");
+
+        auto vaoCmd = FindCommand<GLCmdBindVertexArray>(optimized, GLOpcodeBindVertexArray, 1);
+        passed &= Check(vaoCmd->vao == res.vertexBuffers[2]->GetVaoID(), name, "last vertex buffer survives");
+    }
+
+    /* Optimizer must report exactly the difference to the unoptimized command stream */
+    GLCommandStats unoptimizedStats, optimizedStats;
+    unoptimized.QueryCommandStats(unoptimizedStats);
+    optimized.QueryCommandStats(optimizedStats);
+
+    passed &= Check(unoptimizedStats.optimizer.numRemovedCommands == 0, name, "no commands removed without OptimizeStateChanges");
+    passed &= Check(optimizedStats.optimizer.numRemovedCommands == 6, name, "6 commands removed");
+    passed &= Check(optimizedStats.numCommands + optimizedStats.optimizer.numRemovedCommands == unoptimizedStats.numCommands, name, "removed command count");
+    passed &= Check(optimizedStats.numBytes + optimizedStats.optimizer.numRemovedBytes == unoptimizedStats.numBytes, name, "removed byte count");
+
+    std::cout << name << ": " << (passed ? "passed" : "failed") << std::endl;
+
+    return passed;
+}
+
+// Encodes runs of indexed draw commands that are separated by state changes, and checks that each run becomes a single multi-draw command.
+static bool TestDrawBatching(const StreamResources& res, LLGL::GLStateManager& stateMngr)
+{
+    using namespace LLGL;
+
+    const char* name = "draw batching";
+
+    auto encodeStream = [&](CommandBuffer& cmdBuffer)
+    {
+        cmdBuffer.Begin();
+        {
+            cmdBuffer.SetVertexBuffer(*res.vertexBuffers[0]);
+            cmdBuffer.SetIndexBuffer(*res.indexBuffers[0], Format::R32UInt, 0);
+            cmdBuffer.DrawIndexed(36, 0);
+            cmdBuffer.DrawIndexed(36, 36);
+            cmdBuffer.DrawIndexed(36, 72, 5);
+            cmdBuffer.SetVertexBuffer(*res.vertexBuffers[1]);   // state change splits the run
+            cmdBuffer.DrawIndexed(6, 0);
+            cmdBuffer.DrawIndexedInstanced(6, 4, 6);
+            cmdBuffer.Draw(3, 0);                               // non-indexed draw splits the run
+            cmdBuffer.DrawIndexed(6, 12);                       // single draw is not merged
+        }
+        cmdBuffer.End();
+    };
+
+    GLDeferredCommandBuffer cmdBuffer{ CommandBufferFlags::BatchDrawCommands };
+    encodeStream(cmdBuffer);
+
+    bool passed = CheckOpcodes(
+        cmdBuffer,
+        {
+            GLOpcodeUploadIndirectArgs,
+            GLOpcodeBindVertexArray,
+            GLOpcodeBindElementArrayBufferToVAO,
+            GLOpcodeMultiDrawElementsIndirect,
+            GLOpcodeBindVertexArray,
+            GLOpcodeMultiDrawElementsIndirect,
+            GLOpcodeDrawArrays,
+            GLOpcodeDrawElements,
+        },
+        name
+    );
+
+    if (passed)
+    {
+        /* Check indirect arguments of both runs, which are uploaded once at the beginning of the command buffer */
+        auto uploadCmd  = FindCommand<GLCmdUploadIndirectArgs>(cmdBuffer, GLOpcodeUploadIndirectArgs);
+        auto multiDraw0 = FindCommand<GLCmdMultiDrawElementsIndirect>(cmdBuffer, GLOpcodeMultiDrawElementsIndirect, 0);
+        auto multiDraw1 = FindCommand<GLCmdMultiDrawElementsIndirect>(cmdBuffer, GLOpcodeMultiDrawElementsIndirect, 1);
+
+        const auto argsSize = static_cast<GLsizeiptr>(sizeof(GLDrawElementsIndirectCommand));
+
+        passed &= Check(uploadCmd->size == 5 * argsSize, name, "indirect arguments of 5 draw commands");
+        passed &= Check(multiDraw0->drawcount == 3 && multiDraw0->indirect == nullptr, name, "first run has 3 draw commands");
+        passed &= Check(multiDraw1->drawcount == 2 && reinterpret_cast<GLsizeiptr>(multiDraw1->indirect) == 3 * argsSize, name, "second run has 2 draw commands");
+        passed &= Check(multiDraw0->type == GL_UNSIGNED_INT && multiDraw1->type == GL_UNSIGNED_INT, name, "index type");
+
+        if (passed)
+        {
+            auto args = reinterpret_cast<const GLDrawElementsIndirectCommand*>(uploadCmd->data);
+            passed &= Check(args[0].count == 36 && args[0].firstIndex ==  0 && args[0].baseVertex == 0, name, "arguments of draw 0");
+            passed &= Check(args[1].count == 36 && args[1].firstIndex == 36 && args[1].baseVertex == 0, name, "arguments of draw 1");
+            passed &= Check(args[2].count == 36 && args[2].firstIndex == 72 && args[2].baseVertex == 5, name, "arguments of draw 2");
+            passed &= Check(args[3].count ==  6 && args[3].firstIndex ==  0 && args[3].instanceCount == 1, name, "arguments of draw 3");
+            passed &= Check(args[4].count ==  6 && args[4].firstIndex ==  6 && args[4].instanceCount == 4, name, "arguments of draw 4");
+        }
+    }
+
+    /* Replay must upload the arguments once and issue one multi-draw call per run */
+    g_multiDrawCounts.clear();
+    g_indirectUploadSize = 0;
+    ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+
+    passed &= Check(g_multiDrawCounts == std::vector<GLsizei>{ 3, 2 }, name, "replay issues multi-draw calls with 3 and 2 draws");
+    passed &= Check(g_indirectUploadSize == static_cast<GLsizeiptr>(5 * sizeof(GLDrawElementsIndirectCommand)), name, "replay uploads indirect arguments");
+
+    /* Merged draw commands must be reported */
+    GLCommandStats stats;
+    cmdBuffer.QueryCommandStats(stats);
+    passed &= Check(stats.optimizer.numMergedDrawCommands == 5, name, "5 draw commands merged");
+    passed &= Check(stats.optimizer.numRemovedCommands == 3, name, "2 runs of 3 and 2 draw commands replace 3 commands");
+
+    /* Removed bytes must cover the entire difference to the same stream without batching, including the headers of the gaps */
+    GLDeferredCommandBuffer unbatchedCmdBuffer{ 0 };
+    encodeStream(unbatchedCmdBuffer);
+
+    GLCommandStats unbatchedStats;
+    unbatchedCmdBuffer.QueryCommandStats(unbatchedStats);
+
+    const auto uploadCmdSize = GetAlignedGLCommandSize(sizeof(GLCmdUploadIndirectArgs));
+    passed &= Check(stats.numBytes + stats.optimizer.numRemovedBytes == unbatchedStats.numBytes + uploadCmdSize, name, "bytes removed by merging");
+
+    std::cout << name << ": " << (passed ? "passed" : "failed") << std::endl;
+
+    return passed;
+}
+
+// Profiles and disassembles a command buffer with the entry points of GLDeferredCommandBuffer, both with the stubbed GL functions and with the stub executor.
+static bool TestProfiling(const StreamResources& res, LLGL::GLStateManager& stateMngr)
+{
+    using namespace LLGL;
+
+    const char* name = "profiling";
+
+    const std::uint32_t numCommands     = 64;
+    const std::uint32_t numIterations   = 3;
+
+    GLDeferredCommandBuffer cmdBuffer{ CommandBufferFlags::OptimizeStateChanges | CommandBufferFlags::MultiSubmit };
+    cmdBuffer.Begin();
+    EncodeBindHeavyStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+
+    GLCommandStats queriedStats;
+    cmdBuffer.QueryCommandStats(queriedStats);
+
+    /* Profile without any GL calls */
+    GLCommandStats stubStats;
+    const auto numGLCallsBefore = g_numGLCalls;
+    cmdBuffer.ProfileCommands(stateMngr, stubStats, numIterations, ExecuteGLCommandStub);
+
+    bool passed = true;
+    passed &= Check(g_numGLCalls == numGLCallsBefore, name, "stub executor makes no GL calls");
+    passed &= Check(stubStats.frequency > 0, name, "timer frequency");
+
+    /* Profile with the default executor, which calls the stubbed GL functions */
+    GLCommandStats profiledStats;
+    cmdBuffer.ProfileCommands(stateMngr, profiledStats, numIterations);
+    passed &= Check(g_numGLCalls > numGLCallsBefore, name, "default executor makes GL calls");
+
+    /* Counters must be accumulated only once regardless of the number of iterations */
+    for (const auto* stats : { &stubStats, &profiledStats })
+    {
+        passed &= Check(stats->numCommands == queriedStats.numCommands, name, "number of profiled commands");
+        passed &= Check(stats->numBytes == queriedStats.numBytes, name, "size of profiled commands");
+        passed &= Check(stats->optimizer.numRemovedCommands == queriedStats.optimizer.numRemovedCommands, name, "optimizer statistics");
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            if (stats->opcodes[i].count != queriedStats.opcodes[i].count)
+            {
+                passed &= Check(false, name, "histogram of profiled commands");
+                break;
+            }
+        }
+    }
+
+    /* Disassembly must contain one line per command */
+    std::ostringstream disassembly;
+    cmdBuffer.Disassemble(disassembly);
+    const auto disassemblyText = disassembly.str();
+    passed &= Check(static_cast<std::size_t>(std::count(disassemblyText.begin(), disassemblyText.end(), '\n')) == queriedStats.numCommands, name, "one line of disassembly per command");
+    passed &= Check(disassemblyText.find("GLOpcodeDrawElements") != std::string::npos, name, "disassembly contains draw commands");
+
+    std::cout << name << ": " << (passed ? "passed" : "failed") << std::endl;
+
+    return passed;
+}
+
+// Submits the command buffer once and returns the checksum over its GL calls, with the same upload ring and object IDs for every submission.
+static std::uint64_t SubmitWithChecksum(const LLGL::GLDeferredCommandBuffer& cmdBuffer, LLGL::GLStateManager& stateMngr)
+{
+    LLGL::GLUploadHeap::Get().Clear();
+    g_nextObjectID      = g_replayObjectID;
+    g_glCallChecksum    = 0xcbf29ce484222325ull;
+    g_checksumEnabled   = true;
+    LLGL::ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+    g_checksumEnabled   = false;
+    return g_glCallChecksum;
+}
+
+// Returns the checksum of the specified command stream with the command interpreter.
+static std::uint64_t GetInterpreterChecksum(
+    const std::function<void(LLGL::CommandBuffer&, const StreamResources&, std::uint32_t)>& encodeStream,
+    const StreamResources&                                                                  res,
+    LLGL::GLStateManager&                                                                   stateMngr,
+    std::uint32_t                                                                           numCommands)
+{
+    LLGL::GLDeferredCommandBuffer cmdBuffer{ 0 };
+    cmdBuffer.Begin();
+    encodeStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+
+    /* Submit once before, so the checksum starts with the state that a submission of this stream leaves behind */
+    LLGL::ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+    return SubmitWithChecksum(cmdBuffer, stateMngr);
+}
+
+// Submits the command buffer until its native program has been compiled in the background and compares every submission with the reference checksum.
+static bool SubmitUntilCompiled(const LLGL::GLDeferredCommandBuffer& cmdBuffer, LLGL::GLStateManager& stateMngr, std::uint64_t checksum, const char* name)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    /* Submit once before, so the checksums start with the same state as the reference */
+    LLGL::ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+
+    bool passed = true;
+
+    /* Submissions with the command interpreter while the program is being compiled */
+    while (cmdBuffer.GetExecutable() == nullptr)
+    {
+        if (std::chrono::steady_clock::now() > timeout)
+            return Check(false, name, "background compilation finishes");
+        passed &= Check(SubmitWithChecksum(cmdBuffer, stateMngr) == checksum, name, "interpreter fallback issues the same GL calls");
+    }
+
+    /* Submission with the native program */
+    passed &= Check(SubmitWithChecksum(cmdBuffer, stateMngr) == checksum, name, "native program issues the same GL calls");
+
+    return passed;
+}
+
+// Encodes command buffers that are compiled in the background and re-encodes them while the previous compilation may still be running.
+static bool TestBackgroundCompile(const StreamResources& res, LLGL::GLStateManager& stateMngr)
+{
+    using namespace LLGL;
+
+    const char* name = "background compile";
+
+    const std::uint32_t numCommands = 4096;
+
+    /* Without JIT support, GetExecutable would never return a program */
+    {
+        GLDeferredCommandBuffer probeCmdBuffer{ 0 };
+        probeCmdBuffer.Begin();
+        probeCmdBuffer.End();
+        if (!AssembleGLDeferredCommandBuffer(probeCmdBuffer))
+        {
+            std::cout << name << ": skipped (JIT compiler not supported for this architecture)" << std::endl;
+            return true;
+        }
+    }
+
+    bool passed = true;
+
+    const auto drawHeavyChecksum = GetInterpreterChecksum(EncodeDrawHeavyStream, res, stateMngr, numCommands);
+    const auto bindHeavyChecksum = GetInterpreterChecksum(EncodeBindHeavyStream, res, stateMngr, numCommands);
+
+    /* Encode draw-heavy stream and submit it until its program is available */
+    GLDeferredCommandBuffer cmdBuffer{ CommandBufferFlags::MultiSubmit | CommandBufferFlags::BackgroundCompile };
+    cmdBuffer.Begin();
+    EncodeDrawHeavyStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+
+    passed &= SubmitUntilCompiled(cmdBuffer, stateMngr, drawHeavyChecksum, name);
+
+    /* Begin again straight after End, while the previous program is still being compiled from the same command arena */
+    cmdBuffer.Begin();
+    EncodeDrawHeavyStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+    cmdBuffer.Begin();
+    EncodeBindHeavyStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+
+    passed &= SubmitUntilCompiled(cmdBuffer, stateMngr, bindHeavyChecksum, name);
+
+    std::cout << name << ": " << (passed ? "passed" : "failed") << std::endl;
+
+    return passed;
+}
+
+static bool RunOptimizerTests(const StreamResources& res, LLGL::GLStateManager& stateMngr)
+{
+    bool passed = true;
+    passed &= TestRedundantStateRemoval(res);
+    passed &= TestDrawBatching(res, stateMngr);
+    passed &= TestProfiling(res, stateMngr);
+    passed &= TestBackgroundCompile(res, stateMngr);
+    return passed;
+}
+
+
+/* ----- Benchmark ----- */
+
+struct ReplayResult
+{
+    double          nsPerCommand    = 0.0;
+    double          l1iMissesPerCmd = -1.0; // Negative if not available
+    double          instrPerCmd     = -1.0; // Negative if not available
+    std::uint64_t   glCallsPerReplay= 0;
+    std::uint64_t   glCallChecksum  = 0;
+};
+
+static ReplayResult MeasureReplay(std::size_t numCommands, std::uint32_t numReplays, const std::function<void()>& replay)
+{
+    ReplayResult result;
+
+    /*
+    Warm up caches, then count GL calls and accumulate their checksum for a single replay with the state that a replay leaves behind.
+    The upload ring buffer is reset before, so the ring offsets of the copy commands do not depend on the previous replays.
+    */
+    replay();
+    LLGL::GLUploadHeap::Get().Clear();
+    g_nextObjectID      = g_replayObjectID;
+    g_numGLCalls        = 0;
+    g_glCallChecksum    = 0xcbf29ce484222325ull;
+    g_checksumEnabled   = true;
+    replay();
+    g_checksumEnabled   = false;
+    result.glCallsPerReplay = g_numGLCalls;
+    result.glCallChecksum   = g_glCallChecksum;
+
+    /* Measure execution time */
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0; i < numReplays; ++i)
+        replay();
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    const auto totalCommands = static_cast<double>(numCommands) * numReplays;
+    result.nsPerCommand = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count()) / totalCommands;
+
+    /* Measure instruction cache misses and retired instructions in a separate pass, so the counters do not affect the timing */
+    PerfCounter l1iMisses
+    {
+        PERF_TYPE_HW_CACHE,
+        (PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+    };
+    PerfCounter instructions{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS };
+
+    l1iMisses.Start();
+    instructions.Start();
+    {
+        for (std::uint32_t i = 0; i < numReplays; ++i)
+            replay();
+    }
+    const auto numInstructions  = instructions.Stop();
+    const auto numL1IMisses     = l1iMisses.Stop();
+
+    if (l1iMisses.IsValid())
+        result.l1iMissesPerCmd = static_cast<double>(numL1IMisses) / totalCommands;
+    if (instructions.IsValid())
+        result.instrPerCmd = static_cast<double>(numInstructions) / totalCommands;
+
+    return result;
+}
+
+static void PrintReplayResult(const char* path, const ReplayResult& result)
+{
+    std::cout << "  " << std::left << std::setw(12) << path << std::right << std::fixed;
+    std::cout << std::setw(10) << std::setprecision(2) << result.nsPerCommand << " ns/cmd";
+
+    if (result.instrPerCmd >= 0.0)
+        std::cout << std::setw(10) << std::setprecision(1) << result.instrPerCmd << " instr/cmd";
+    else
+        std::cout << std::setw(21) << "n/a instr/cmd";
+
+    if (result.l1iMissesPerCmd >= 0.0)
+        std::cout << std::setw(10) << std::setprecision(3) << result.l1iMissesPerCmd << " L1I-misses/cmd";
+    else
+        std::cout << std::setw(25) << "n/a L1I-misses/cmd";
+
+    std::cout << std::setw(10) << result.glCallsPerReplay << " GL calls";
+    std::cout << " (checksum " << std::hex << std::setw(16) << std::setfill('0') << result.glCallChecksum << std::dec << std::setfill(' ') << ')' << std::endl;
+}
+
+// Runs the benchmark for the specified command stream and returns false if the interpreter and the JIT compiled program issue different GL calls.
+static bool RunBenchmark(
+    const char*                                                                             name,
+    const std::function<void(LLGL::CommandBuffer&, const StreamResources&, std::uint32_t)>& encodeStream,
+    const StreamResources&                                                                  res,
+    LLGL::GLStateManager&                                                                   stateMngr,
+    std::uint32_t                                                                           numCommands,
+    std::uint32_t                                                                           numReplays)
+{
+    using namespace LLGL;
+
+    /* Encode command stream without JIT compilation, which is measured separately */
+    GLDeferredCommandBuffer cmdBuffer{ 0 };
+    cmdBuffer.Begin();
+    encodeStream(cmdBuffer, res, numCommands);
+    cmdBuffer.End();
+
+    GLCommandStats stats;
+    cmdBuffer.QueryCommandStats(stats);
+
+    std::cout << name << ": " << stats.numCommands << " commands, " << stats.numBytes << " bytes" << std::endl;
+
+    /* Measure compile time (average of several runs, since the first run also allocates the code heap) */
+    const std::uint32_t numCompiles = 8;
+
+    std::unique_ptr<JITProgram> program;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (std::uint32_t i = 0; i < numCompiles; ++i)
+        program = AssembleGLDeferredCommandBuffer(cmdBuffer);
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    const auto compileTime = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count()) / numCompiles;
+
+    /* Replay with the command interpreter */
+    auto interpreterResult = MeasureReplay(
+        stats.numCommands,
+        numReplays,
+        [&]()
+        {
+            ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+        }
+    );
+    PrintReplayResult("interpreter", interpreterResult);
+
+    if (!program)
+    {
+        std::cout << "  JIT compiler not supported for this architecture" << std::endl;
+        return true;
+    }
+
+    /* Replay with the native program */
+    auto entryPoint = program->GetEntryPoint();
+    auto jitResult = MeasureReplay(
+        stats.numCommands,
+        numReplays,
+        [&]()
+        {
+            entryPoint(&stateMngr);
+        }
+    );
+    PrintReplayResult("JIT", jitResult);
+
+    std::cout << "  JIT compile time: " << std::setprecision(1) << compileTime << " us";
+    std::cout << ", code size: " << program->GetSize() << " bytes";
+    std::cout << " (" << std::setprecision(1) << static_cast<double>(program->GetSize()) / stats.numCommands << " bytes/cmd)";
+    std::cout << ", speedup: " << std::setprecision(2) << interpreterResult.nsPerCommand / jitResult.nsPerCommand << "x" << std::endl;
+
+    if (interpreterResult.glCallsPerReplay != jitResult.glCallsPerReplay ||
+        interpreterResult.glCallChecksum   != jitResult.glCallChecksum)
+    {
+        std::cerr << name << ": GL calls differ between interpreter and JIT" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::uint32_t numCommands   = 10000;
+        std::uint32_t numReplays    = 1000;
+
+        if (argc > 1)
+            numCommands = static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10));
+        if (argc > 2)
+            numReplays = static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10));
+
+        InstallGLStubs();
+
+        /* State manager becomes the active one, which is required by the resources and the executor */
+        LLGL::GLStateManager stateMngr;
+
+        StreamResources res;
+        CreateStreamResources(res);
+
+        if (!RunOptimizerTests(res, stateMngr))
+            return 1;
+
+        bool passed = true;
+        passed &= RunBenchmark("draw-heavy",   EncodeDrawHeavyStream,   res, stateMngr, numCommands, numReplays);
+        passed &= RunBenchmark("bind-heavy",   EncodeBindHeavyStream,   res, stateMngr, numCommands, numReplays);
+        passed &= RunBenchmark("upload-heavy", EncodeUploadHeavyStream, res, stateMngr, numCommands, numReplays);
+        if (!passed)
+            return 1;
+
+        /* Large buffer updates of the upload-heavy stream must have been streamed through the upload ring buffer */
+        if (g_numCopiedBytes == 0)
+        {
+            std::cerr << "upload-heavy: buffer updates have not been copied from the upload ring buffer" << std::endl;
+            return 1;
+        }
+
+        auto heapStats = LLGL::JITCodeHeap::Get().GetStatistics();
+        std::cout << "JIT code heap: " << heapStats.peakReservedBytes << " bytes reserved at peak, ";
+        std::cout << heapStats.protectionChanges << " protection change(s)" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
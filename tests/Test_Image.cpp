@@ -6,7 +6,12 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/ImageStreamConverter.h>
+#include <LLGL/Timer.h>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,6 +113,199 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+void Test_ResizeFilter()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    const LLGL::Extent3D dstExtent { 200, 150, 1 };
+
+    const std::pair<LLGL::ResizeFilter, const char*> filters[] =
+    {
+        { LLGL::ResizeFilter::Nearest, "nearest" },
+        { LLGL::ResizeFilter::Linear,  "linear"  },
+        { LLGL::ResizeFilter::Box,     "box"     },
+        { LLGL::ResizeFilter::Lanczos, "lanczos" },
+        { LLGL::ResizeFilter::Kaiser,  "kaiser"  },
+    };
+
+    for (const auto& filter : filters)
+    {
+        auto img2 = img1;
+        img2.Resize(dstExtent, filter.first);
+        SaveImagePNG(img2, std::string("Output/img1-resize-") + filter.second + ".png");
+    }
+}
+
+void Test_ResizeBenchmark()
+{
+    const LLGL::Extent3D srcExtent { 2048, 2048, 1 };
+    const LLGL::Extent3D dstExtent { 1024, 1024, 1 };
+
+    const std::pair<LLGL::ResizeFilter, const char*> filters[] =
+    {
+        { LLGL::ResizeFilter::Nearest, "Nearest" },
+        { LLGL::ResizeFilter::Linear,  "Linear"  },
+        { LLGL::ResizeFilter::Box,     "Box"     },
+        { LLGL::ResizeFilter::Lanczos, "Lanczos" },
+        { LLGL::ResizeFilter::Kaiser,  "Kaiser"  },
+    };
+
+    const LLGL::DataType dataTypes[] = { LLGL::DataType::UInt8, LLGL::DataType::Float32 };
+
+    auto timer = LLGL::Timer::Create();
+
+    for (auto dataType : dataTypes)
+    {
+        LLGL::Image srcImage { srcExtent, LLGL::ImageFormat::RGBA, dataType, LLGL::ColorRGBAd { 0.2, 0.4, 0.6, 1.0 } };
+
+        for (const auto& filter : filters)
+        {
+            const int numIterations = 4;
+
+            timer->Start();
+            {
+                for (int i = 0; i < numIterations; ++i)
+                {
+                    auto img = srcImage;
+                    img.Resize(dstExtent, filter.first, ~0u);
+                }
+            }
+            auto elapsed = static_cast<double>(timer->Stop()) / static_cast<double>(timer->GetFrequency());
+
+            /* Throughput is measured in source pixels per second */
+            auto mpixPerSec = (static_cast<double>(srcExtent.width * srcExtent.height) * numIterations) / (elapsed * 1.0e6);
+
+            std::cout << "Resize " << (dataType == LLGL::DataType::UInt8 ? "UInt8  " : "Float32") << ' ' << filter.second << ": ";
+            std::cout << mpixPerSec << " MPix/s" << std::endl;
+        }
+    }
+}
+
+void Test_MipChain()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    LLGL::TextureDescriptor texDesc;
+    {
+        texDesc.type    = LLGL::TextureType::Texture2D;
+        texDesc.format  = LLGL::Format::RGBA8UNorm_sRGB;
+        texDesc.extent  = img1.GetExtent();
+    }
+    std::vector<LLGL::MipChainSubresource> mips;
+    auto mipChain = LLGL::GenerateMipChain(texDesc, img1.GetSrcDesc(), mips);
+
+    for (std::size_t i = 0; i < mips.size(); ++i)
+    {
+        LLGL::Image mip { mips[i].extent, img1.GetFormat(), img1.GetDataType() };
+        ::memcpy(mip.GetData(), mipChain.get() + mips[i].offset, mips[i].dataSize);
+        SaveImagePNG(mip, "Output/img1-mip" + std::to_string(i) + ".png");
+    }
+}
+
+void Test_Compression()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    const std::pair<LLGL::ImageFormat, const char*> formats[] =
+    {
+        { LLGL::ImageFormat::BC1, "BC1" },
+        { LLGL::ImageFormat::BC3, "BC3" },
+    };
+
+    auto timer = LLGL::Timer::Create();
+
+    for (const auto& format : formats)
+    {
+        for (int quality = 0; quality < 2; ++quality)
+        {
+            const long flags = (quality == 1 ? LLGL::ImageConversionFlags::HighQualityCompression : 0);
+
+            auto img = img1;
+
+            timer->Start();
+            {
+                img.Convert(format.first, LLGL::DataType::UInt8, ~0u, flags);
+            }
+            auto elapsed = static_cast<double>(timer->Stop()) / static_cast<double>(timer->GetFrequency());
+
+            auto mpixPerSec = static_cast<double>(img1.GetNumPixels()) / (elapsed * 1.0e6);
+
+            std::cout << "Encode " << format.second << (quality == 1 ? " (HQ)  : " : " (fast): ");
+            std::cout << mpixPerSec << " MPix/s" << std::endl;
+
+            /* Decode image again to compare it with the original */
+            img.Convert(LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, ~0u);
+            SaveImagePNG(img, std::string("Output/img1-") + format.second + (quality == 1 ? "-hq" : "-fast") + ".png");
+        }
+    }
+}
+
+void Test_SRGBConversion()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    auto timer = LLGL::Timer::Create();
+
+    /* Decode sRGB image into linear color space and encode it again, which must be lossless for 8-bit images */
+    auto img2 = img1;
+
+    timer->Start();
+    {
+        img2.Convert(LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, ~0u, LLGL::ImageConversionFlags::DecodeSRGB);
+        img2.Convert(LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, ~0u, LLGL::ImageConversionFlags::EncodeSRGB);
+    }
+    auto elapsed = static_cast<double>(timer->Stop()) / static_cast<double>(timer->GetFrequency());
+
+    auto mpixPerSec = static_cast<double>(img1.GetNumPixels()) / (elapsed * 1.0e6);
+
+    std::cout << "sRGB decode/encode: " << mpixPerSec << " MPix/s";
+    if (::memcmp(img1.GetData(), img2.GetData(), img1.GetDataSize()) == 0)
+        std::cout << " (lossless)" << std::endl;
+    else
+        std::cout << " (mismatch)" << std::endl;
+}
+
+void Test_StreamConverter()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    /* Convert entire image at once as reference */
+    auto ref = img1;
+    ref.Convert(LLGL::ImageFormat::RGBA, LLGL::DataType::Float32);
+
+    /* Stream image in odd-sized portions through a converter with a small memory ceiling */
+    LLGL::ImageStreamConverterDescriptor streamDesc;
+    {
+        streamDesc.extent       = img1.GetExtent();
+        streamDesc.dstDataType  = LLGL::DataType::Float32;
+        streamDesc.maxChunkSize = (1 << 16);
+    }
+
+    std::vector<char> output(ref.GetDataSize());
+    std::size_t numChunks = 0;
+
+    LLGL::ImageStreamConverter converter
+    {
+        streamDesc,
+        [&](const LLGL::ImageStreamChunk& chunk)
+        {
+            auto offset = ref.GetDepthStride() * chunk.offset.z + ref.GetRowStride() * chunk.offset.y;
+            ::memcpy(output.data() + offset, chunk.data, chunk.dataSize);
+            ++numChunks;
+        }
+    };
+
+    auto src = reinterpret_cast<const char*>(img1.GetData());
+    for (std::size_t pos = 0, size = img1.GetDataSize(), portion = 12345; pos < size; pos += portion)
+        converter.Write(src + pos, std::min(portion, size - pos));
+
+    std::cout << "Stream conversion: " << numChunks << " chunks, " << converter.GetMemoryFootprint() << " bytes footprint";
+    if (converter.IsComplete() && ::memcmp(output.data(), ref.GetData(), output.size()) == 0)
+        std::cout << " (match)" << std::endl;
+    else
+        std::cout << " (mismatch)" << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -115,6 +313,12 @@ int main(int argc, char* argv[])
         //Test_PixelOperations();
         //Test_Blit();
         Test_Resize();
+        Test_ResizeFilter();
+        Test_ResizeBenchmark();
+        Test_MipChain();
+        Test_Compression();
+        Test_SRGBConversion();
+        Test_StreamConverter();
     }
     catch (const std::exception& e)
     {
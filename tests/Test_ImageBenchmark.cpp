@@ -0,0 +1,524 @@
+/*
+ * Test_ImageBenchmark.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/Image.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Constants.h>
+#include "Core/Float16Compressor.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+
+
+/*
+Standalone benchmark for the CPU side image processing, i.e. no render system is required.
+Usage: Test_ImageBenchmark [--csv | --json] [--output FILE] [--sizes N,...] [--threads N,...] [--min-time SECONDS] [--all-pairs]
+Results are written as JSON (default) or CSV to the output file or to the standard output. Progress is printed to the standard error.
+*/
+
+
+/* ----- Options ----- */
+
+struct BenchmarkOptions
+{
+    bool                        csv         = false;
+    bool                        allPairs    = false;
+    std::string                 output;
+    std::vector<std::uint32_t>  sizes       = { 256, 1024, 2048 };
+    std::vector<std::uint32_t>  threads     = { 1, 4, LLGL::Constants::maxThreadCount };
+    double                      minTime     = 0.1;
+};
+
+struct BenchmarkResult
+{
+    std::string     name;
+    std::string     srcFormat;
+    std::string     dstFormat;
+    std::uint32_t   width       = 0;
+    std::uint32_t   height      = 0;
+    std::uint32_t   threads     = 1;
+    std::uint32_t   iterations  = 0;
+    double          seconds     = 0.0;  // Best time of a single iteration
+    double          mpixPerSec  = 0.0;
+    double          mbPerSec    = 0.0;  // Throughput of the source data
+};
+
+static std::vector<std::uint32_t> ParseList(const char* s)
+{
+    std::vector<std::uint32_t> list;
+    std::stringstream stream(s);
+    for (std::string item; std::getline(stream, item, ',');)
+    {
+        if (item == "max")
+            list.push_back(LLGL::Constants::maxThreadCount);
+        else
+            list.push_back(static_cast<std::uint32_t>(std::stoul(item)));
+    }
+    return list;
+}
+
+static BenchmarkOptions ParseOptions(int argc, char* argv[])
+{
+    BenchmarkOptions opt;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+
+        if (arg == "--csv")
+            opt.csv = true;
+        else if (arg == "--json")
+            opt.csv = false;
+        else if (arg == "--all-pairs")
+            opt.allPairs = true;
+        else if (arg == "--output" && hasValue)
+            opt.output = argv[++i];
+        else if (arg == "--sizes" && hasValue)
+            opt.sizes = ParseList(argv[++i]);
+        else if (arg == "--threads" && hasValue)
+            opt.threads = ParseList(argv[++i]);
+        else if (arg == "--min-time" && hasValue)
+            opt.minTime = std::atof(argv[++i]);
+        else
+            throw std::invalid_argument("invalid argument: " + arg);
+    }
+
+    return opt;
+}
+
+
+/* ----- Names ----- */
+
+static const LLGL::ImageFormat g_colorFormats[] =
+{
+    LLGL::ImageFormat::Alpha,
+    LLGL::ImageFormat::R,
+    LLGL::ImageFormat::RG,
+    LLGL::ImageFormat::RGB,
+    LLGL::ImageFormat::BGR,
+    LLGL::ImageFormat::RGBA,
+    LLGL::ImageFormat::BGRA,
+    LLGL::ImageFormat::ARGB,
+    LLGL::ImageFormat::ABGR,
+};
+
+static const LLGL::ImageFormat g_compressedFormats[] =
+{
+    LLGL::ImageFormat::BC1,
+    LLGL::ImageFormat::BC2,
+    LLGL::ImageFormat::BC3,
+    LLGL::ImageFormat::BC4,
+    LLGL::ImageFormat::BC5,
+};
+
+static const LLGL::DataType g_dataTypes[] =
+{
+    LLGL::DataType::Int8,
+    LLGL::DataType::UInt8,
+    LLGL::DataType::Int16,
+    LLGL::DataType::UInt16,
+    LLGL::DataType::Int32,
+    LLGL::DataType::UInt32,
+    LLGL::DataType::Float16,
+    LLGL::DataType::Float32,
+    LLGL::DataType::Float64,
+};
+
+static const char* FormatName(LLGL::ImageFormat format)
+{
+    switch (format)
+    {
+        case LLGL::ImageFormat::Alpha:          return "Alpha";
+        case LLGL::ImageFormat::R:              return "R";
+        case LLGL::ImageFormat::RG:             return "RG";
+        case LLGL::ImageFormat::RGB:            return "RGB";
+        case LLGL::ImageFormat::BGR:            return "BGR";
+        case LLGL::ImageFormat::RGBA:           return "RGBA";
+        case LLGL::ImageFormat::BGRA:           return "BGRA";
+        case LLGL::ImageFormat::ARGB:           return "ARGB";
+        case LLGL::ImageFormat::ABGR:           return "ABGR";
+        case LLGL::ImageFormat::Depth:          return "Depth";
+        case LLGL::ImageFormat::DepthStencil:   return "DepthStencil";
+        case LLGL::ImageFormat::BC1:            return "BC1";
+        case LLGL::ImageFormat::BC2:            return "BC2";
+        case LLGL::ImageFormat::BC3:            return "BC3";
+        case LLGL::ImageFormat::BC4:            return "BC4";
+        case LLGL::ImageFormat::BC5:            return "BC5";
+    }
+    return "";
+}
+
+static const char* DataTypeName(LLGL::DataType dataType)
+{
+    switch (dataType)
+    {
+        case LLGL::DataType::Undefined: return "Undefined";
+        case LLGL::DataType::Int8:      return "Int8";
+        case LLGL::DataType::UInt8:     return "UInt8";
+        case LLGL::DataType::Int16:     return "Int16";
+        case LLGL::DataType::UInt16:    return "UInt16";
+        case LLGL::DataType::Int32:     return "Int32";
+        case LLGL::DataType::UInt32:    return "UInt32";
+        case LLGL::DataType::Float16:   return "Float16";
+        case LLGL::DataType::Float32:   return "Float32";
+        case LLGL::DataType::Float64:   return "Float64";
+    }
+    return "";
+}
+
+static std::string ImageTypeName(LLGL::ImageFormat format, LLGL::DataType dataType)
+{
+    if (LLGL::IsCompressedFormat(format))
+        return FormatName(format);
+    else
+        return std::string(FormatName(format)) + "/" + DataTypeName(dataType);
+}
+
+
+/* ----- Benchmark ----- */
+
+class ImageBenchmark
+{
+
+    public:
+
+        ImageBenchmark(const BenchmarkOptions& options) :
+            options_ { options                },
+            timer_   { LLGL::Timer::Create()  }
+        {
+        }
+
+        void RunAll()
+        {
+            for (auto size : options_.sizes)
+            {
+                const LLGL::Extent3D extent{ size, size, 1 };
+                RunConversion(extent);
+                RunCopy(extent);
+                RunGenerate(extent);
+                RunFloat16(extent);
+            }
+        }
+
+        void WriteResults(std::ostream& s) const
+        {
+            if (options_.csv)
+                WriteCSV(s);
+            else
+                WriteJSON(s);
+        }
+
+    private:
+
+        // Measures the best time of the specified function, which is repeated until the minimum time has elapsed.
+        void Measure(
+            BenchmarkResult                 result,
+            std::size_t                     srcDataSize,
+            const std::function<void()>&    func)
+        {
+            const auto frequency = static_cast<double>(timer_->GetFrequency());
+
+            double best = 0.0, total = 0.0;
+
+            do
+            {
+                timer_->Start();
+                {
+                    func();
+                }
+                const auto elapsed = static_cast<double>(timer_->Stop()) / frequency;
+
+                if (result.iterations == 0 || elapsed < best)
+                    best = elapsed;
+
+                total += elapsed;
+                ++result.iterations;
+            }
+            while (total < options_.minTime && result.iterations < 1000);
+
+            const auto numPixels = static_cast<double>(result.width) * static_cast<double>(result.height);
+
+            result.seconds      = best;
+            result.mpixPerSec   = (best > 0.0 ? numPixels / (best * 1.0e6) : 0.0);
+            result.mbPerSec     = (best > 0.0 ? static_cast<double>(srcDataSize) / (best * 1.0e6) : 0.0);
+
+            std::cerr << result.name << " " << result.srcFormat << " -> " << result.dstFormat << " (" << result.width << "x" << result.height;
+            std::cerr << ", " << result.threads << " threads): " << result.mpixPerSec << " MPix/s" << std::endl;
+
+            results_.push_back(result);
+        }
+
+        BenchmarkResult MakeResult(const char* name, const std::string& srcFormat, const std::string& dstFormat, const LLGL::Extent3D& extent, std::uint32_t threads = 1)
+        {
+            BenchmarkResult result;
+            {
+                result.name         = name;
+                result.srcFormat    = srcFormat;
+                result.dstFormat    = dstFormat;
+                result.width        = extent.width;
+                result.height       = extent.height;
+                result.threads      = threads;
+            }
+            return result;
+        }
+
+        void RunConversionPair(
+            const LLGL::Extent3D&   extent,
+            LLGL::ImageFormat       srcFormat,
+            LLGL::DataType          srcDataType,
+            LLGL::ImageFormat       dstFormat,
+            LLGL::DataType          dstDataType)
+        {
+            if (srcFormat == dstFormat && srcDataType == dstDataType)
+                return;
+
+            /* Generate source image with a gradient, so that compression does not take shortcuts on uniform blocks */
+            LLGL::Image srcImage{ extent, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8 };
+            {
+                auto pixels = reinterpret_cast<std::uint8_t*>(srcImage.GetData());
+                for (std::size_t i = 0, n = srcImage.GetDataSize(); i < n; ++i)
+                    pixels[i] = static_cast<std::uint8_t>((i * 7) ^ (i >> 5));
+            }
+            srcImage.Convert(srcFormat, srcDataType);
+
+            LLGL::Image dstImage{ extent, dstFormat, dstDataType };
+
+            for (auto threads : options_.threads)
+            {
+                if (threads >= LLGL::Constants::maxThreadCount)
+                    threads = std::max(1u, std::thread::hardware_concurrency());
+
+                Measure(
+                    MakeResult("ConvertImageBuffer", ImageTypeName(srcFormat, srcDataType), ImageTypeName(dstFormat, dstDataType), extent, threads),
+                    srcImage.GetDataSize(),
+                    [&]()
+                    {
+                        LLGL::ConvertImageBuffer(srcImage.GetSrcDesc(), dstImage.GetDstDesc(), extent, threads);
+                    }
+                );
+            }
+        }
+
+        void RunConversion(const LLGL::Extent3D& extent)
+        {
+            const auto refFormat    = LLGL::ImageFormat::RGBA;
+            const auto refDataType  = LLGL::DataType::UInt8;
+
+            if (options_.allPairs)
+            {
+                /* Convert between every pair of uncompressed format and data type */
+                for (auto srcFormat : g_colorFormats)
+                {
+                    for (auto srcDataType : g_dataTypes)
+                    {
+                        for (auto dstFormat : g_colorFormats)
+                        {
+                            for (auto dstDataType : g_dataTypes)
+                                RunConversionPair(extent, srcFormat, srcDataType, dstFormat, dstDataType);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                /* Convert every format and data type from and to RGBA/UInt8 */
+                for (auto format : g_colorFormats)
+                {
+                    for (auto dataType : g_dataTypes)
+                    {
+                        RunConversionPair(extent, refFormat, refDataType, format, dataType);
+                        RunConversionPair(extent, format, dataType, refFormat, refDataType);
+                    }
+                }
+            }
+
+            /* Encode and decode compressed formats */
+            for (auto format : g_compressedFormats)
+            {
+                RunConversionPair(extent, refFormat, refDataType, format, refDataType);
+                RunConversionPair(extent, format, refDataType, refFormat, refDataType);
+            }
+        }
+
+        void RunCopy(const LLGL::Extent3D& extent)
+        {
+            const auto format   = LLGL::ImageFormat::RGBA;
+            const auto dataType = LLGL::DataType::UInt8;
+            const auto typeName = ImageTypeName(format, dataType);
+
+            LLGL::Image srcImage{ extent, format, dataType, LLGL::ColorRGBAd{ 1.0, 0.5, 0.25, 1.0 } };
+            LLGL::Image dstImage{ extent, format, dataType };
+
+            /* Copy inner region, so that rows are not contiguous and must be copied individually */
+            const LLGL::Extent3D    regionExtent{ extent.width / 2, extent.height / 2, 1 };
+            const LLGL::Offset3D    regionOffset{ static_cast<std::int32_t>(extent.width / 4), static_cast<std::int32_t>(extent.height / 4), 0 };
+            const auto              regionSize  = static_cast<std::size_t>(regionExtent.width) * regionExtent.height * srcImage.GetBytesPerPixel();
+
+            Measure(
+                MakeResult("CopyImageBufferRegion", typeName, typeName, regionExtent),
+                regionSize,
+                [&]()
+                {
+                    LLGL::CopyImageBufferRegion(
+                        dstImage.GetDstDesc(), regionOffset, extent.width, extent.width * extent.height,
+                        srcImage.GetSrcDesc(), regionOffset, extent.width, extent.width * extent.height,
+                        regionExtent
+                    );
+                }
+            );
+
+            Measure(
+                MakeResult("Image::Blit", typeName, typeName, regionExtent),
+                regionSize,
+                [&]()
+                {
+                    dstImage.Blit(regionOffset, srcImage, regionOffset, regionExtent);
+                }
+            );
+
+            Measure(
+                MakeResult("Image::Blit (overlap)", typeName, typeName, regionExtent),
+                regionSize,
+                [&]()
+                {
+                    dstImage.Blit(LLGL::Offset3D{ 1, 1, 0 }, dstImage, regionOffset, regionExtent);
+                }
+            );
+
+            Measure(
+                MakeResult("Image::MirrorYZPlane", typeName, typeName, extent),
+                srcImage.GetDataSize(),
+                [&]() { srcImage.MirrorYZPlane(); }
+            );
+
+            Measure(
+                MakeResult("Image::MirrorXZPlane", typeName, typeName, extent),
+                srcImage.GetDataSize(),
+                [&]() { srcImage.MirrorXZPlane(); }
+            );
+
+            Measure(
+                MakeResult("Image::MirrorXYPlane", typeName, typeName, extent),
+                srcImage.GetDataSize(),
+                [&]() { srcImage.MirrorXYPlane(); }
+            );
+        }
+
+        void RunGenerate(const LLGL::Extent3D& extent)
+        {
+            const auto numPixels = static_cast<std::size_t>(extent.width) * extent.height;
+
+            for (auto dataType : g_dataTypes)
+            {
+                const auto typeName = ImageTypeName(LLGL::ImageFormat::RGBA, dataType);
+
+                Measure(
+                    MakeResult("GenerateImageBuffer", typeName, typeName, extent),
+                    LLGL::GetMemoryFootprint(LLGL::ImageFormat::RGBA, dataType, numPixels),
+                    [&]()
+                    {
+                        LLGL::GenerateImageBuffer(LLGL::ImageFormat::RGBA, dataType, numPixels, LLGL::ColorRGBAd{ 1.0, 0.5, 0.25, 1.0 });
+                    }
+                );
+            }
+        }
+
+        void RunFloat16(const LLGL::Extent3D& extent)
+        {
+            const auto numComponents = static_cast<std::size_t>(extent.width) * extent.height * 4;
+
+            std::vector<float>          floats(numComponents);
+            std::vector<std::uint16_t>  halves(numComponents);
+
+            for (std::size_t i = 0; i < numComponents; ++i)
+                floats[i] = static_cast<float>(i % 4096) / 256.0f - 8.0f;
+
+            Measure(
+                MakeResult("CompressFloat16Array", "RGBA/Float32", "RGBA/Float16", extent),
+                numComponents * sizeof(float),
+                [&]() { LLGL::CompressFloat16Array(floats.data(), halves.data(), numComponents); }
+            );
+
+            Measure(
+                MakeResult("DecompressFloat16Array", "RGBA/Float16", "RGBA/Float32", extent),
+                numComponents * sizeof(std::uint16_t),
+                [&]() { LLGL::DecompressFloat16Array(halves.data(), floats.data(), numComponents); }
+            );
+        }
+
+        void WriteCSV(std::ostream& s) const
+        {
+            s << "name,src,dst,width,height,threads,iterations,seconds,mpix_per_sec,mb_per_sec\n";
+            for (const auto& r : results_)
+            {
+                s << '"' << r.name << "\"," << r.srcFormat << ',' << r.dstFormat << ',' << r.width << ',' << r.height << ',';
+                s << r.threads << ',' << r.iterations << ',' << r.seconds << ',' << r.mpixPerSec << ',' << r.mbPerSec << '\n';
+            }
+        }
+
+        void WriteJSON(std::ostream& s) const
+        {
+            s << "{\n  \"results\": [\n";
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                const auto& r = results_[i];
+                s << "    { \"name\": \"" << r.name << "\", \"src\": \"" << r.srcFormat << "\", \"dst\": \"" << r.dstFormat << "\"";
+                s << ", \"width\": " << r.width << ", \"height\": " << r.height << ", \"threads\": " << r.threads;
+                s << ", \"iterations\": " << r.iterations << ", \"seconds\": " << r.seconds;
+                s << ", \"mpix_per_sec\": " << r.mpixPerSec << ", \"mb_per_sec\": " << r.mbPerSec << " }";
+                s << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+            s << "  ]\n}\n";
+        }
+
+    private:
+
+        BenchmarkOptions                options_;
+        std::unique_ptr<LLGL::Timer>    timer_;
+        std::vector<BenchmarkResult>    results_;
+
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto options = ParseOptions(argc, argv);
+
+        ImageBenchmark benchmark{ options };
+        benchmark.RunAll();
+
+        if (options.output.empty())
+            benchmark.WriteResults(std::cout);
+        else
+        {
+            std::ofstream file{ options.output };
+            if (!file.good())
+                throw std::runtime_error("failed to open output file: " + options.output);
+            benchmark.WriteResults(file);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+// ================================================================================
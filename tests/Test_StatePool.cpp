@@ -0,0 +1,210 @@
+/*
+ * Test_StatePool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "Renderer/OpenGL/RenderState/GLStatePool.h"
+#include "Renderer/OpenGL/RenderState/GLStateManager.h"
+#include "Renderer/OpenGL/RenderState/GLPipelineLayout.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+
+/*
+Stress test for the shared depth-stencil, rasterizer, blend states, and binding layouts of the GL state pool.
+Acquires the render states of a large number of graphics pipelines that all have different render states directly from the pool,
+in the same way as GLGraphicsPSO and GLPipelineState do, so no GL context is required.
+Checks that identical descriptors share the same state objects and that the pool is empty after all pipelines have been released.
+Usage: Test_StatePool [NUM_PIPELINES]
+*/
+
+
+static const std::size_t g_numPipelineLayouts = 64;
+
+// Shared render states of a single graphics pipeline.
+struct PipelineStates
+{
+    LLGL::GLDepthStencilStateSPtr   depthStencilState;
+    LLGL::GLRasterizerStateSPtr     rasterizerState;
+    LLGL::GLBlendStateSPtr          blendState;
+    LLGL::GLShaderBindingLayoutSPtr shaderBindingLayout;
+};
+
+static double TicksToMilliseconds(const LLGL::Timer& timer, std::uint64_t ticks)
+{
+    return (static_cast<double>(ticks) * 1000.0 / static_cast<double>(timer.GetFrequency()));
+}
+
+// Returns the descriptor of the i-th pipeline with a unique depth-stencil, rasterizer, and blend state.
+static LLGL::GraphicsPipelineDescriptor GetPipelineDesc(std::size_t i)
+{
+    LLGL::GraphicsPipelineDescriptor pipelineDesc;
+    {
+        pipelineDesc.depth.testEnabled                      = true;
+        pipelineDesc.depth.writeEnabled                     = ((i & 0x1) != 0);
+        pipelineDesc.stencil.testEnabled                    = true;
+        pipelineDesc.stencil.front.reference                = static_cast<std::uint32_t>(i);
+        pipelineDesc.stencil.back.reference                 = static_cast<std::uint32_t>(i);
+        pipelineDesc.rasterizer.depthBias.constantFactor    = static_cast<float>(i);
+        pipelineDesc.blend.blendFactor                      = { static_cast<float>(i), 0.0f, 0.0f, 1.0f };
+        pipelineDesc.blend.targets[0].blendEnabled          = ((i & 0x2) != 0);
+    }
+    return pipelineDesc;
+}
+
+static void CreatePipelineStates(PipelineStates& states, std::size_t i, const std::vector<std::unique_ptr<LLGL::GLPipelineLayout>>& pipelineLayouts)
+{
+    auto& pool = LLGL::GLStatePool::Get();
+    const auto pipelineDesc = GetPipelineDesc(i);
+    states.depthStencilState    = pool.CreateDepthStencilState(pipelineDesc.depth, pipelineDesc.stencil);
+    states.rasterizerState      = pool.CreateRasterizerState(pipelineDesc.rasterizer);
+    states.blendState           = pool.CreateBlendState(pipelineDesc.blend, 1);
+    states.shaderBindingLayout  = pool.CreateShaderBindingLayout(*pipelineLayouts[i % pipelineLayouts.size()]);
+}
+
+static void ReleasePipelineStates(PipelineStates& states)
+{
+    auto& pool = LLGL::GLStatePool::Get();
+    pool.ReleaseDepthStencilState(std::move(states.depthStencilState));
+    pool.ReleaseRasterizerState(std::move(states.rasterizerState));
+    pool.ReleaseBlendState(std::move(states.blendState));
+    pool.ReleaseShaderBindingLayout(std::move(states.shaderBindingLayout));
+
+    // Drop remaining references to states that are still shared, as the destructor of GLGraphicsPSO does
+    states = PipelineStates{};
+}
+
+static bool CheckPoolStatistics(std::size_t numStates, std::size_t numBindingLayouts, const char* what)
+{
+    const auto stats = LLGL::GLStatePool::Get().GetStatistics();
+    if (stats.numDepthStencilStates     != numStates ||
+        stats.numRasterizerStates       != numStates ||
+        stats.numBlendStates            != numStates ||
+        stats.numShaderBindingLayouts   != numBindingLayouts)
+    {
+        std::cerr << what << ": pool contains ";
+        std::cerr << stats.numDepthStencilStates << " depth-stencil states, ";
+        std::cerr << stats.numRasterizerStates << " rasterizer states, ";
+        std::cerr << stats.numBlendStates << " blend states, ";
+        std::cerr << stats.numShaderBindingLayouts << " binding layouts";
+        std::cerr << " (expected " << numStates << ", " << numStates << ", " << numStates << ", " << numBindingLayouts << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::size_t numPipelines = 100000;
+        if (argc > 1)
+            numPipelines = static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10));
+
+        // State manager becomes the active one, which is notified when states are released
+        LLGL::GLStateManager stateMngr;
+
+        // Create pipeline layouts with different binding slots for the shader binding layouts
+        std::vector<std::unique_ptr<LLGL::GLPipelineLayout>> pipelineLayouts;
+
+        for (std::size_t i = 0; i < g_numPipelineLayouts; ++i)
+        {
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings =
+                {
+                    LLGL::BindingDescriptor{ "Settings", LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::VertexStage, static_cast<std::uint32_t>(i) }
+                };
+            }
+            pipelineLayouts.emplace_back(new LLGL::GLPipelineLayout{ layoutDesc });
+        }
+
+        const auto numBindingLayouts = std::min(numPipelines, g_numPipelineLayouts);
+
+        bool passed = true;
+
+        // Create pipelines with unique render states
+        auto timer = LLGL::Timer::Create();
+
+        std::vector<PipelineStates> pipelines(numPipelines);
+
+        timer->Start();
+        {
+            for (std::size_t i = 0; i < numPipelines; ++i)
+                CreatePipelineStates(pipelines[i], i, pipelineLayouts);
+        }
+        auto createTicks = timer->Stop();
+
+        passed &= CheckPoolStatistics(numPipelines, numBindingLayouts, "create unique states");
+
+        // Create the same pipelines once again, which must share all render states with the previous ones
+        std::vector<PipelineStates> sharedPipelines(numPipelines);
+
+        timer->Start();
+        {
+            for (std::size_t i = 0; i < numPipelines; ++i)
+                CreatePipelineStates(sharedPipelines[i], i, pipelineLayouts);
+        }
+        auto createSharedTicks = timer->Stop();
+
+        passed &= CheckPoolStatistics(numPipelines, numBindingLayouts, "create shared states");
+
+        for (std::size_t i = 0; i < numPipelines; ++i)
+        {
+            if (sharedPipelines[i].depthStencilState    != pipelines[i].depthStencilState   ||
+                sharedPipelines[i].rasterizerState      != pipelines[i].rasterizerState     ||
+                sharedPipelines[i].blendState           != pipelines[i].blendState          ||
+                sharedPipelines[i].shaderBindingLayout  != pipelines[i].shaderBindingLayout)
+            {
+                std::cerr << "create shared states: pipeline " << i << " does not share its states with the identical pipeline" << std::endl;
+                passed = false;
+                break;
+            }
+        }
+
+        // Release all pipelines in a different order than they have been created
+        timer->Start();
+        {
+            for (std::size_t i = 0; i < numPipelines; i += 2)
+                ReleasePipelineStates(sharedPipelines[i]);
+            for (std::size_t i = 1; i < numPipelines; i += 2)
+                ReleasePipelineStates(sharedPipelines[i]);
+        }
+        auto releaseSharedTicks = timer->Stop();
+
+        passed &= CheckPoolStatistics(numPipelines, numBindingLayouts, "release shared states");
+
+        timer->Start();
+        {
+            for (std::size_t i = numPipelines; i-- > 0;)
+                ReleasePipelineStates(pipelines[i]);
+        }
+        auto releaseTicks = timer->Stop();
+
+        passed &= CheckPoolStatistics(0, 0, "release all states");
+
+        // Print results
+        std::cout << "pipelines:                " << numPipelines << std::endl;
+        std::cout << "create unique states:     " << TicksToMilliseconds(*timer, createTicks) << " ms" << std::endl;
+        std::cout << "create shared states:     " << TicksToMilliseconds(*timer, createSharedTicks) << " ms" << std::endl;
+        std::cout << "release shared states:    " << TicksToMilliseconds(*timer, releaseSharedTicks) << " ms" << std::endl;
+        std::cout << "release all states:       " << TicksToMilliseconds(*timer, releaseTicks) << " ms" << std::endl;
+        std::cout << "state pool test: " << (passed ? "passed" : "failed") << std::endl;
+
+        if (!passed)
+            return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Test_ThreadPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Core/ThreadPool.h"
+#include <LLGL/Constants.h>
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+
+
+// Runs ParallelFor on a loader thread while the main thread resizes the pool, and checks that every index is processed exactly once.
+static bool Test_ThreadPoolResize()
+{
+    const std::size_t   count           = 100000;
+    const int           numIterations   = 200;
+    const std::size_t   numWorkerCounts = 6;
+
+    LLGL::ThreadPool pool { 3 };
+
+    std::atomic<bool>   done        { false };
+    std::size_t         numErrors   = 0;
+    int                 numJobs     = 0;
+
+    std::thread loader(
+        [&]()
+        {
+            std::unique_ptr<std::atomic<std::uint32_t>[]> visits { new std::atomic<std::uint32_t>[count] };
+
+            for (numJobs = 0; numJobs < numIterations; ++numJobs)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    visits[i] = 0;
+
+                pool.ParallelFor(
+                    count,
+                    64,
+                    LLGL::Constants::maxThreadCount,
+                    [&visits](std::size_t idxBegin, std::size_t idxEnd)
+                    {
+                        for (auto i = idxBegin; i < idxEnd; ++i)
+                            visits[i]++;
+                    }
+                );
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (visits[i] != 1)
+                    {
+                        std::cerr << "ParallelFor visited index " << i << " " << visits[i] << " times in job " << numJobs << std::endl;
+                        ++numErrors;
+                        break;
+                    }
+                }
+            }
+
+            done = true;
+        }
+    );
+
+    /* Resize the pool as long as the loader thread is running, including resizes to no worker threads at all */
+    std::size_t numResizes = 0;
+    while (!done)
+    {
+        pool.SetNumWorkers(numResizes % numWorkerCounts);
+        ++numResizes;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    loader.join();
+
+    pool.SetNumWorkers(2);
+    if (pool.GetNumWorkers() != 2)
+    {
+        std::cerr << "GetNumWorkers returned " << pool.GetNumWorkers() << " (expected 2)" << std::endl;
+        ++numErrors;
+    }
+
+    if (numErrors == 0)
+        std::cout << "ThreadPool resize test (" << numJobs << " jobs, " << numResizes << " resizes): passed" << std::endl;
+    else
+        std::cout << "ThreadPool resize test: " << numErrors << " errors" << std::endl;
+
+    return (numErrors == 0);
+}
+
+// Resizes the pool concurrently from several threads while ParallelFor is nested within the tasks of another thread.
+static bool Test_ThreadPoolNestedResize()
+{
+    LLGL::ThreadPool pool { 2 };
+
+    std::atomic<bool>           done    { false };
+    std::atomic<std::size_t>    total   { 0 };
+
+    std::thread loader(
+        [&]()
+        {
+            for (int j = 0; j < 50; ++j)
+            {
+                pool.ParallelFor(
+                    64,
+                    1,
+                    LLGL::Constants::maxThreadCount,
+                    [&](std::size_t idxBegin, std::size_t idxEnd)
+                    {
+                        for (auto i = idxBegin; i < idxEnd; ++i)
+                        {
+                            pool.ParallelFor(
+                                256,
+                                16,
+                                LLGL::Constants::maxThreadCount,
+                                [&total](std::size_t begin, std::size_t end)
+                                {
+                                    total += (end - begin);
+                                }
+                            );
+                        }
+                    }
+                );
+            }
+            done = true;
+        }
+    );
+
+    std::vector<std::thread> resizers;
+    for (std::size_t t = 0; t < 2; ++t)
+    {
+        resizers.emplace_back(
+            [&pool, &done, t]()
+            {
+                for (std::size_t n = 0; !done; ++n)
+                    pool.SetNumWorkers((n + t) % 4);
+            }
+        );
+    }
+
+    loader.join();
+    for (auto& t : resizers)
+        t.join();
+
+    const std::size_t expected = 50 * 64 * 256;
+    if (total != expected)
+    {
+        std::cout << "ThreadPool nested resize test: processed " << total << " indices (expected " << expected << ")" << std::endl;
+        return false;
+    }
+
+    std::cout << "ThreadPool nested resize test: passed" << std::endl;
+    return true;
+}
+
+int main()
+{
+    try
+    {
+        if (!Test_ThreadPoolResize())
+            return 1;
+        if (!Test_ThreadPoolNestedResize())
+            return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,268 @@
+/*
+ * Test_VKDeviceMemory.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Renderer/Vulkan/Memory/VKDeviceMemoryManager.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+/*
+Test and benchmark for the TLSF allocator of the Vulkan device memory manager.
+The Vulkan memory entry points are replaced by the definitions in this executable (see ENABLE_EXPORTS),
+so the allocator runs against a fake VkDevice and no Vulkan driver is required.
+Usage: Test_VKDeviceMemory [NUM_OPERATIONS]
+*/
+
+
+/* ----- Vulkan stubs ----- */
+
+static std::uint64_t    g_nextMemoryHandle  = 1;
+static std::size_t      g_numAllocations    = 0;
+static char             g_mappedMemory[256];
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateMemory(VkDevice, const VkMemoryAllocateInfo*, const VkAllocationCallbacks*, VkDeviceMemory* pMemory)
+{
+    *pMemory = reinterpret_cast<VkDeviceMemory>(g_nextMemoryHandle++);
+    ++g_numAllocations;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkFreeMemory(VkDevice, VkDeviceMemory, const VkAllocationCallbacks*)
+{
+    --g_numAllocations;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkMapMemory(VkDevice, VkDeviceMemory, VkDeviceSize, VkDeviceSize, VkMemoryMapFlags, void** ppData)
+{
+    *ppData = g_mappedMemory;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkUnmapMemory(VkDevice, VkDeviceMemory)
+{
+}
+
+
+/* ----- Helpers ----- */
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("check failed: " + info);
+}
+
+// Returns the memory properties of a fake device with one device-local and one host-visible memory type.
+static VkPhysicalDeviceMemoryProperties GetFakeMemoryProperties()
+{
+    VkPhysicalDeviceMemoryProperties props = {};
+    {
+        props.memoryTypeCount               = 2;
+        props.memoryTypes[0].propertyFlags  = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        props.memoryTypes[0].heapIndex      = 0;
+        props.memoryTypes[1].propertyFlags  = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        props.memoryTypes[1].heapIndex      = 1;
+        props.memoryHeapCount               = 2;
+        props.memoryHeaps[0].size           = (VkDeviceSize(1) << 32);
+        props.memoryHeaps[1].size           = (VkDeviceSize(1) << 30);
+    }
+    return props;
+}
+
+// Returns true if the two regions of the same chunk violate the buffer-image granularity.
+static bool ViolatesGranularity(const LLGL::VKDeviceMemoryRegion& lower, const LLGL::VKDeviceMemoryRegion& upper, VkDeviceSize granularity)
+{
+    if (lower.GetLayout() == upper.GetLayout())
+        return false;
+    const auto pageMask = ~(granularity - 1);
+    return (((lower.GetOffsetWithSize() - 1) & pageMask) == (upper.GetOffset() & pageMask));
+}
+
+// Validates that the live regions do not overlap and are separated by the buffer-image granularity.
+static void ValidateRegions(std::vector<LLGL::VKDeviceMemoryRegion*> regions, VkDeviceSize granularity)
+{
+    std::sort(
+        regions.begin(), regions.end(),
+        [](const LLGL::VKDeviceMemoryRegion* lhs, const LLGL::VKDeviceMemoryRegion* rhs)
+        {
+            if (lhs->GetParentChunk() != rhs->GetParentChunk())
+                return (lhs->GetParentChunk() < rhs->GetParentChunk());
+            return (lhs->GetOffset() < rhs->GetOffset());
+        }
+    );
+
+    for (std::size_t i = 1; i < regions.size(); ++i)
+    {
+        const auto& lower = *regions[i - 1];
+        const auto& upper = *regions[i];
+        if (lower.GetParentChunk() == upper.GetParentChunk())
+        {
+            Check(lower.GetOffsetWithSize() <= upper.GetOffset(), "regions overlap");
+            Check(!ViolatesGranularity(lower, upper, granularity), "linear and non-linear regions share a page");
+        }
+        Check(upper.GetOffsetWithSize() <= upper.GetParentChunk()->GetSize(), "region exceeds its chunk");
+    }
+}
+
+
+/* ----- Tests ----- */
+
+// Allocates blocks within a single chunk and checks their placement and the merging of released blocks.
+static void TestChunk(const LLGL::VKPtr<VkDevice>& device)
+{
+    using namespace LLGL;
+
+    VKDeviceMemory chunk{ device, 4096, 0, 1024 };
+
+    /* Allocate consecutive blocks with different alignments */
+    auto a = chunk.Allocate(100, 16);
+    auto b = chunk.Allocate(100, 256);
+    auto c = chunk.Allocate(30, 4);
+    Check(a != nullptr && b != nullptr && c != nullptr, "allocation of small blocks");
+    Check(a->GetOffset() == 0 && a->GetSize() == 112, "first block at offset 0");
+    Check(b->GetOffset() == 256 && b->GetSize() == 256, "second block is aligned");
+    Check(c->GetOffset() % 4 == 0 && c->GetOffset() >= a->GetOffsetWithSize(), "third block is aligned");
+
+    /* Allocate non-linear block, which must not share a page of the buffer-image granularity with the linear blocks */
+    auto d = chunk.Allocate(500, 16, VKMemoryLayout::NonLinear);
+    Check(d != nullptr && d->GetOffset() == 1024, "non-linear block is moved to the next page");
+
+    /* Allocate linear block that only fits after the non-linear block, which must be moved to the next page as well */
+    auto e = chunk.Allocate(2000, 16);
+    Check(e != nullptr && e->GetOffset() == 2048, "linear block is moved to the next page");
+
+    /* Release blocks in arbitrary order; all free blocks must be merged into a single one again */
+    chunk.Release(b);
+    chunk.Release(d);
+    chunk.Release(a);
+
+    VKDeviceMemoryDetails details;
+    chunk.AccumDetails(details);
+    Check(details.numBlocks == 2, "number of allocated blocks after partial release");
+    Check(details.numFragments > 0 && details.maxFragmentedBlockSize > 0, "released blocks between allocated blocks are fragments");
+
+    chunk.Release(e);
+    chunk.Release(c);
+    Check(chunk.IsEmpty(), "chunk is empty after releasing all blocks");
+
+    details = VKDeviceMemoryDetails{};
+    chunk.AccumDetails(details);
+    Check(details.numBlocks == 0 && details.numFragments == 0, "free blocks are merged into the remaining new block");
+    Check(details.maxNewBlockSize == 4096 && chunk.GetMaxAllocationSize() == 4096, "entire chunk is free");
+
+    /* Entire chunk can be allocated at once */
+    auto f = chunk.Allocate(4096, 4096);
+    Check(f != nullptr && f->GetOffset() == 0, "allocation of entire chunk");
+    Check(chunk.Allocate(1, 1) == nullptr, "allocation in full chunk fails");
+    chunk.Release(f);
+}
+
+// Allocates and releases a large number of blocks in random order and measures the average time per operation.
+static void TestRandomAllocations(const LLGL::VKPtr<VkDevice>& device, std::size_t numOperations, bool reduceFragmentation)
+{
+    using namespace LLGL;
+
+    const VkDeviceSize granularity = 1024;
+
+    VKDeviceMemoryManager memoryMngr{ device, GetFakeMemoryProperties(), 1024*1024*16, reduceFragmentation, granularity };
+
+    std::mt19937 rng{ 1234 };
+    std::vector<VKDeviceMemoryRegion*> regions;
+    regions.reserve(numOperations);
+
+    std::chrono::high_resolution_clock::duration duration{ 0 };
+
+    for (std::size_t i = 0; i < numOperations; ++i)
+    {
+        /* Release a random region every third operation and as long as the number of regions exceeds the limit */
+        if (!regions.empty() && (rng() % 3 == 0 || regions.size() >= 20000))
+        {
+            const auto index = rng() % regions.size();
+            auto region = regions[index];
+            regions[index] = regions.back();
+            regions.pop_back();
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            memoryMngr.Release(region);
+            duration += std::chrono::high_resolution_clock::now() - startTime;
+        }
+        else
+        {
+            /* Allocate region of a random size between 16 bytes and 256 KB, alignment, and layout */
+            const auto size         = (VkDeviceSize(16) << (rng() % 15)) + rng() % 256;
+            const auto alignment    = (VkDeviceSize(1) << (rng() % 17));
+            const auto typeBits     = (rng() % 4 == 0 ? 0x2u : 0x3u);
+            const auto layout       = (rng() % 2 == 0 ? VKMemoryLayout::Linear : VKMemoryLayout::NonLinear);
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            auto region = memoryMngr.Allocate(size, alignment, typeBits, 0, layout);
+            duration += std::chrono::high_resolution_clock::now() - startTime;
+
+            Check(region != nullptr, "allocation of random region");
+            Check(region->GetOffset() % alignment == 0, "random region is aligned");
+            Check(region->GetSize() >= size, "random region is large enough");
+            Check(region->GetLayout() == layout, "random region has requested layout");
+
+            regions.push_back(region);
+        }
+
+        if (i % 10000 == 0)
+            ValidateRegions(regions, granularity);
+    }
+
+    ValidateRegions(regions, granularity);
+
+    auto details = memoryMngr.QueryDetails();
+
+    std::cout << "random allocations (reduceFragmentation = " << std::boolalpha << reduceFragmentation << "): ";
+    std::cout << static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / numOperations << " ns/op, ";
+    std::cout << details.numChunks << " chunk(s), " << details.numBlocks << " block(s), " << details.numFragments << " fragment(s)" << std::endl;
+
+    Check(details.numBlocks == regions.size(), "number of allocated blocks in details");
+
+    /* Release all regions; all chunks must be released as well */
+    for (auto region : regions)
+        memoryMngr.Release(region);
+
+    Check(memoryMngr.QueryDetails().numChunks == 0, "all chunks are released");
+    Check(g_numAllocations == 0, "all device memory is released");
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::size_t numOperations = 200000;
+        if (argc > 1)
+            numOperations = static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10));
+
+        /* Fake device handle; it is only passed through to the stubs above */
+        static int fakeDevice = 0;
+        LLGL::VKPtr<VkDevice> device;
+        device = reinterpret_cast<VkDevice>(&fakeDevice);
+
+        TestChunk(device);
+        TestRandomAllocations(device, numOperations, false);
+        TestRandomAllocations(device, numOperations, true);
+
+        std::cout << "all tests passed" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+